@@ -6,6 +6,7 @@
 
 #include <iostream>
 
+#include "base_component/sim_context.h"
 #include "fmt/format.h"
 #include "util/util.h"
 
@@ -15,18 +16,19 @@ namespace cimsim {
 #define ERROR_MEMORY_AS_OFFSET -1
 
 void AddressSapce::initialize(const ChipConfig& chip_config) {
-    if (as_ptr_ == nullptr) {
-        as_ptr_ = std::unique_ptr<AddressSapce>(new AddressSapce(chip_config));
+    if (auto& as_ptr = SimContext::current().address_space; as_ptr == nullptr) {
+        as_ptr = std::unique_ptr<AddressSapce>(new AddressSapce(chip_config));
     }
 }
 
 const AddressSapce& AddressSapce::getInstance() {
-    return *as_ptr_;
+    return *SimContext::current().address_space;
 }
 
-std::unique_ptr<AddressSapce> AddressSapce::as_ptr_{nullptr};
-
-AddressSapce::AddressSapce(const ChipConfig& chip_config) {
+AddressSapce::AddressSapce(const ChipConfig& chip_config)
+    : global_memory_switch_id_list_(chip_config.global_memory_config.getControllerSwitchIdList())
+    , global_memory_interleave_block_byte_(chip_config.global_memory_config.interleave_block_byte)
+    , global_memory_interleave_hash_(chip_config.global_memory_config.interleave_hash) {
     auto mem_map = chip_config.getMemoryInfoMap();
     int offset = 0;
     for (auto& as_element : chip_config.address_space_config) {
@@ -127,4 +129,22 @@ std::pair<int, bool> AddressSapce::getMemoryInfoByAddress(int address_byte) cons
     return {it->second.memory_id, it->second.is_global};
 }
 
+int AddressSapce::getGlobalMemorySwitchId(int address_byte) const {
+    const int controller_cnt = static_cast<int>(global_memory_switch_id_list_.size());
+    if (controller_cnt == 1) {
+        return global_memory_switch_id_list_[0];
+    }
+
+    auto block_index = static_cast<unsigned int>(address_byte / global_memory_interleave_block_byte_);
+    if (global_memory_interleave_hash_) {
+        // xor-fold higher bits into lower bits, so that strided accesses are spread across controllers
+        block_index ^= (block_index >> 8) ^ (block_index >> 16) ^ (block_index >> 24);
+    }
+    return global_memory_switch_id_list_[block_index % controller_cnt];
+}
+
+int AddressSapce::getGlobalMemoryInterleaveBlockByte() const {
+    return global_memory_interleave_block_byte_;
+}
+
 }  // namespace cimsim
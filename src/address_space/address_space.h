@@ -7,6 +7,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "config/config.h"
 
@@ -22,11 +23,9 @@ class AddressSapce {
 public:
     static void initialize(const ChipConfig& chip_config);
 
+    // address space of the current SimContext
     static const AddressSapce& getInstance();
 
-private:
-    static std::unique_ptr<AddressSapce> as_ptr_;
-
 public:
     [[nodiscard]] int getMemoryId(const std::string& name) const;
     [[nodiscard]] int getMemoryAddressSpaceOffset(const std::string& name) const;
@@ -37,6 +36,10 @@ public:
     [[nodiscard]] bool isAddressGlobal(int address_byte) const;
     [[nodiscard]] std::pair<int, bool> getMemoryInfoByAddress(int address_byte) const;
 
+    // global memory controllers interleaving
+    [[nodiscard]] int getGlobalMemorySwitchId(int address_byte) const;
+    [[nodiscard]] int getGlobalMemoryInterleaveBlockByte() const;
+
 private:
     explicit AddressSapce(const ChipConfig& chip_config);
 
@@ -44,6 +47,10 @@ private:
     std::map<int, AddressSpaceInfo> as_address_map_;
     int local_mem_cnt_{0};
     int global_mem_cnt_{0};
+
+    std::vector<int> global_memory_switch_id_list_;
+    int global_memory_interleave_block_byte_;
+    bool global_memory_interleave_hash_;
 };
 
 }  // namespace cimsim
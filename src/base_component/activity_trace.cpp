@@ -0,0 +1,103 @@
+#include "activity_trace.h"
+
+#include <cstring>
+#include <iostream>
+
+#include "energy_counter.h"
+#include "fmt/format.h"
+#include "util/binary_io.h"
+
+namespace cimsim {
+
+namespace {
+
+constexpr char ACTIVITY_TRACE_MAGIC[8] = {'C', 'I', 'M', 'A', 'C', 'T', 'V', '1'};
+
+}  // namespace
+
+void ActivityTrace::startRecord(EnergyCounter& top_energy_counter) {
+    auto counter_list = getEnergyCounterList(top_energy_counter);
+    for (int counter_id = 0; counter_id < counter_list.size(); counter_id++) {
+        counter_list[counter_id]->trace_id_ = counter_id;
+    }
+    EnergyCounter::setActivityTrace(this);
+}
+
+void ActivityTrace::stopRecord() {
+    EnergyCounter::setActivityTrace(nullptr);
+}
+
+bool ActivityTrace::replay(EnergyCounter& top_energy_counter) const {
+    auto counter_list = getEnergyCounterList(top_energy_counter);
+    for (const auto& event : event_list) {
+        if (event.counter_id < 0 || event.counter_id >= counter_list.size() ||
+            event.power_key >= static_cast<int>(counter_list[event.counter_id]->power_param_list_.size())) {
+            std::cerr << fmt::format("Activity trace does not match energy counter {}, config may differ in more "
+                                     "than power params",
+                                     event.counter_id)
+                      << std::endl;
+            return false;
+        }
+    }
+
+    for (const auto& event : event_list) {
+        auto& counter = *counter_list[event.counter_id];
+        if (event.power_key < 0) {
+            counter.dynamic_energy_ += event.unit_cnt;
+            continue;
+        }
+        counter.addLatencyPowerDynamicEnergyPJ(event.latency_ns,
+                                               *counter.power_param_list_[event.power_key] * event.unit_cnt,
+                                               sc_time::from_value(event.start_time_value));
+    }
+    return true;
+}
+
+bool ActivityTrace::writeToFile(const std::string& file) const {
+    std::ofstream ofs(file, std::ios::out | std::ios::binary);
+    if (!ofs.is_open()) {
+        std::cerr << fmt::format("Can not open activity trace file '{}'", file) << std::endl;
+        return false;
+    }
+
+    BinaryWriter writer{ofs};
+    ofs.write(ACTIVITY_TRACE_MAGIC, sizeof(ACTIVITY_TRACE_MAGIC));
+    writer.write(running_time_ns);
+    writer.writeVector(std::vector<char>{timing_report.begin(), timing_report.end()});
+    writer.writeVector(event_list);
+    return ofs.good();
+}
+
+bool ActivityTrace::readFromFile(const std::string& file) {
+    std::ifstream ifs(file, std::ios::in | std::ios::binary);
+    char magic[sizeof(ACTIVITY_TRACE_MAGIC)]{};
+    ifs.read(magic, sizeof(magic));
+    if (!ifs.good() || std::memcmp(magic, ACTIVITY_TRACE_MAGIC, sizeof(ACTIVITY_TRACE_MAGIC)) != 0) {
+        std::cerr << fmt::format("Invalid activity trace file '{}'", file) << std::endl;
+        return false;
+    }
+
+    BinaryReader reader{ifs};
+    running_time_ns = reader.read<double>();
+    std::vector<char> report_data;
+    reader.readVector(report_data);
+    timing_report.assign(report_data.begin(), report_data.end());
+    reader.readVector(event_list);
+    if (!reader.good()) {
+        std::cerr << fmt::format("Activity trace file '{}' is truncated or corrupted", file) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::vector<EnergyCounter*> ActivityTrace::getEnergyCounterList(EnergyCounter& top_energy_counter) {
+    std::vector<EnergyCounter*> counter_list{&top_energy_counter};
+    for (int i = 0; i < counter_list.size(); i++) {
+        for (const auto& [name, sub] : counter_list[i]->sub_energy_counter_list_) {
+            counter_list.push_back(sub);
+        }
+    }
+    return counter_list;
+}
+
+}  // namespace cimsim
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cimsim {
+
+class EnergyCounter;
+
+struct ActivityEvent {
+    int counter_id{0};             // breadth-first index in the energy counter tree
+    int power_key{-1};             // index of counter power params, -1 means fixed energy in unit count
+    uint64_t start_time_value{0};  // sc_time value, needed by counters of multiple pipeline stages
+    double latency_ns{0.0};
+    double unit_cnt{0.0};
+};
+
+class ActivityTrace {
+    /* Dynamic energy events of one timing simulation. Power params are the only config input of dynamic energy, so
+     * replaying events on an energy counter tree built with another config, which differs only in power params,
+     * re-costs energy without simulating again. Static energy is recomputed by the new tree from running time.
+     */
+public:
+    // record events of every counter in the tree until stop
+    void startRecord(EnergyCounter& top_energy_counter);
+    void stopRecord();
+
+    // false if the tree does not match counters and power params of the recorded tree
+    bool replay(EnergyCounter& top_energy_counter) const;
+
+    bool writeToFile(const std::string& file) const;
+    bool readFromFile(const std::string& file);
+
+public:
+    double running_time_ns{0.0};
+    std::string timing_report{};  // profiler and network report, which only depend on timing
+    std::vector<ActivityEvent> event_list{};
+
+private:
+    static std::vector<EnergyCounter*> getEnergyCounterList(EnergyCounter& top_energy_counter);
+};
+
+}  // namespace cimsim
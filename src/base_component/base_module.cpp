@@ -12,7 +12,8 @@ BaseModule::BaseModule(const sc_module_name& name, const BaseInfo& base_info)
     , sim_mode_(base_info.sim_config.sim_mode)
     , data_mode_(base_info.sim_config.data_mode)
     , core_id_(base_info.core_id)
-    , name_(name) {}
+    , name_(name)
+    , thread_stack_size_KB_(base_info.sim_config.thread_stack_size_KB) {}
 
 EnergyCounter* BaseModule::getEnergyCounterPtr() {
     return &energy_counter_;
@@ -26,4 +27,10 @@ const char* BaseModule::getFullName() const {
     return name();
 }
 
+void BaseModule::setThreadStackSize() {
+    if (thread_stack_size_KB_ > 0) {
+        set_stack_size(static_cast<std::size_t>(thread_stack_size_KB_) * 1024);
+    }
+}
+
 }  // namespace cimsim
@@ -26,6 +26,10 @@ public:
     const std::string& getName() const;
     const char* getFullName() const;
 
+protected:
+    // call right after SC_THREAD, applies to the last created process
+    void setThreadStackSize();
+
 protected:
     const double period_ns_;
     const SimMode sim_mode_;
@@ -37,6 +41,7 @@ protected:
 
 private:
     const std::string name_;
+    const int thread_stack_size_KB_;
 };
 
 }  // namespace cimsim
@@ -4,14 +4,16 @@
 
 #include "energy_counter.h"
 
+#include <algorithm>
+#include <cassert>
+
+#include "activity_trace.h"
 #include "profiler/profiler.h"
+#include "sim_context.h"
 #include "util/reporter.h"
 
 namespace cimsim {
 
-double EnergyCounter::running_time_ = 0.0;
-bool EnergyCounter::set_running_time_ = false;
-
 EnergyCounter::EnergyCounter(bool mult_pipeline_stage) : mult_pipeline_stage_(mult_pipeline_stage) {
     if (mult_pipeline_stage_) {
         dynamic_tag_stack_ = new std::stack<DynamicEnergyTag>;
@@ -27,16 +29,53 @@ void EnergyCounter::setStaticPowerMW(double power) {
 }
 
 void EnergyCounter::addDynamicEnergyPJ(double energy) {
+    if (auto* activity_trace = SimContext::current().activity_trace; activity_trace != nullptr && trace_id_ >= 0) {
+        activity_trace->event_list.push_back(
+            {.counter_id = trace_id_, .start_time_value = sc_time_stamp().value(), .unit_cnt = energy});
+    }
     dynamic_energy_ += energy;
 }
 
 void EnergyCounter::addDynamicEnergyPJ(double latency, double power, const ProfilerTag& profiler_tag) {
+    addLatencyPowerDynamicEnergyPJ(latency, power, sc_time_stamp());
+    addActivityTime(latency, profiler_tag);
+}
+
+void EnergyCounter::addDynamicPowerParam(const double& power_param_mW) {
+    power_param_list_.push_back(&power_param_mW);
+}
+
+void EnergyCounter::addDynamicEnergyPJ(double latency, const double& power_param_mW, double unit_cnt,
+                                       const ProfilerTag& profiler_tag) {
+    traceDynamicEnergy(latency, power_param_mW, unit_cnt);
+    addDynamicEnergyPJ(latency, power_param_mW * unit_cnt, profiler_tag);
+}
+
+void EnergyCounter::addDynamicEnergyPJ(double latency, const double& power_param_mW, double unit_cnt) {
+    traceDynamicEnergy(latency, power_param_mW, unit_cnt);
+    addLatencyPowerDynamicEnergyPJ(latency, power_param_mW * unit_cnt, sc_time_stamp());
+}
+
+void EnergyCounter::addLatencyPowerDynamicEnergyPJ(double latency, double power, const sc_time& start_time) {
     if (mult_pipeline_stage_) {
-        addPipelineStageDynamicEnergyPJ(latency, power);
+        addPipelineStageDynamicEnergyPJ(latency, power, start_time);
     } else {
         dynamic_energy_ += latency * power;
     }
-    addActivityTime(latency, profiler_tag);
+}
+
+void EnergyCounter::traceDynamicEnergy(double latency, const double& power_param_mW, double unit_cnt) const {
+    auto* activity_trace = SimContext::current().activity_trace;
+    if (activity_trace == nullptr || trace_id_ < 0) {
+        return;
+    }
+    auto found = std::find(power_param_list_.begin(), power_param_list_.end(), &power_param_mW);
+    assert(found != power_param_list_.end() && "dynamic power param has not been added");
+    activity_trace->event_list.push_back({.counter_id = trace_id_,
+                                          .power_key = static_cast<int>(found - power_param_list_.begin()),
+                                          .start_time_value = sc_time_stamp().value(),
+                                          .latency_ns = latency,
+                                          .unit_cnt = unit_cnt});
 }
 
 void EnergyCounter::addActivityTime(double latency, const ProfilerTag& profiler_tag) {
@@ -49,19 +88,25 @@ void EnergyCounter::addActivityTime(double latency, const ProfilerTag& profiler_
 }
 
 void EnergyCounter::setRunningTimeNS(double time) {
-    running_time_ = time;
-    set_running_time_ = true;
+    auto& context = SimContext::current();
+    context.running_time_ns = time;
+    context.set_running_time = true;
 }
 
 void EnergyCounter::setRunningTimeNS(const sc_time& time) {
     setRunningTimeNS(time.to_seconds() * 1e9);
 }
 
+void EnergyCounter::setActivityTrace(ActivityTrace* activity_trace) {
+    SimContext::current().activity_trace = activity_trace;
+}
+
 double EnergyCounter::getRunningTimeNS() {
-    if (!set_running_time_) {
+    const auto& context = SimContext::current();
+    if (!context.set_running_time) {
         throw std::runtime_error("No running time has been set yet");
     }
-    return running_time_;
+    return context.running_time_ns;
 }
 
 double EnergyCounter::getStaticEnergyPJ() const {
@@ -96,10 +141,45 @@ EnergyReporter EnergyCounter::getEnergyReporter() const {
     return std::move(reporter);
 }
 
-void EnergyCounter::addPipelineStageDynamicEnergyPJ(double latency, double power) {
+std::vector<double> EnergyCounter::getDynamicEnergyList() const {
+    std::vector<double> energy_list;
+    collectDynamicEnergy(energy_list);
+    return energy_list;
+}
+
+void EnergyCounter::addDynamicEnergyList(const std::vector<double>& energy_list, double times) {
+    int index = 0;
+    addDynamicEnergyList(energy_list, times, index);
+}
+
+void EnergyCounter::resetDynamicEnergy() {
+    dynamic_energy_ = 0.0;
+    for (const auto& [name, sub] : sub_energy_counter_list_) {
+        sub->resetDynamicEnergy();
+    }
+}
+
+void EnergyCounter::collectDynamicEnergy(std::vector<double>& energy_list) const {
+    energy_list.push_back(dynamic_energy_);
+    for (const auto& [name, sub] : sub_energy_counter_list_) {
+        sub->collectDynamicEnergy(energy_list);
+    }
+}
+
+void EnergyCounter::addDynamicEnergyList(const std::vector<double>& energy_list, double times, int& index) {
+    if (index >= energy_list.size()) {
+        return;
+    }
+    dynamic_energy_ += energy_list[index++] * times;
+    for (const auto& [name, sub] : sub_energy_counter_list_) {
+        sub->addDynamicEnergyList(energy_list, times, index);
+    }
+}
+
+void EnergyCounter::addPipelineStageDynamicEnergyPJ(double latency, double power, const sc_time& start_time) {
     static std::stack<DynamicEnergyTag> temp_stack{};
 
-    auto now_time = sc_time_stamp();
+    auto now_time = start_time;
     auto end_time_tag = now_time + sc_time{latency, SC_NS};
 
     while (!dynamic_tag_stack_->empty() && dynamic_tag_stack_->top().end_time <= now_time) {
@@ -6,6 +6,7 @@
 
 #include <set>
 #include <stack>
+#include <vector>
 
 #include "core/payload.h"
 #include "profiler/timing_statistic.h"
@@ -13,6 +14,7 @@
 
 namespace cimsim {
 
+class ActivityTrace;
 class EnergyReporter;
 class HardwareProfiler;
 class InstProfiler;
@@ -29,6 +31,7 @@ class EnergyCounter {
     // energy unit -- pJ
     // power unit  -- mW
     // time unit   -- ns
+    friend ActivityTrace;
     friend HardwareProfiler;
     friend InstProfiler;
 
@@ -43,9 +46,7 @@ public:
     static void setRunningTimeNS(const sc_time& time);
     static double getRunningTimeNS();
 
-private:
-    static double running_time_;  // ns
-    static bool set_running_time_;
+    static void setActivityTrace(ActivityTrace* activity_trace);
 
 public:
     explicit EnergyCounter(bool mult_pipeline_stage = false);
@@ -54,6 +55,14 @@ public:
     void setStaticPowerMW(double power);
     void addDynamicEnergyPJ(double energy);
     void addDynamicEnergyPJ(double latency, double power, const ProfilerTag& profiler_tag);
+
+    // power param is a dynamic power field of config added at construction, dynamic power is power param * unit
+    // count, so activity traced in one simulation can be re-costed with power params of another config
+    void addDynamicPowerParam(const double& power_param_mW);
+    void addDynamicEnergyPJ(double latency, const double& power_param_mW, double unit_cnt,
+                            const ProfilerTag& profiler_tag);
+    // without activity time, for background energy such as dram refresh
+    void addDynamicEnergyPJ(double latency, const double& power_param_mW, double unit_cnt);
     void addActivityTime(double latency, const ProfilerTag& profiler_tag);
 
     [[nodiscard]] double getStaticEnergyPJ() const;
@@ -64,14 +73,28 @@ public:
     void addSubEnergyCounter(const std::string_view& name, EnergyCounter* sub_energy_counter);
     [[nodiscard]] EnergyReporter getEnergyReporter() const;
 
+    // dynamic energy of this counter and all sub counters in pre-order, used to repeat energy of identical work
+    [[nodiscard]] std::vector<double> getDynamicEnergyList() const;
+    void addDynamicEnergyList(const std::vector<double>& energy_list, double times);
+    // clear dynamic energy of this counter and all sub counters, so energy of the next layer in batch mode starts
+    void resetDynamicEnergy();
+
 private:
-    void addPipelineStageDynamicEnergyPJ(double latency, double power);
+    void addLatencyPowerDynamicEnergyPJ(double latency, double power, const sc_time& start_time);
+    void traceDynamicEnergy(double latency, const double& power_param_mW, double unit_cnt) const;
+    void addPipelineStageDynamicEnergyPJ(double latency, double power, const sc_time& start_time);
+
+    void collectDynamicEnergy(std::vector<double>& energy_list) const;
+    void addDynamicEnergyList(const std::vector<double>& energy_list, double times, int& index);
 
 private:
     const bool mult_pipeline_stage_;
     double static_power_ = 0.0;    // mW
     double dynamic_energy_ = 0.0;  // pJ
 
+    std::vector<const double*> power_param_list_{};
+    int trace_id_{-1};
+
     std::stack<DynamicEnergyTag>* dynamic_tag_stack_{};
     sc_time activity_time_tag_{0.0, SC_NS};
 
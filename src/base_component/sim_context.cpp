@@ -0,0 +1,30 @@
+#include "sim_context.h"
+
+#include "address_space/address_space.h"
+
+namespace cimsim {
+
+namespace {
+
+SimContext* current_context = nullptr;
+
+}  // namespace
+
+SimContext::Scope::Scope(SimContext& context) : previous_(current_context) {
+    current_context = &context;
+}
+
+SimContext::Scope::~Scope() {
+    current_context = previous_;
+}
+
+SimContext& SimContext::current() {
+    static SimContext default_context;
+    return current_context != nullptr ? *current_context : default_context;
+}
+
+SimContext::SimContext() = default;
+
+SimContext::~SimContext() = default;
+
+}  // namespace cimsim
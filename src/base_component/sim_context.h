@@ -0,0 +1,43 @@
+#pragma once
+#include <memory>
+
+namespace cimsim {
+
+class ActivityTrace;
+class AddressSapce;
+
+struct SimContext {
+    /* State of one simulation run shared by components without construction params, such as the address space and
+     * the running time for static energy. Components reach it by SimContext::current(), which is a default context
+     * unless a Scope makes another one current, so every in-process run can own a fresh context.
+     */
+    class Scope {
+    public:
+        explicit Scope(SimContext& context);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        SimContext* previous_;
+    };
+
+    static SimContext& current();
+
+    SimContext();
+    ~SimContext();
+
+    std::unique_ptr<AddressSapce> address_space;
+
+    // energy counter
+    double running_time_ns{0.0};
+    bool set_running_time{false};
+    ActivityTrace* activity_trace{nullptr};
+
+    // profiler
+    bool json_flat{false};
+    bool record_time_segments{false};
+};
+
+}  // namespace cimsim
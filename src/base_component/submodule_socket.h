@@ -38,4 +38,43 @@ void waitAndStartNextStage(const PayloadType& cur_payload, SubmoduleSocket<Paylo
     next_stage_socket.start_exec.notify();
 }
 
+// Pipeline stage driven by an SC_METHOD instead of an SC_THREAD, so it needs no coroutine stack. Steps behave the
+// same as a thread looping waitUntilStart, wait stage latency, waitAndStartNextStage and finish. The method is
+// statically sensitive to start_exec of exec socket and not initialized, step is its only call.
+template <class PayloadType>
+class SubmoduleStageMethod {
+public:
+    // start_func(payload) is called when a payload starts and returns stage latency in ns, next stage socket is
+    // nullptr if the payload is not passed on
+    template <class StartFunc>
+    void step(SubmoduleSocket<PayloadType>& exec_socket, SubmoduleSocket<PayloadType>* next_stage_socket,
+              StartFunc&& start_func) {
+        if (state_ == State::idle) {
+            exec_socket.busy = true;
+            double latency = start_func(exec_socket.payload);
+            state_ = State::executing;
+            next_trigger(sc_time{latency, SC_NS});
+            return;
+        }
+
+        if (next_stage_socket != nullptr) {
+            if (state_ == State::executing && next_stage_socket->busy) {
+                state_ = State::waiting_next_stage;
+                next_trigger(next_stage_socket->finish_exec);
+                return;
+            }
+            next_stage_socket->payload = exec_socket.payload;
+            next_stage_socket->start_exec.notify();
+        }
+
+        // back to static sensitivity on start_exec
+        exec_socket.finish();
+        state_ = State::idle;
+    }
+
+private:
+    enum class State { idle, executing, waiting_next_stage };
+    State state_{State::idle};
+};
+
 }  // namespace cimsim
@@ -0,0 +1,101 @@
+#include "checkpoint.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "fmt/format.h"
+#include "util/binary_io.h"
+
+namespace cimsim {
+
+namespace {
+
+constexpr char CHECKPOINT_MAGIC[8] = {'C', 'I', 'M', 'C', 'K', 'P', 'T', '1'};
+
+}  // namespace
+
+bool Checkpoint::writeToFile(const std::string& file) const {
+    std::ofstream ofs(file, std::ios::out | std::ios::binary);
+    if (!ofs.is_open()) {
+        std::cerr << fmt::format("Can not open checkpoint file '{}'", file) << std::endl;
+        return false;
+    }
+
+    BinaryWriter writer{ofs};
+    ofs.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    writer.write(time_ns);
+
+    writer.write(static_cast<uint32_t>(arch_state.core_state_list.size()));
+    for (const auto& core_state : arch_state.core_state_list) {
+        writer.write(core_state.ins_index);
+        writer.write(core_state.general_regs);
+        writer.write(core_state.special_regs);
+
+        writer.write(static_cast<uint32_t>(core_state.group_activation_mask_list.size()));
+        for (int group_id = 0; group_id < core_state.group_activation_mask_list.size(); group_id++) {
+            writer.writeVector(core_state.group_activation_mask_list[group_id]);
+            writer.writeVector(core_state.group_result_list[group_id]);
+        }
+
+        writer.write(static_cast<uint32_t>(core_state.memory_data_list.size()));
+        for (const auto& memory_data : core_state.memory_data_list) {
+            writer.writeSparseData(memory_data);
+        }
+    }
+
+    writer.write(static_cast<uint32_t>(arch_state.global_memory_data_list.size()));
+    for (const auto& memory_data : arch_state.global_memory_data_list) {
+        writer.writeSparseData(memory_data);
+    }
+
+    writer.writeVector(energy_list);
+    return ofs.good();
+}
+
+bool Checkpoint::readFromFile(const std::string& file) {
+    std::ifstream ifs(file, std::ios::in | std::ios::binary);
+    char magic[sizeof(CHECKPOINT_MAGIC)]{};
+    ifs.read(magic, sizeof(magic));
+    if (!ifs.good() || std::memcmp(magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0) {
+        std::cerr << fmt::format("Invalid checkpoint file '{}'", file) << std::endl;
+        return false;
+    }
+
+    BinaryReader reader{ifs};
+    time_ns = reader.read<double>();
+
+    arch_state.core_state_list.resize(reader.read<uint32_t>());
+    for (auto& core_state : arch_state.core_state_list) {
+        core_state.ins_index = reader.read<int>();
+        core_state.general_regs = reader.read<std::array<int, GENERAL_REG_NUM>>();
+        core_state.special_regs = reader.read<std::array<int, SPECIAL_REG_NUM>>();
+
+        auto group_cnt = reader.read<uint32_t>();
+        core_state.group_activation_mask_list.resize(group_cnt);
+        core_state.group_result_list.resize(group_cnt);
+        for (int group_id = 0; group_id < group_cnt && reader.good(); group_id++) {
+            reader.readVector(core_state.group_activation_mask_list[group_id]);
+            reader.readVector(core_state.group_result_list[group_id]);
+        }
+
+        core_state.memory_data_list.resize(reader.read<uint32_t>());
+        for (auto& memory_data : core_state.memory_data_list) {
+            reader.readSparseData(memory_data);
+        }
+    }
+
+    arch_state.global_memory_data_list.resize(reader.read<uint32_t>());
+    for (auto& memory_data : arch_state.global_memory_data_list) {
+        reader.readSparseData(memory_data);
+    }
+
+    reader.readVector(energy_list);
+    if (!reader.good()) {
+        std::cerr << fmt::format("Checkpoint file '{}' is truncated or corrupted", file) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+}  // namespace cimsim
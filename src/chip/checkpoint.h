@@ -0,0 +1,21 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "core/arch_state.h"
+
+namespace cimsim {
+
+struct Checkpoint {
+    // simulation state at a point where all cores are paused and drained, so no instruction is in flight and
+    // architectural state together with accumulated time and energy is enough to resume
+    double time_ns{0.0};
+    ChipArchState arch_state{};
+    std::vector<double> energy_list{};  // dynamic energy of chip energy counter tree in pre-order
+
+    // compact binary file, memory data only keeps non-zero blocks
+    bool writeToFile(const std::string& file) const;
+    bool readFromFile(const std::string& file);
+};
+
+}  // namespace cimsim
@@ -4,6 +4,10 @@
 
 #include "chip.h"
 
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
 #include "fmt/format.h"
 
 namespace cimsim {
@@ -20,7 +24,8 @@ Chip::Chip(const sc_module_name& name, const Config& config, const ProfilerConfi
         std::string core_name = fmt::format("Core_{}", core_id);
         BaseInfo base_info{config.sim_config, core_id};
         auto core = std::make_shared<Core>(core_name.c_str(), config.chip_config.core_config, base_info, &clk_,
-                                           global_id, core_ins_list[core_id], [this]() { this->processFinishRun(); });
+                                           global_id, config.chip_config.core_cnt, core_ins_list[core_id],
+                                           [this]() { this->processFinishRun(); });
         core->bindNetwork(&network_);
         core_list_.emplace_back(core);
 
@@ -35,6 +40,10 @@ Chip::Chip(const sc_module_name& name, const Config& config, const ProfilerConfi
 }
 
 Reporter Chip::report(std::ostream& os, bool report_every_core_energy) {
+    if (!layer_reporter_list_.empty()) {
+        return reportBatch(os, report_every_core_energy);
+    }
+
     EnergyCounter::setRunningTimeNS(running_time_);
     Reporter reporter{running_time_.to_seconds() * 1000, getName(), getEnergyReporter(), 0};
     reporter.report(os);
@@ -44,7 +53,13 @@ Reporter Chip::report(std::ostream& os, bool report_every_core_energy) {
         os << "\nEvery core energy form:\n";
         cores_reporter.reportEnergyForm(os);
     }
-    profiler_.report(os, reporter.getLatencyNs());
+    if (replayed_trace_ != nullptr) {
+        os << replayed_trace_->timing_report;
+    } else {
+        profiler_.report(os, reporter.getLatencyNs());
+        network_.report(os, reporter.getLatencyNs());
+        reportLoopExtrapolation(os);
+    }
     return std::move(reporter);
 }
 
@@ -62,16 +77,240 @@ EnergyReporter Chip::getCoresEnergyReporter() const {
 
 void Chip::processFinishRun() {
     finish_run_core_cnt_++;
+    if (paused_core_cnt_ > 0 && paused_core_cnt_ + finish_run_core_cnt_ == core_list_.size()) {
+        saveCheckpointAndResume();
+    }
     if (finish_run_core_cnt_ == core_list_.size()) {
-        running_time_ = sc_time_stamp();
+        running_time_ = restored_time_ + sc_time_stamp();
         sc_stop();
         profiler_.finishRun();
+        if (!batch_layer_list_.empty()) {
+            finishLayer(sc_time_stamp());
+        }
+    }
+}
+
+void Chip::setCheckpointSave(const CheckpointConfig& config) {
+    checkpoint_config_ = &config;
+    for (auto& core : core_list_) {
+        core->setPauseTrigger(
+            [this](long long decoded_ins_cnt) {
+                return (checkpoint_config_->save_time_ns >= 0.0 &&
+                        getSimulatedTimeNS() >= checkpoint_config_->save_time_ns) ||
+                       (checkpoint_config_->save_ins_cnt >= 0 && decoded_ins_cnt >= checkpoint_config_->save_ins_cnt);
+            },
+            [this]() { processCorePause(); });
+    }
+}
+
+void Chip::restoreCheckpoint(const Checkpoint& checkpoint) {
+    loadArchState(checkpoint.arch_state);
+    energy_counter_.addDynamicEnergyList(checkpoint.energy_list, 1.0);
+    restored_time_ = sc_time{checkpoint.time_ns, SC_NS};
+}
+
+void Chip::startActivityTrace(ActivityTrace& trace) {
+    trace.startRecord(energy_counter_);
+}
+
+void Chip::finishActivityTrace(ActivityTrace& trace) {
+    trace.stopRecord();
+    trace.running_time_ns = running_time_.to_seconds() * 1e9;
+
+    std::stringstream ss;
+    profiler_.report(ss, trace.running_time_ns);
+    network_.report(ss, trace.running_time_ns);
+    trace.timing_report = ss.str();
+}
+
+bool Chip::replayActivityTrace(const ActivityTrace& trace) {
+    if (!trace.replay(energy_counter_)) {
+        return false;
+    }
+    running_time_ = sc_time{trace.running_time_ns, SC_NS};
+    replayed_trace_ = &trace;
+    return true;
+}
+
+void Chip::processCorePause() {
+    paused_core_cnt_++;
+    if (paused_core_cnt_ + finish_run_core_cnt_ == core_list_.size()) {
+        saveCheckpointAndResume();
+    }
+}
+
+bool Chip::isCheckpointSplitTransfer() const {
+    return checkpoint_split_transfer_ || paused_core_cnt_ > 0;
+}
+
+void Chip::saveCheckpointAndResume() {
+    if (std::any_of(core_list_.begin(), core_list_.end(),
+                    [](const std::shared_ptr<Core>& core) { return core->getPendingTransferCount() > 0; })) {
+        checkpoint_split_transfer_ = true;
+        sc_stop();
+        return;
+    }
+
+    // a restored run starts at a cycle start and decodes period - 1 ns later. Paused cores resume at the first such
+    // decode time from now, and hardware timing restarts at its cycle start, so that the rest of this run times the
+    // same as a run restored from the checkpoint, which starts at that cycle start
+    double cycle_cnt = std::ceil((sc_time_stamp().to_seconds() * 1e9 - (period_ns_ - 1)) / period_ns_ - 1e-9);
+    sc_time resume_cycle_start{std::max(cycle_cnt, 0.0) * period_ns_, SC_NS};
+    sc_time resume_decode_time = resume_cycle_start + sc_time{period_ns_ - 1, SC_NS};
+
+    Checkpoint checkpoint{.time_ns = (restored_time_ + resume_cycle_start).to_seconds() * 1e9,
+                          .energy_list = energy_counter_.getDynamicEnergyList()};
+    saveArchState(checkpoint.arch_state);
+    if (checkpoint.writeToFile(checkpoint_config_->save_file)) {
+        std::cout << fmt::format("Save checkpoint at {} ns to '{}'", checkpoint.time_ns, checkpoint_config_->save_file)
+                  << std::endl;
+    }
+
+    global_memory_.resetTiming(resume_cycle_start);
+    network_.resetTiming();
+    paused_core_cnt_ = 0;
+    for (auto& core : core_list_) {
+        core->resetTiming(resume_cycle_start);
+        core->resume(resume_decode_time - sc_time_stamp());
+    }
+}
+
+void Chip::setBatchLayers(std::vector<std::vector<std::vector<Instruction>>> layer_list) {
+    batch_layer_list_ = std::move(layer_list);
+    if (batch_layer_list_.empty()) {
+        return;
+    }
+    saveArchState(initial_arch_state_);
+    for (auto& core : core_list_) {
+        core->setLayerFinishCall([this]() { processCoreLayerFinish(); });
     }
 }
 
+const std::vector<Reporter>& Chip::getLayerReporterList() const {
+    return layer_reporter_list_;
+}
+
+void Chip::processCoreLayerFinish() {
+    if (++layer_finish_core_cnt_ < core_list_.size()) {
+        return;
+    }
+    layer_finish_core_cnt_ = 0;
+
+    // the layer ends when its last instruction completes, cores checking that execute units drained is not counted
+    sc_time finish_time = layer_start_time_;
+    for (const auto& core : core_list_) {
+        finish_time = std::max(finish_time, core->getLayerFinishTime());
+    }
+    profiler_.finishRun();
+    finishLayer(finish_time);
+    energy_counter_.resetDynamicEnergy();
+    profiler_.reset();
+    loadArchState(initial_arch_state_);
+
+    // cores decode the next layer one period after resuming, that is period - 1 ns after layer start as in a
+    // standalone run, and hardware timing restarts there so every layer times the same as a standalone run
+    layer_start_time_ = sc_time_stamp() + sc_time{1, SC_NS};
+    global_memory_.resetTiming(layer_start_time_);
+    network_.resetTiming();
+    for (auto& core : core_list_) {
+        core->resetTiming(layer_start_time_);
+    }
+
+    bool last_layer = next_layer_index_ + 1 == batch_layer_list_.size();
+    auto& layer = batch_layer_list_[next_layer_index_++];
+    for (int core_id = 0; core_id < core_list_.size(); core_id++) {
+        core_list_[core_id]->loadLayer(std::move(layer[core_id]), last_layer);
+    }
+}
+
+void Chip::finishLayer(const sc_time& finish_time) {
+    auto layer_time = finish_time - layer_start_time_;
+    EnergyCounter::setRunningTimeNS(layer_time);
+    Reporter reporter{layer_time.to_seconds() * 1000, getName(), getEnergyReporter(), 0};
+
+    std::stringstream ss;
+    reporter.report(ss);
+    profiler_.report(ss, reporter.getLatencyNs());
+    layer_reporter_list_.emplace_back(std::move(reporter));
+    layer_report_list_.emplace_back(ss.str());
+}
+
+Reporter Chip::reportBatch(std::ostream& os, bool report_every_core_energy) {
+    Reporter total_reporter{0.0, getName(), EnergyReporter{}, 0};
+    for (int layer_id = 0; layer_id < layer_reporter_list_.size(); layer_id++) {
+        os << fmt::format("\nLayer {}:\n", layer_id) << layer_report_list_[layer_id];
+        total_reporter += layer_reporter_list_[layer_id];
+    }
+
+    os << fmt::format("\nTotal of {} layers:\n", layer_reporter_list_.size());
+    total_reporter.report(os);
+    if (report_every_core_energy) {
+        // energy counters only hold the last layer
+        EnergyCounter::setRunningTimeNS(layer_reporter_list_.back().getLatencyNs());
+        Reporter cores_reporter{layer_reporter_list_.back().getLatencyNs() / 1e6, "Cores", getCoresEnergyReporter(),
+                                0};
+        os << "\nEvery core energy form of the last layer:\n";
+        cores_reporter.reportEnergyForm(os);
+    }
+    network_.report(os, total_reporter.getLatencyNs());
+    reportLoopExtrapolation(os);
+    return std::move(total_reporter);
+}
+
+double Chip::getSimulatedTimeNS() const {
+    return (restored_time_ + sc_time_stamp()).to_seconds() * 1e9;
+}
+
+void Chip::reportLoopExtrapolation(std::ostream& os) const {
+    LoopExtrapolationStat stat;
+    long long decoded_ins_cnt = 0;
+    for (const auto& core : core_list_) {
+        const auto& core_stat = core->getLoopExtrapolationStat();
+        stat.loop_cnt += core_stat.loop_cnt;
+        stat.iteration_cnt += core_stat.iteration_cnt;
+        stat.ins_cnt += core_stat.ins_cnt;
+        stat.latency_ns += core_stat.latency_ns;
+        stat.error_bound_ns = std::max(stat.error_bound_ns, core_stat.error_bound_ns);
+        decoded_ins_cnt += core->getDecodedInsCount();
+    }
+    if (stat.loop_cnt == 0) {
+        return;
+    }
+
+    os << "\nLoop Extrapolation:\n";
+    os << fmt::format("  - {:<28}{}\n", "extrapolated loops:", stat.loop_cnt);
+    os << fmt::format("  - {:<28}{}\n", "extrapolated iterations:", stat.iteration_cnt);
+    os << fmt::format("  - {:<28}{}\n", "extrapolated ins count:", stat.ins_cnt);
+    os << fmt::format("  - {:<28}{:.2f}x\n", "simulated ins speedup:",
+                      static_cast<double>(decoded_ins_cnt + stat.ins_cnt) / std::max(decoded_ins_cnt, 1LL));
+    os << fmt::format("  - {:<28}{:.2f} ns\n", "extrapolated core latency:", stat.latency_ns);
+    os << fmt::format("  - {:<28}{:.2f} ns\n", "latency error bound:", stat.error_bound_ns);
+}
+
 bool Chip::checkRegValues(int core_id, const std::array<int, GENERAL_REG_NUM>& general_reg_expected_values,
                           const std::array<int, SPECIAL_REG_NUM>& special_reg_expected_values) const {
     return core_list_[core_id]->checkRegValues(general_reg_expected_values, special_reg_expected_values);
 }
 
+void Chip::loadArchState(const ChipArchState& state) {
+    for (int core_id = 0; core_id < core_list_.size() && core_id < state.core_state_list.size(); core_id++) {
+        core_list_[core_id]->loadArchState(state.core_state_list[core_id]);
+    }
+    global_memory_.setMemoryDataList(state.global_memory_data_list);
+}
+
+void Chip::saveArchState(ChipArchState& state) const {
+    state.core_state_list.resize(core_list_.size());
+    for (int core_id = 0; core_id < core_list_.size(); core_id++) {
+        core_list_[core_id]->saveArchState(state.core_state_list[core_id]);
+    }
+    state.global_memory_data_list = global_memory_.getMemoryDataList();
+}
+
+void Chip::setRegionEndTrigger(const RegionTriggerConfig* trigger) {
+    for (auto& core : core_list_) {
+        core->setRegionEndTrigger(trigger);
+    }
+}
+
 }  // namespace cimsim
@@ -3,7 +3,9 @@
 //
 
 #pragma once
+#include "base_component/activity_trace.h"
 #include "base_component/base_module.h"
+#include "checkpoint.h"
 #include "core/core.h"
 #include "memory/global_memory.h"
 #include "profiler/profiler.h"
@@ -24,8 +26,41 @@ public:
     bool checkRegValues(int core_id, const std::array<int, GENERAL_REG_NUM>& general_reg_expected_values,
                         const std::array<int, SPECIAL_REG_NUM>& special_reg_expected_values) const;
 
+    void loadArchState(const ChipArchState& state);
+    void saveArchState(ChipArchState& state) const;
+    void setRegionEndTrigger(const RegionTriggerConfig* trigger);
+
+    // pause all cores and save a checkpoint as configured, or resume from a checkpoint before simulation starts
+    void setCheckpointSave(const CheckpointConfig& config);
+    void restoreCheckpoint(const Checkpoint& checkpoint);
+    // the pause point splits send and receive instructions, so no checkpoint is saved. Cores blocked by a transfer
+    // whose other side has paused never pause themselves, which also leaves some cores paused when simulation ends
+    [[nodiscard]] bool isCheckpointSplitTransfer() const;
+
+    // record dynamic energy events during simulation, or replay recorded events instead of simulating, in which case
+    // timing reports are taken from the trace
+    void startActivityTrace(ActivityTrace& trace);
+    void finishActivityTrace(ActivityTrace& trace);
+    bool replayActivityTrace(const ActivityTrace& trace);
+
+    // batch mode, after the first layer run every layer of layer_list on this chip in order. Before each layer,
+    // architectural state is reset to its state before simulation, hardware timing, energy and profiling restart, so
+    // every layer has its own reporter same as a standalone run, and report gives the total of all layers
+    void setBatchLayers(std::vector<std::vector<std::vector<Instruction>>> layer_list);
+    [[nodiscard]] const std::vector<Reporter>& getLayerReporterList() const;
+
 private:
     void processFinishRun();
+    void processCorePause();
+    void saveCheckpointAndResume();
+
+    void processCoreLayerFinish();
+    void finishLayer(const sc_time& finish_time);
+    Reporter reportBatch(std::ostream& os, bool report_every_core_energy);
+
+    [[nodiscard]] double getSimulatedTimeNS() const;
+
+    void reportLoopExtrapolation(std::ostream& os) const;
 
 private:
     Clock clk_;
@@ -36,6 +71,23 @@ private:
     int finish_run_core_cnt_{0};
     sc_time running_time_{};
 
+    // checkpoint
+    const CheckpointConfig* checkpoint_config_{nullptr};
+    int paused_core_cnt_{0};
+    bool checkpoint_split_transfer_{false};
+    sc_time restored_time_{};
+
+    const ActivityTrace* replayed_trace_{nullptr};
+
+    // batch mode
+    std::vector<std::vector<std::vector<Instruction>>> batch_layer_list_{};
+    int next_layer_index_{0};
+    ChipArchState initial_arch_state_{};
+    int layer_finish_core_cnt_{0};
+    sc_time layer_start_time_{};
+    std::vector<Reporter> layer_reporter_list_{};
+    std::vector<std::string> layer_report_list_{};
+
     Profiler profiler_;
 };
 
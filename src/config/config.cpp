@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <iostream>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "fmt/format.h"
 #include "util/util.h"
@@ -688,7 +689,55 @@ DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(RegBufferConfig, size_byte, read_
                                                rw_min_unit_byte, static_power_mW, rw_dynamic_power_per_unit_mW,
                                                has_image, image_file)
 
+bool DRAMConfig::checkValid() const {
+    if (!check_positive(size_byte, width_byte, row_size_byte, channel_cnt, rank_cnt, bank_cnt, scheduler_window)) {
+        std::cerr << "DRAMConfig not valid, 'size_byte, width_byte, row_size_byte, channel_cnt, rank_cnt, bank_cnt, "
+                     "scheduler_window' must be positive"
+                  << std::endl;
+        return false;
+    }
+    if (row_size_byte % width_byte != 0 || size_byte % (row_size_byte * channel_cnt * rank_cnt * bank_cnt) != 0) {
+        std::cerr << "DRAMConfig not valid, 'width_byte' must divide 'row_size_byte', and 'row_size_byte * "
+                     "channel_cnt * rank_cnt * bank_cnt' must divide 'size_byte'"
+                  << std::endl;
+        return false;
+    }
+    if (!check_positive(tBL_cycle) ||
+        !check_not_negative(tRCD_cycle, tRP_cycle, tCL_cycle, tRAS_cycle, tREFI_cycle, tRFC_cycle)) {
+        std::cerr << "DRAMConfig not valid, 'tBL_cycle' must be positive and 'tRCD_cycle, tRP_cycle, tCL_cycle, "
+                     "tRAS_cycle, tREFI_cycle, tRFC_cycle' must be non-negative"
+                  << std::endl;
+        return false;
+    }
+    if (page_policy == +DRAMPagePolicy::other) {
+        std::cerr << "DRAMConfig not valid, 'page_policy' must be 'open_page' or 'closed_page'" << std::endl;
+        return false;
+    }
+    if (!check_not_negative(static_power_mW, activate_dynamic_power_mW, read_dynamic_power_mW,
+                            write_dynamic_power_mW, refresh_dynamic_power_mW)) {
+        std::cerr << "DRAMConfig not valid, 'static_power_mW, activate_dynamic_power_mW, read_dynamic_power_mW, "
+                     "write_dynamic_power_mW, refresh_dynamic_power_mW' must be non-negative"
+                  << std::endl;
+        return false;
+    }
+    if (has_image && image_file.empty()) {
+        std::cerr << "DRAMConfig not valid, 'image_file' must be non-empty when DRAM has a image file." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(DRAMConfig, size_byte, width_byte, row_size_byte, channel_cnt, rank_cnt,
+                                               bank_cnt, tRCD_cycle, tRP_cycle, tCL_cycle, tRAS_cycle, tBL_cycle,
+                                               tREFI_cycle, tRFC_cycle, page_policy, scheduler_window,
+                                               static_power_mW, activate_dynamic_power_mW, read_dynamic_power_mW,
+                                               write_dynamic_power_mW, refresh_dynamic_power_mW, has_image,
+                                               image_file)
+
 int MemoryConfig::getByteSize() const {
+    if (type == +MemoryType::dram) {
+        return dram_config.size_byte;
+    }
     return type == +MemoryType::ram ? ram_config.size_byte : reg_buffer_config.size_byte;
 }
 
@@ -709,7 +758,7 @@ bool MemoryConfig::checkValid() const {
         return false;
     }
     if (type == +MemoryType::other) {
-        std::cerr << fmt::format("MemoryConfig of '{}' not valid, 'type' must be 'ram' or 'reg_buffer'", name)
+        std::cerr << fmt::format("MemoryConfig of '{}' not valid, 'type' must be 'ram', 'reg_buffer' or 'dram'", name)
                   << std::endl;
         return false;
     }
@@ -718,7 +767,8 @@ bool MemoryConfig::checkValid() const {
         return false;
     }
     if (const bool valid = ((type == +MemoryType::ram && ram_config.checkValid()) ||
-                            (type == +MemoryType::reg_buffer && reg_buffer_config.checkValid()));
+                            (type == +MemoryType::reg_buffer && reg_buffer_config.checkValid()) ||
+                            (type == +MemoryType::dram && dram_config.checkValid()));
         !valid) {
         std::cerr << fmt::format("MemoryConfig of '{}' not valid", name) << std::endl;
         return false;
@@ -735,6 +785,8 @@ void to_json(nlohmann::ordered_json& j, const MemoryConfig& config) {
         j["hardware_config"] = config.ram_config;
     } else if (config.type == +MemoryType::reg_buffer) {
         j["hardware_config"] = config.reg_buffer_config;
+    } else if (config.type == +MemoryType::dram) {
+        j["hardware_config"] = config.dram_config;
     }
 }
 
@@ -747,6 +799,8 @@ void from_json(const nlohmann::ordered_json& j, MemoryConfig& config) {
         config.ram_config = j.value("hardware_config", default_obj.ram_config);
     } else if (config.type == +MemoryType::reg_buffer) {
         config.reg_buffer_config = j.value("hardware_config", default_obj.reg_buffer_config);
+    } else if (config.type == +MemoryType::dram) {
+        config.dram_config = j.value("hardware_config", default_obj.dram_config);
     }
 }
 
@@ -849,6 +903,11 @@ bool LocalDedicatedDataPathConfig::checkValid() const {
 DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(LocalDedicatedDataPathConfig, id, memory_pair_list)
 
 bool TransferUnitConfig::checkValid() const {
+    if (!check_positive(inter_core_bus_cnt)) {
+        std::cerr << "TransferUnitConfig not valid, 'inter_core_bus_cnt' must be positive" << std::endl;
+        return false;
+    }
+
     // check LocalDedicatedDataPathConfig
     for (auto& data_path_cfg : local_dedicated_data_path_list) {
         if (!data_path_cfg.checkValid()) {
@@ -869,7 +928,8 @@ bool TransferUnitConfig::checkValid() const {
     return true;
 }
 
-DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(TransferUnitConfig, pipeline, local_dedicated_data_path_list)
+DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(TransferUnitConfig, pipeline, local_dedicated_data_path_list,
+                                               inter_core_bus_cnt)
 
 // CoreConfig
 bool CoreConfig::checkValid() const {
@@ -890,27 +950,99 @@ DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(CoreConfig, control_unit_config,
                                                cim_unit_config, local_memory_unit_config, transfer_unit_config)
 
 // NetworkConfig
-bool NetworkConfig::checkValid() const {
-    if (const bool valid = bus_width_byte > 0 && !network_config_file_path.empty(); !valid) {
-        std::cerr << "NetworkConfig not valid, 'bus_width_byte' must be positive and 'network_config_file_path' must "
-                     "not be empty"
+bool MeshSwitchPlacementConfig::checkValid() const {
+    if (!check_not_negative(x, y)) {
+        std::cerr << fmt::format("MeshSwitchPlacementConfig of switch {} not valid, 'x, y' must be non-negative",
+                                 switch_id)
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
+
+DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(MeshSwitchPlacementConfig, switch_id, x, y)
+
+bool MeshNetworkConfig::checkValid() const {
+    if (!check_positive(x_cnt, y_cnt)) {
+        std::cerr << "MeshNetworkConfig not valid, 'x_cnt, y_cnt' must be positive" << std::endl;
+        return false;
+    }
+    if (routing == +NetworkRouting::other || flow_control == +NetworkFlowControl::other) {
+        std::cerr << "MeshNetworkConfig not valid, 'routing' must be 'xy' or 'west_first', and 'flow_control' must be "
+                     "'wormhole' or 'virtual_cut_through'"
+                  << std::endl;
+        return false;
+    }
+    if (!check_not_negative(router_latency_cycle, link_latency_cycle, router_energy_pJ_per_flit,
+                            link_energy_pJ_per_flit)) {
+        std::cerr << "MeshNetworkConfig not valid, 'router_latency_cycle, link_latency_cycle, "
+                     "router_energy_pJ_per_flit, link_energy_pJ_per_flit' must be non-negative"
                   << std::endl;
         return false;
     }
+    if (!check_vector_valid(switch_placement) ||
+        std::any_of(switch_placement.begin(), switch_placement.end(),
+                    [this](const MeshSwitchPlacementConfig& p) { return p.x >= x_cnt || p.y >= y_cnt; })) {
+        std::cerr << "MeshNetworkConfig not valid, 'switch_placement' out of mesh" << std::endl;
+        return false;
+    }
     return true;
 }
 
-DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(NetworkConfig, bus_width_byte, network_config_file_path);
+DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(MeshNetworkConfig, x_cnt, y_cnt, torus, routing, flow_control,
+                                               router_latency_cycle, link_latency_cycle, router_energy_pJ_per_flit,
+                                               link_energy_pJ_per_flit, switch_placement)
+
+bool NetworkConfig::checkValid() const {
+    if (!check_positive(bus_width_byte)) {
+        std::cerr << "NetworkConfig not valid, 'bus_width_byte' must be positive" << std::endl;
+        return false;
+    }
+    if (model == +NetworkModel::other) {
+        std::cerr << "NetworkConfig not valid, 'model' must be 'table' or 'mesh'" << std::endl;
+        return false;
+    }
+    if ((model == +NetworkModel::mesh || network_config_file_path.empty()) && !mesh_config.checkValid()) {
+        std::cerr << "NetworkConfig not valid" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(NetworkConfig, bus_width_byte, model, network_config_file_path,
+                                               mesh_config);
+
+std::vector<int> GlobalMemoryConfig::getControllerSwitchIdList() const {
+    if (controller_switch_id_list.empty()) {
+        return {global_memory_switch_id};
+    }
+    return controller_switch_id_list;
+}
 
 bool GlobalMemoryConfig::checkValid() const {
     if (!global_memory_unit_config.checkValid()) {
         std::cerr << "GlobalMemoryConfig not valid" << std::endl;
         return false;
     }
+    if (!check_positive(interleave_block_byte, queue_cnt, queue_interleave_byte, max_outstanding_request_cnt)) {
+        std::cerr << "GlobalMemoryConfig not valid, 'interleave_block_byte, queue_cnt, queue_interleave_byte, "
+                     "max_outstanding_request_cnt' must be positive"
+                  << std::endl;
+        return false;
+    }
+    if (auto id_list = getControllerSwitchIdList();
+        std::any_of(id_list.begin(), id_list.end(), [](int id) { return id >= 0; }) ||
+        std::unordered_set<int>{id_list.begin(), id_list.end()}.size() != id_list.size()) {
+        std::cerr << "GlobalMemoryConfig not valid, 'controller_switch_id_list' must be negative and distinct"
+                  << std::endl;
+        return false;
+    }
     return true;
 }
 
-DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(GlobalMemoryConfig, global_memory_unit_config, global_memory_switch_id)
+DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(GlobalMemoryConfig, global_memory_unit_config, global_memory_switch_id,
+                                               controller_switch_id_list, interleave_block_byte, interleave_hash,
+                                               queue_cnt, queue_interleave_byte, max_outstanding_request_cnt)
 
 bool AddressSpaceElementConfig::checkValid() const {
     if (name.empty()) {
@@ -1065,6 +1197,23 @@ bool ChipConfig::checkValid() const {
         std::cerr << "ChipConfig not valid" << std::endl;
         return false;
     }
+    if (network_config.model == +NetworkModel::mesh || network_config.network_config_file_path.empty()) {
+        const auto& mesh_config = network_config.mesh_config;
+        if (core_cnt > mesh_config.x_cnt * mesh_config.y_cnt) {
+            std::cerr << "ChipConfig not valid, 'core_cnt' is larger than router count of mesh network" << std::endl;
+            return false;
+        }
+        for (int switch_id : global_memory_config.getControllerSwitchIdList()) {
+            if (std::none_of(mesh_config.switch_placement.begin(), mesh_config.switch_placement.end(),
+                             [switch_id](const MeshSwitchPlacementConfig& p) { return p.switch_id == switch_id; })) {
+                std::cerr << fmt::format("ChipConfig not valid, global memory switch {} has no 'switch_placement' in "
+                                         "mesh network",
+                                         switch_id)
+                          << std::endl;
+                return false;
+            }
+        }
+    }
 
     return true;
 }
@@ -1072,6 +1221,47 @@ bool ChipConfig::checkValid() const {
 DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(ChipConfig, core_cnt, core_config, global_memory_config, network_config,
                                                address_space_config)
 
+// RegionTriggerConfig
+bool RegionTriggerConfig::isSet() const {
+    return ins_index >= 0 || !inst_group_tag.empty() || ins_cnt >= 0;
+}
+
+bool RegionTriggerConfig::match(int cur_ins_index, const std::string& cur_inst_group_tag,
+                                long long cur_ins_cnt) const {
+    return (ins_index >= 0 && cur_ins_index == ins_index) ||
+           (!inst_group_tag.empty() && cur_inst_group_tag == inst_group_tag) ||
+           (ins_cnt >= 0 && cur_ins_cnt >= ins_cnt);
+}
+
+DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(RegionTriggerConfig, ins_index, inst_group_tag, ins_cnt)
+
+// FastForwardConfig
+bool FastForwardConfig::checkValid() const {
+    if (enable && !region_start.isSet()) {
+        std::cerr << "FastForwardConfig not valid, 'region_start' must be set" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(FastForwardConfig, enable, region_start, region_end)
+
+// CheckpointConfig
+bool CheckpointConfig::isSaveSet() const {
+    return !save_file.empty() && (save_time_ns >= 0.0 || save_ins_cnt >= 0);
+}
+
+bool CheckpointConfig::checkValid() const {
+    if (!save_file.empty() && !isSaveSet()) {
+        std::cerr << "CheckpointConfig not valid, 'save_time_ns' or 'save_ins_cnt' must be set with 'save_file'"
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
+
+DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(CheckpointConfig, save_file, save_time_ns, save_ins_cnt, restore_file)
+
 // SimConfig
 bool SimConfig::checkValid() const {
     if (!check_positive(period_ns)) {
@@ -1079,21 +1269,62 @@ bool SimConfig::checkValid() const {
         return false;
     }
     if (sim_mode == +SimMode::other) {
-        std::cerr << "SimConfig not valid, 'sim_mode' must be 'run_until_time' or 'run_one_round'" << std::endl;
+        std::cerr << "SimConfig not valid, 'sim_mode' must be 'run_until_time', 'run_one_round' or 'functional'"
+                  << std::endl;
         return false;
     }
     if (data_mode == +DataMode::other) {
         std::cerr << "SimConfig not valid, 'data_mode' must be 'real_data' or 'not_real_data'" << std::endl;
         return false;
     }
+    if (sim_mode == +SimMode::functional && data_mode != +DataMode::real_data) {
+        std::cerr << "SimConfig not valid, 'functional' sim mode needs 'real_data' data mode" << std::endl;
+        return false;
+    }
+    if (fast_forward.enable && (sim_mode != +SimMode::run_one_round || data_mode != +DataMode::real_data)) {
+        std::cerr << "SimConfig not valid, fast forward needs 'run_one_round' sim mode and 'real_data' data mode"
+                  << std::endl;
+        return false;
+    }
+    if (!fast_forward.checkValid()) {
+        return false;
+    }
+    if (loop_extrapolation && (data_mode != +DataMode::not_real_data || loop_steady_iteration_cnt < 2)) {
+        std::cerr << "SimConfig not valid, loop extrapolation needs 'not_real_data' data mode and "
+                     "'loop_steady_iteration_cnt' no less than 2"
+                  << std::endl;
+        return false;
+    }
+    if (!checkpoint.checkValid()) {
+        return false;
+    }
+    if ((checkpoint.isSaveSet() || !checkpoint.restore_file.empty()) &&
+        (sim_mode != +SimMode::run_one_round || fast_forward.enable)) {
+        std::cerr << "SimConfig not valid, checkpoint needs 'run_one_round' sim mode without fast forward" << std::endl;
+        return false;
+    }
+    if (!activity_trace_file.empty() && (loop_extrapolation || !checkpoint.restore_file.empty())) {
+        // extrapolated and restored energy is not made of events, so it can not be re-costed
+        std::cerr << "SimConfig not valid, activity trace can not be recorded with loop extrapolation or checkpoint "
+                     "restore"
+                  << std::endl;
+        return false;
+    }
     if (sim_mode == +SimMode::run_until_time && !check_positive(sim_time_ms)) {
         std::cerr << "SimConfig not valid, 'sim_time_ms' must be positive" << std::endl;
         return false;
     }
+    if (thread_stack_size_KB < 0) {
+        std::cerr << "SimConfig not valid, 'thread_stack_size_KB' must be non-negative" << std::endl;
+        return false;
+    }
     return true;
 }
 
-DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(SimConfig, period_ns, sim_mode, data_mode, sim_time_ms)
+DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(SimConfig, period_ns, sim_mode, data_mode, sim_time_ms,
+                                               macro_equivalence_simulation, fast_forward, loop_extrapolation,
+                                               loop_steady_iteration_cnt, checkpoint, activity_trace_file,
+                                               thread_stack_size_KB)
 
 // Config
 bool Config::checkValid() const {
@@ -302,6 +302,44 @@ struct RegBufferConfig {
     DECLARE_TYPE_FROM_TO_JSON_FUNCTION_INTRUSIVE(RegBufferConfig)
 };
 
+struct DRAMConfig {
+    /* DRAM timing model
+     * Address mapping, from high bits to low bits: row, rank, bank, channel, column.
+     * An access is split into bursts of width_byte, and each burst goes through ACT(if row miss), RD/WR and
+     * PRE(if row conflict or closed page policy). Bursts of pending accesses are scheduled by FR-FCFS.
+     */
+    int size_byte{1048576};   // Byte, total dram size
+    int width_byte{32};       // Byte, data of a single burst
+    int row_size_byte{2048};  // Byte, size of a row in a bank
+
+    int channel_cnt{1};
+    int rank_cnt{1};
+    int bank_cnt{8};  // banks per rank
+
+    int tRCD_cycle{14};     // cycle, ACT to RD/WR
+    int tRP_cycle{14};      // cycle, PRE to ACT
+    int tCL_cycle{14};      // cycle, RD/WR to data
+    int tRAS_cycle{32};     // cycle, ACT to PRE
+    int tBL_cycle{4};       // cycle, data burst on bus
+    int tREFI_cycle{3900};  // cycle, refresh interval, 0 means no refresh
+    int tRFC_cycle{180};    // cycle, refresh time
+
+    DRAMPagePolicy page_policy{DRAMPagePolicy::open_page};
+    int scheduler_window{16};  // number of pending bursts the FR-FCFS scheduler looks at
+
+    double static_power_mW{1.0};            // mW
+    double activate_dynamic_power_mW{1.0};  // mW
+    double read_dynamic_power_mW{1.0};      // mW
+    double write_dynamic_power_mW{1.0};     // mW
+    double refresh_dynamic_power_mW{1.0};   // mW
+
+    bool has_image{false};     // whether DRAM memory has an image file
+    std::string image_file{};  // DRAM memory image file path
+
+    [[nodiscard]] bool checkValid() const;
+    DECLARE_TYPE_FROM_TO_JSON_FUNCTION_INTRUSIVE(DRAMConfig)
+};
+
 struct MemoryConfig {
     std::string name{};
     MemoryType type{MemoryType::ram};
@@ -309,6 +347,7 @@ struct MemoryConfig {
 
     RAMConfig ram_config{};
     RegBufferConfig reg_buffer_config{};
+    DRAMConfig dram_config{};
 
     // memory interface
     [[nodiscard]] int getByteSize() const;
@@ -360,6 +399,9 @@ struct TransferUnitConfig {
     bool pipeline{false};
     std::vector<LocalDedicatedDataPathConfig> local_dedicated_data_path_list{};
 
+    // count of inter core bus, each one executes one global load/store or send/recv inst at a time
+    int inter_core_bus_cnt{1};
+
     [[nodiscard]] bool checkValid() const;
     DECLARE_TYPE_FROM_TO_JSON_FUNCTION_INTRUSIVE(TransferUnitConfig)
 };
@@ -378,10 +420,48 @@ struct CoreConfig {
     DECLARE_TYPE_FROM_TO_JSON_FUNCTION_INTRUSIVE(CoreConfig)
 };
 
+struct MeshSwitchPlacementConfig {
+    int switch_id{0};
+    int x{0};
+    int y{0};
+
+    [[nodiscard]] bool checkValid() const;
+    DECLARE_TYPE_FROM_TO_JSON_FUNCTION_INTRUSIVE(MeshSwitchPlacementConfig)
+};
+
+struct MeshNetworkConfig {
+    /* 2D mesh/torus network
+     * Core i is attached to router (i % x_cnt, i / x_cnt) by default, other switches (e.g. global memory) must be
+     * placed by switch_placement, or they are attached to router (0, 0).
+     * Every link transfers one flit (bus_width_byte) per cycle, and a transfer reserves the links on its route.
+     */
+    int x_cnt{4};
+    int y_cnt{4};
+    bool torus{false};
+
+    NetworkRouting routing{NetworkRouting::xy};
+    NetworkFlowControl flow_control{NetworkFlowControl::wormhole};
+
+    int router_latency_cycle{1};  // cycle, per hop
+    int link_latency_cycle{1};    // cycle, per hop
+
+    double router_energy_pJ_per_flit{1.0};  // pJ, per hop
+    double link_energy_pJ_per_flit{1.0};    // pJ, per hop
+
+    std::vector<MeshSwitchPlacementConfig> switch_placement{};
+
+    [[nodiscard]] bool checkValid() const;
+    DECLARE_TYPE_FROM_TO_JSON_FUNCTION_INTRUSIVE(MeshNetworkConfig)
+};
+
 struct NetworkConfig {
     int bus_width_byte{16};
 
+    NetworkModel model{NetworkModel::table};
+    // table model reads per-flit latency and energy from network_config_file_path, or generates them from the
+    // topology of mesh_config when the path is empty
     std::string network_config_file_path{"./network_config.json"};
+    MeshNetworkConfig mesh_config{};
 
     [[nodiscard]] bool checkValid() const;
     DECLARE_TYPE_FROM_TO_JSON_FUNCTION_INTRUSIVE(NetworkConfig)
@@ -391,6 +471,21 @@ struct GlobalMemoryConfig {
     MemoryUnitConfig global_memory_unit_config{};
     int global_memory_switch_id{-10};
 
+    // global memory controllers, each one has its own switch, empty list means only one controller with
+    // global_memory_switch_id. Global address is interleaved across controllers by interleave_block_byte, and block
+    // index is xor-folded before interleaving when interleave_hash is set.
+    std::vector<int> controller_switch_id_list{};
+    int interleave_block_byte{4096};
+    bool interleave_hash{false};
+
+    // each global memory controller, requests are interleaved over its request queues, which are served in parallel
+    // but share the access port of the global memory
+    int queue_cnt{1};
+    int queue_interleave_byte{64};
+    int max_outstanding_request_cnt{16};
+
+    [[nodiscard]] std::vector<int> getControllerSwitchIdList() const;
+
     [[nodiscard]] bool checkValid() const;
     DECLARE_TYPE_FROM_TO_JSON_FUNCTION_INTRUSIVE(GlobalMemoryConfig)
 };
@@ -430,12 +525,68 @@ struct ChipConfig {
     DECLARE_TYPE_FROM_TO_JSON_FUNCTION_INTRUSIVE(ChipConfig)
 };
 
+struct RegionTriggerConfig {
+    // region boundary of each core is at the first instruction matching any of the set conditions
+    int ins_index{-1};
+    std::string inst_group_tag{};
+    long long ins_cnt{-1};  // instructions run by the core since the previous phase started
+
+    [[nodiscard]] bool isSet() const;
+    [[nodiscard]] bool match(int cur_ins_index, const std::string& cur_inst_group_tag, long long cur_ins_cnt) const;
+
+    DECLARE_TYPE_FROM_TO_JSON_FUNCTION_INTRUSIVE(RegionTriggerConfig)
+};
+
+struct FastForwardConfig {
+    // run every core functionally until region_start, then simulate the region with timing and energy, only in
+    // real data mode. If region_end is set, the rest of program after region end is run functionally again.
+    bool enable{false};
+    RegionTriggerConfig region_start{};
+    RegionTriggerConfig region_end{};
+
+    [[nodiscard]] bool checkValid() const;
+    DECLARE_TYPE_FROM_TO_JSON_FUNCTION_INTRUSIVE(FastForwardConfig)
+};
+
+struct CheckpointConfig {
+    // save a checkpoint to save_file when simulated time reaches save_time_ns or a core has decoded save_ins_cnt
+    // instructions, cores are paused and drained before saving. Simulation starts from restore_file if it is set.
+    std::string save_file{};
+    double save_time_ns{-1.0};
+    long long save_ins_cnt{-1};
+    std::string restore_file{};
+
+    [[nodiscard]] bool isSaveSet() const;
+
+    [[nodiscard]] bool checkValid() const;
+    DECLARE_TYPE_FROM_TO_JSON_FUNCTION_INTRUSIVE(CheckpointConfig)
+};
+
 struct SimConfig {
     double period_ns{1.0};  // ns
     SimMode sim_mode{SimMode::run_one_round};
     DataMode data_mode{DataMode::real_data};
     double sim_time_ms{1.0};  // ms
 
+    // simulate only one macro of macros with the same timing relevant state in a group, and scale its energy
+    bool macro_equivalence_simulation{false};
+
+    // skip the remaining iterations of a local loop once loop_steady_iteration_cnt consecutive iterations have the
+    // same latency and energy, only in not real data mode
+    bool loop_extrapolation{false};
+    int loop_steady_iteration_cnt{3};
+
+    CheckpointConfig checkpoint{};
+
+    FastForwardConfig fast_forward{};
+
+    // record dynamic energy events of timing simulation, so the run can be re-costed with configs differing only in
+    // power params, empty means no record
+    std::string activity_trace_file{};
+
+    // coroutine stack size of every SC_THREAD, 0 means the SystemC default, lower it to elaborate more cores
+    int thread_stack_size_KB{0};
+
     [[nodiscard]] bool checkValid() const;
     DECLARE_TYPE_FROM_TO_JSON_FUNCTION_INTRUSIVE(SimConfig)
 };
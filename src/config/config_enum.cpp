@@ -8,11 +8,19 @@
 
 namespace cimsim {
 
-DEFINE_ENUM_FROM_TO_JSON_FUNCTION(SimMode, run_until_time, run_one_round, other)
+DEFINE_ENUM_FROM_TO_JSON_FUNCTION_WITH_OTHER(SimMode, other, run_until_time, run_one_round, functional)
 
 DEFINE_ENUM_FROM_TO_JSON_FUNCTION(DataMode, real_data, not_real_data, other)
 
-DEFINE_ENUM_FROM_TO_JSON_FUNCTION(MemoryType, ram, reg_buffer, other)
+DEFINE_ENUM_FROM_TO_JSON_FUNCTION_WITH_OTHER(MemoryType, other, ram, reg_buffer, dram)
+
+DEFINE_ENUM_FROM_TO_JSON_FUNCTION(DRAMPagePolicy, open_page, closed_page, other)
+
+DEFINE_ENUM_FROM_TO_JSON_FUNCTION(NetworkModel, table, mesh, other)
+
+DEFINE_ENUM_FROM_TO_JSON_FUNCTION(NetworkRouting, xy, west_first, other)
+
+DEFINE_ENUM_FROM_TO_JSON_FUNCTION(NetworkFlowControl, wormhole, virtual_cut_through, other)
 
 DEFINE_ENUM_FROM_TO_JSON_FUNCTION(SIMDInputType, vector, scalar, other)
 
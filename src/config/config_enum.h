@@ -10,7 +10,7 @@
 namespace cimsim {
 
 BETTER_ENUM(SimMode, int,  // NOLINT(*-no-recursion, *-explicit-constructor)
-            run_until_time = 0, run_one_round = 1, other = 2)
+            run_until_time = 0, run_one_round = 1, other = 2, functional = 3)
 DECLARE_TYPE_FROM_TO_JSON_FUNCTION_NON_INTRUSIVE(SimMode)
 
 BETTER_ENUM(DataMode, int,  // NOLINT(*-no-recursion, *-explicit-constructor)
@@ -18,9 +18,25 @@ BETTER_ENUM(DataMode, int,  // NOLINT(*-no-recursion, *-explicit-constructor)
 DECLARE_TYPE_FROM_TO_JSON_FUNCTION_NON_INTRUSIVE(DataMode)
 
 BETTER_ENUM(MemoryType, int,  // NOLINT(*-no-recursion, *-explicit-constructor)
-            ram = 0, reg_buffer = 1, other = 2)
+            ram = 0, reg_buffer = 1, other = 2, dram = 3)
 DECLARE_TYPE_FROM_TO_JSON_FUNCTION_NON_INTRUSIVE(MemoryType)
 
+BETTER_ENUM(DRAMPagePolicy, int,  // NOLINT(*-no-recursion, *-explicit-constructor)
+            open_page = 0, closed_page = 1, other = 2)
+DECLARE_TYPE_FROM_TO_JSON_FUNCTION_NON_INTRUSIVE(DRAMPagePolicy)
+
+BETTER_ENUM(NetworkModel, int,  // NOLINT(*-no-recursion, *-explicit-constructor)
+            table = 0, mesh = 1, other = 2)
+DECLARE_TYPE_FROM_TO_JSON_FUNCTION_NON_INTRUSIVE(NetworkModel)
+
+BETTER_ENUM(NetworkRouting, int,  // NOLINT(*-no-recursion, *-explicit-constructor)
+            xy = 0, west_first = 1, other = 2)
+DECLARE_TYPE_FROM_TO_JSON_FUNCTION_NON_INTRUSIVE(NetworkRouting)
+
+BETTER_ENUM(NetworkFlowControl, int,  // NOLINT(*-no-recursion, *-explicit-constructor)
+            wormhole = 0, virtual_cut_through = 1, other = 2)
+DECLARE_TYPE_FROM_TO_JSON_FUNCTION_NON_INTRUSIVE(NetworkFlowControl)
+
 BETTER_ENUM(SIMDInputType, int,  // NOLINT(*-no-recursion, *-explicit-constructor)
             vector = 0, scalar = 1, other = 2)
 DECLARE_TYPE_FROM_TO_JSON_FUNCTION_NON_INTRUSIVE(SIMDInputType)
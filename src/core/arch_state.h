@@ -0,0 +1,30 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "config/constant.h"
+
+namespace cimsim {
+
+// architectural state handed between functional and timed simulation
+struct CoreArchState {
+    int ins_index{0};
+
+    std::array<int, GENERAL_REG_NUM> general_regs{};
+    std::array<int, SPECIAL_REG_NUM> special_regs{};
+
+    // cim unit state of every macro group
+    std::vector<std::vector<unsigned char>> group_activation_mask_list{};
+    std::vector<std::vector<long long>> group_result_list{};
+
+    // data of every local memory by memory id in address space, cim unit included
+    std::vector<std::vector<uint8_t>> memory_data_list{};
+};
+
+struct ChipArchState {
+    std::vector<CoreArchState> core_state_list{};
+    std::vector<std::vector<uint8_t>> global_memory_data_list{};
+};
+
+}  // namespace cimsim
@@ -0,0 +1,228 @@
+#include "cim_compute_engine.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define CIMSIM_X86_CIM_KERNEL_DISPATCH
+#include <immintrin.h>
+#endif
+
+#include "util/kernel_isa.h"
+#include "util/thread_pool.h"
+#include "util/util.h"
+
+namespace cimsim {
+
+namespace {
+
+// acc[w] += input * weight[w], w in [0, len)
+void multiplyAccumulate(long long input, const int32_t* weight, int len, long long* acc) {
+    for (int w = 0; w < len; w++) {
+        acc[w] += input * weight[w];
+    }
+}
+
+// same as multiplyAccumulate, but accumulate in 32 bits, only used when results can not overflow
+void multiplyAccumulateInt32Generic(int32_t input, const int32_t* weight, int len, int32_t* acc) {
+    for (int w = 0; w < len; w++) {
+        acc[w] += input * weight[w];
+    }
+}
+
+#ifdef CIMSIM_X86_CIM_KERNEL_DISPATCH
+__attribute__((target("avx2"))) void multiplyAccumulateInt32AVX2(int32_t input, const int32_t* weight, int len,
+                                                                   int32_t* acc) {
+    const __m256i input_vec = _mm256_set1_epi32(input);
+    int w = 0;
+    for (; w + 8 <= len; w += 8) {
+        __m256i weight_vec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weight + w));
+        __m256i acc_vec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + w));
+        acc_vec = _mm256_add_epi32(acc_vec, _mm256_mullo_epi32(input_vec, weight_vec));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + w), acc_vec);
+    }
+    multiplyAccumulateInt32Generic(input, weight + w, len - w, acc + w);
+}
+
+__attribute__((target("avx512f"))) void multiplyAccumulateInt32AVX512(int32_t input, const int32_t* weight, int len,
+                                                                        int32_t* acc) {
+    const __m512i input_vec = _mm512_set1_epi32(input);
+    int w = 0;
+    for (; w + 16 <= len; w += 16) {
+        __m512i weight_vec = _mm512_loadu_si512(weight + w);
+        __m512i acc_vec = _mm512_loadu_si512(acc + w);
+        _mm512_storeu_si512(acc + w, _mm512_add_epi32(acc_vec, _mm512_mullo_epi32(input_vec, weight_vec)));
+    }
+    multiplyAccumulateInt32Generic(input, weight + w, len - w, acc + w);
+}
+#endif
+
+using MultiplyAccumulateInt32Kernel = void (*)(int32_t, const int32_t*, int, int32_t*);
+
+MultiplyAccumulateInt32Kernel createMultiplyAccumulateInt32Kernel(KernelIsa limit) {
+#ifdef CIMSIM_X86_CIM_KERNEL_DISPATCH
+    if (isKernelIsaAllowed(limit, KernelIsa::avx512)) {
+        return multiplyAccumulateInt32AVX512;
+    }
+    if (isKernelIsaAllowed(limit, KernelIsa::avx2)) {
+        return multiplyAccumulateInt32AVX2;
+    }
+#endif
+    return multiplyAccumulateInt32Generic;
+}
+
+MultiplyAccumulateInt32Kernel getMultiplyAccumulateInt32Kernel() {
+    static const MultiplyAccumulateInt32Kernel kernel_list[] = {
+        createMultiplyAccumulateInt32Kernel(KernelIsa::generic), createMultiplyAccumulateInt32Kernel(KernelIsa::avx2),
+        createMultiplyAccumulateInt32Kernel(KernelIsa::avx512)};
+    return kernel_list[getKernelIsaLimit()._to_integral()];
+}
+
+}  // namespace
+
+CimComputeEngine::CimComputeEngine(const CimUnitConfig& config)
+    : config_(config)
+    , macro_size_(config.macro_size)
+    , group_cnt_(config.macro_total_cnt / config.macro_group_size)
+    , whole_row_bit_width_(config.macro_size.bit_width_per_row * config.macro_size.element_cnt_per_compartment)
+    , sram_data_(config.getByteSize(), 0)
+    , weight_(static_cast<size_t>(config.macro_total_cnt) * config.macro_size.row_cnt_per_element *
+                  config.macro_size.compartment_cnt_per_macro * config.macro_size.element_cnt_per_compartment,
+              0) {}
+
+CimComputeEngine::~CimComputeEngine() {
+    waitComputeIdle();
+}
+
+void CimComputeEngine::read(int address_byte, int size_byte, std::vector<uint8_t>& data) const {
+    data.resize(size_byte);
+    std::copy_n(sram_data_.begin() + address_byte, size_byte, data.begin());
+}
+
+void CimComputeEngine::write(int address_byte, const std::vector<uint8_t>& data) {
+    waitComputeIdle();
+    std::copy(data.begin(), data.end(), sram_data_.begin() + address_byte);
+
+    long long start_bit = static_cast<long long>(address_byte) * BYTE_TO_BIT;
+    long long end_bit = start_bit + static_cast<long long>(data.size()) * BYTE_TO_BIT;
+    for (long long index = start_bit / whole_row_bit_width_; index * whole_row_bit_width_ < end_bit; index++) {
+        decodeWholeRow(index);
+    }
+}
+
+void CimComputeEngine::computeMacro(int group_id, int macro_id, int row, const MacroInputs& inputs,
+                                    const std::vector<unsigned char>& activation_element_col_mask,
+                                    int mask_start_index, std::vector<long long>& result_list) const {
+    const int col_cnt = macro_size_.element_cnt_per_compartment;
+    const int compartment_cnt = std::min(macro_size_.compartment_cnt_per_macro, inputs.size());
+    const int global_macro_id = group_id * config_.macro_group_size + macro_id;
+    if (row < 0 || row >= macro_size_.row_cnt_per_element) {
+        return;
+    }
+
+    std::vector<long long> acc(col_cnt, 0);
+    // inputs and weights are bounded, so 32-bit accumulation is exact when the widest result fits in 31 bits
+    unsigned long long max_input = 0;
+    for (int h = 0; h < compartment_cnt; h++) {
+        max_input = std::max(max_input, inputs[h]);
+    }
+    long double bound = static_cast<long double>(max_input) * (1LL << (macro_size_.bit_width_per_row - 1)) *
+                        compartment_cnt;
+    if (bound < static_cast<long double>(INT32_MAX)) {
+        const auto multiply_accumulate_int32 = getMultiplyAccumulateInt32Kernel();
+        std::vector<int32_t> acc32(col_cnt, 0);
+        for (int h = 0; h < compartment_cnt; h++) {
+            if (auto input = inputs[h]; input != 0) {
+                multiply_accumulate_int32(static_cast<int32_t>(input),
+                                          &weight_[getWeightOffset(global_macro_id, row, h)], col_cnt, acc32.data());
+            }
+        }
+        std::copy(acc32.begin(), acc32.end(), acc.begin());
+    } else {
+        for (int h = 0; h < compartment_cnt; h++) {
+            if (auto input = inputs[h]; input != 0) {
+                multiplyAccumulate(static_cast<long long>(input),
+                                   &weight_[getWeightOffset(global_macro_id, row, h)], col_cnt, acc.data());
+            }
+        }
+    }
+
+    for (int w = 0; w < col_cnt; w++) {
+        if (activation_element_col_mask.empty() ||
+            getMaskBit(activation_element_col_mask, mask_start_index + w) != 0) {
+            result_list.push_back(acc[w]);
+        }
+    }
+}
+
+std::future<std::vector<long long>> CimComputeEngine::computeGroupAsync(
+    int group_id, int row, MacroGroupInputs inputs, std::vector<unsigned char> activation_element_col_mask) {
+    {
+        std::lock_guard<std::mutex> lock{compute_mutex_};
+        computing_cnt_++;
+    }
+    return ThreadPool::getShared().submit([this, group_id, row, inputs = std::move(inputs),
+                                           mask = std::move(activation_element_col_mask)]() {
+        auto result = computeGroup(group_id, row, inputs, mask);
+        {
+            std::lock_guard<std::mutex> lock{compute_mutex_};
+            computing_cnt_--;
+        }
+        compute_idle_.notify_all();
+        return result;
+    });
+}
+
+std::vector<long long> CimComputeEngine::computeGroup(
+    int group_id, int row, const MacroGroupInputs& inputs,
+    const std::vector<unsigned char>& activation_element_col_mask) const {
+    std::vector<long long> result;
+    result.reserve(config_.macro_group_size * macro_size_.element_cnt_per_compartment);
+    auto activation_index_list = MacroGroupInputs::getActivationIndexList(
+        activation_element_col_mask, config_.macro_group_size, macro_size_.element_cnt_per_compartment);
+    for (int macro_id = 0; macro_id < config_.macro_group_size; macro_id++) {
+        computeMacro(group_id, macro_id, row, inputs.getMacroInputs(activation_index_list[macro_id]),
+                     activation_element_col_mask, macro_id * macro_size_.element_cnt_per_compartment, result);
+    }
+    return result;
+}
+
+void CimComputeEngine::waitComputeIdle() {
+    std::unique_lock<std::mutex> lock{compute_mutex_};
+    compute_idle_.wait(lock, [this]() { return computing_cnt_ == 0; });
+}
+
+void CimComputeEngine::decodeWholeRow(long long whole_row_index) {
+    const int group_size = config_.macro_group_size;
+    const int macro_row_cnt = macro_size_.compartment_cnt_per_macro * macro_size_.row_cnt_per_element;
+
+    int macro_id = static_cast<int>(whole_row_index % group_size);
+    long long rest = whole_row_index / group_size;
+    int group_id, macro_row;
+    if (config_.sram.as_mode == +CimASMode::intragroup) {
+        macro_row = static_cast<int>(rest % macro_row_cnt);
+        group_id = static_cast<int>(rest / macro_row_cnt);
+    } else {
+        group_id = static_cast<int>(rest % group_cnt_);
+        macro_row = static_cast<int>(rest / group_cnt_);
+    }
+    if (group_id >= group_cnt_ || macro_row >= macro_row_cnt) {
+        return;
+    }
+
+    int compartment = macro_row / macro_size_.row_cnt_per_element;
+    int row = macro_row % macro_size_.row_cnt_per_element;
+    int32_t* weight = &weight_[getWeightOffset(group_id * group_size + macro_id, row, compartment)];
+    long long bit_offset = whole_row_index * whole_row_bit_width_;
+    for (int w = 0; w < macro_size_.element_cnt_per_compartment; w++) {
+        auto value = getBitField(sram_data_, bit_offset + w * macro_size_.bit_width_per_row,
+                                 macro_size_.bit_width_per_row);
+        weight[w] = static_cast<int32_t>(signExtend(value, macro_size_.bit_width_per_row));
+    }
+}
+
+long long CimComputeEngine::getWeightOffset(int global_macro_id, int row, int compartment) const {
+    return ((static_cast<long long>(global_macro_id) * macro_size_.row_cnt_per_element + row) *
+                macro_size_.compartment_cnt_per_macro +
+            compartment) *
+           macro_size_.element_cnt_per_compartment;
+}
+
+}  // namespace cimsim
@@ -0,0 +1,71 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <vector>
+
+#include "config/config.h"
+#include "payload.h"
+
+namespace cimsim {
+
+class CimComputeEngine {
+    /* Functional model of cim unit in real data mode
+     * Address space follows doc/ISA.md, one whole row is one row of one compartment in one macro, which contains
+     * element_cnt_per_compartment elements of bit_width_per_row bits. Row r of compartment h is whole row
+     * (h * row_cnt_per_element + r) of the macro.
+     *      intragroup: whole rows of all macros in one group first, then next row, then next group
+     *      intergroup: whole rows of all macros in all groups first, then next row
+     * Weights are signed, inputs are unsigned, so bit-serial MVM of each macro is equal to
+     *      result[w] = sum(input[h] * weight[h][w][row]) for all activated element columns w
+     * Macro groups are computed on the workers of the shared thread pool, write waits for computations in flight.
+     */
+public:
+    explicit CimComputeEngine(const CimUnitConfig& config);
+    ~CimComputeEngine();
+
+    CimComputeEngine(const CimComputeEngine&) = delete;
+    CimComputeEngine& operator=(const CimComputeEngine&) = delete;
+
+    [[nodiscard]] int getByteSize() const {
+        return static_cast<int>(sram_data_.size());
+    }
+
+    void read(int address_byte, int size_byte, std::vector<uint8_t>& data) const;
+    void write(int address_byte, const std::vector<uint8_t>& data);
+
+    // append results of activated element columns to result_list
+    void computeMacro(int group_id, int macro_id, int row, const MacroInputs& inputs,
+                      const std::vector<unsigned char>& activation_element_col_mask, int mask_start_index,
+                      std::vector<long long>& result_list) const;
+
+    // results of all macros of a group in macro order, computed on a worker
+    std::future<std::vector<long long>> computeGroupAsync(int group_id, int row, MacroGroupInputs inputs,
+                                                          std::vector<unsigned char> activation_element_col_mask);
+
+private:
+    [[nodiscard]] std::vector<long long> computeGroup(int group_id, int row, const MacroGroupInputs& inputs,
+                                                      const std::vector<unsigned char>& activation_element_col_mask)
+        const;
+    void waitComputeIdle();
+
+    void decodeWholeRow(long long whole_row_index);
+    [[nodiscard]] long long getWeightOffset(int global_macro_id, int row, int compartment) const;
+
+private:
+    const CimUnitConfig& config_;
+    const CimMacroSizeConfig& macro_size_;
+    const int group_cnt_;
+    const int whole_row_bit_width_;
+
+    std::vector<uint8_t> sram_data_;
+    // weights decoded as [macro][row][compartment][element column], so that one row of all compartments is contiguous
+    std::vector<int32_t> weight_;
+
+    std::mutex compute_mutex_;
+    std::condition_variable compute_idle_;
+    int computing_cnt_{0};
+};
+
+}  // namespace cimsim
@@ -19,21 +19,41 @@ CimUnit::CimUnit(const sc_module_name& name, const CimUnitConfig& config, const
     , config_group_cnt_(config_.macro_total_cnt / config_.macro_group_size)
     , macro_simulation_(base_info.sim_config.data_mode == +DataMode::not_real_data && !config_.bit_sparse &&
                         !config_.input_bit_sparse && !config_.value_sparse) {
+    if (data_mode_ == +DataMode::real_data) {
+        compute_engine_ = std::make_unique<CimComputeEngine>(config_);
+    }
+
     for (int group_id = 0; group_id < (macro_simulation_ ? 1 : config_group_cnt_); group_id++) {
         auto macro_name = fmt::format("MacroGroup_{}", group_id);
-        auto macro_group =
-            std::make_shared<MacroGroup>(macro_name.c_str(), config_, base_info, energy_counter_, macro_simulation_);
+        auto macro_group = std::make_shared<MacroGroup>(macro_name.c_str(), config_, base_info, energy_counter_,
+                                                        macro_simulation_, group_id, compute_engine_.get());
         macro_group_list_.emplace_back(macro_group);
     }
 
     energy_counter_.addSubEnergyCounter("sram read", &sram_read_energy_counter_);
     energy_counter_.addSubEnergyCounter("sram write", &sram_write_energy_counter_);
+    sram_read_energy_counter_.addDynamicPowerParam(config_.sram.read_dynamic_power_per_bit_mW);
+    sram_write_energy_counter_.addDynamicPowerParam(config_.sram.write_dynamic_power_per_bit_mW);
 }
 
 int CimUnit::getMemorySizeByte() const {
     return cim_byte_size_;
 }
 
+std::vector<uint8_t> CimUnit::getData() const {
+    std::vector<uint8_t> data;
+    if (compute_engine_ != nullptr) {
+        compute_engine_->read(0, compute_engine_->getByteSize(), data);
+    }
+    return data;
+}
+
+void CimUnit::setData(const std::vector<uint8_t>& data) {
+    if (compute_engine_ != nullptr && data.size() == compute_engine_->getByteSize()) {
+        compute_engine_->write(0, data);
+    }
+}
+
 int CimUnit::getMemoryDataWidthByte(MemoryAccessType access_type) const {
     return cim_byte_width_;
 }
@@ -55,23 +75,31 @@ sc_time CimUnit::accessAndGetDelay(MemoryAccessPayload& payload) {
     int process_times = IntDivCeil(payload_bit_size, cim_bit_width_);
     double latency;
     if (payload.access_type == +MemoryAccessType::read) {
-        double dynamic_power_mW = config_.sram.read_dynamic_power_per_bit_mW * cim_bit_width_;
         latency = config_.sram.read_latency_cycle * period_ns_ * process_times;
-        sram_read_energy_counter_.addDynamicEnergyPJ(latency, dynamic_power_mW,
+        sram_read_energy_counter_.addDynamicEnergyPJ(latency, config_.sram.read_dynamic_power_per_bit_mW,
+                                                     cim_bit_width_,
                                                      {.core_id = core_id_,
                                                       .ins_id = payload.ins.ins_id,
                                                       .inst_opcode = payload.ins.inst_opcode,
                                                       .inst_group_tag = payload.ins.inst_group_tag,
                                                       .inst_profiler_operator = getName() + "_read"});
+
+        if (compute_engine_ != nullptr) {
+            compute_engine_->read(payload.address_byte, payload.size_byte, payload.data);
+        }
     } else {
-        double dynamic_power_mW = config_.sram.write_dynamic_power_per_bit_mW * cim_bit_width_;
         latency = config_.sram.write_latency_cycle * period_ns_ * process_times;
-        sram_write_energy_counter_.addDynamicEnergyPJ(latency, dynamic_power_mW,
+        sram_write_energy_counter_.addDynamicEnergyPJ(latency, config_.sram.write_dynamic_power_per_bit_mW,
+                                                      cim_bit_width_,
                                                       {.core_id = core_id_,
                                                        .ins_id = payload.ins.ins_id,
                                                        .inst_opcode = payload.ins.inst_opcode,
                                                        .inst_group_tag = payload.ins.inst_group_tag,
                                                        .inst_profiler_operator = getName() + "_write"});
+
+        if (compute_engine_ != nullptr) {
+            compute_engine_->write(payload.address_byte, payload.data);
+        }
     }
 
     return {latency, SC_NS};
@@ -120,12 +148,34 @@ int CimUnit::getMacroGroupMaxActivationMacroCount() const {
         [](const std::shared_ptr<MacroGroup>& macro_group) { return macro_group->getActivationMacroCount(); });
 }
 
+const std::vector<unsigned char>& CimUnit::getMacroGroupActivationElementColumnMask(int group_id) const {
+    static const std::vector<unsigned char> empty_mask{};
+    if (group_id < 0 || group_id >= macro_group_list_.size()) {
+        return empty_mask;
+    }
+    return macro_group_list_[group_id]->getActivationElementColumnMask();
+}
+
 void CimUnit::runMacroGroup(int group_id, MacroGroupPayload group_payload) {
     auto& macro_group = macro_group_list_[group_id];
     macro_group->waitUntilFinishIfBusy();
     macro_group->startExecute(std::move(group_payload));
 }
 
+const std::vector<long long>& CimUnit::getMacroGroupResult(int group_id) const {
+    static const std::vector<long long> empty_result{};
+    if (group_id < 0 || group_id >= macro_group_list_.size()) {
+        return empty_result;
+    }
+    return macro_group_list_[group_id]->getResult();
+}
+
+void CimUnit::setMacroGroupResult(int group_id, std::vector<long long> result) {
+    if (0 <= group_id && group_id < macro_group_list_.size()) {
+        macro_group_list_[group_id]->setResult(std::move(result));
+    }
+}
+
 void CimUnit::bindCimComputeUnit(const std::function<void(int)>& release_resource_func,
                                  const std::function<void()>& finish_ins_func) {
     for (auto& macro_group : macro_group_list_) {
@@ -5,7 +5,9 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 
+#include "cim_compute_engine.h"
 #include "config/config.h"
 #include "macro_group.h"
 #include "memory/memory_hardware.h"
@@ -22,6 +24,8 @@ public:
     sc_time accessAndGetDelay(MemoryAccessPayload& payload) override;
     int getMemoryDataWidthByte(MemoryAccessType access_type) const override;
     int getMemorySizeByte() const override;
+    std::vector<uint8_t> getData() const override;
+    void setData(const std::vector<uint8_t>& data) override;
     const std::string& getMemoryName() override;
 
     // As a cim compute unit
@@ -34,8 +38,11 @@ public:
     int getMacroGroupActivationElementColumnCount(int group_id) const;
     int getMacroGroupActivationMacroCount(int group_id) const;
     int getMacroGroupMaxActivationMacroCount() const;
+    const std::vector<unsigned char>& getMacroGroupActivationElementColumnMask(int group_id) const;
 
     void runMacroGroup(int group_id, MacroGroupPayload group_payload);
+    const std::vector<long long>& getMacroGroupResult(int group_id) const;
+    void setMacroGroupResult(int group_id, std::vector<long long> result);
 
     // Other Interface
     void bindCimComputeUnit(const std::function<void(int)>& release_resource_func,
@@ -51,6 +58,7 @@ private:
     int config_group_cnt_;
     bool macro_simulation_;  // whether to user one actual macro to simulate all logic macros in one core
     std::vector<std::shared_ptr<MacroGroup>> macro_group_list_;
+    std::unique_ptr<CimComputeEngine> compute_engine_;  // only in real data mode
 
     int local_memory_id_{-1};
 
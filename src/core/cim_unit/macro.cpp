@@ -5,6 +5,7 @@
 #include "macro.h"
 
 #include "fmt/format.h"
+#include "util/bit_kernel.h"
 #include "util/log.h"
 #include "util/util.h"
 
@@ -17,13 +18,15 @@ Macro::Macro(const sc_module_name &name, const cimsim::CimUnitConfig &config, co
     , macro_size_(config.macro_size)
     , independent_ipu_(independent_ipu)
     , activation_element_col_cnt_(config.macro_size.element_cnt_per_compartment)
-    , sram_read_("sram_read", base_info, config, getSRAMReadDynamicPower, config_.sram.read_latency_cycle, 1)
-    , post_process_("post_proecess", base_info, config, getPostProcessDynamicPower,
-                    config_.bit_sparse ? config_.bit_sparse_config.latency_cycle : 0, 1)
-    , adder_tree_("adder_tree", base_info, config, config.adder_tree, getAdderTreeDynamicPower)
-    , shift_adder_("shift_adder", base_info, config, config.shift_adder, getShiftAdderDynamicPower)
-    , result_adder_("result_adder", base_info, config, config.result_adder, getResultAdderDynamicPower) {
+    , sram_read_("sram_read", base_info, config, config.sram.read_dynamic_power_per_bit_mW,
+                 getSRAMReadPowerUnitCount, config_.sram.read_latency_cycle, 1)
+    , post_process_("post_proecess", base_info, config, config.bit_sparse_config.dynamic_power_mW,
+                    getPostProcessPowerUnitCount, config_.bit_sparse ? config_.bit_sparse_config.latency_cycle : 0, 1)
+    , adder_tree_("adder_tree", base_info, config, config.adder_tree, getAdderTreePowerUnitCount)
+    , shift_adder_("shift_adder", base_info, config, config.shift_adder, getShiftAdderPowerUnitCount)
+    , result_adder_("result_adder", base_info, config, config.result_adder, getResultAdderPowerUnitCount) {
     SC_THREAD(processIPUAndIssue)
+    setThreadStackSize();
 
     // set static energy power
     int simulation_macro_group_cnt = macro_simulation ? config_.macro_total_cnt / config_.macro_group_size : 1;
@@ -46,6 +49,8 @@ Macro::Macro(const sc_module_name &name, const cimsim::CimUnitConfig &config, co
     adder_tree_.setStaticPower(config_.adder_tree.static_power_mW * adder_tree_cnt);
     shift_adder_.setStaticPower(config_.shift_adder.static_power_mW * shift_adder_cnt);
     result_adder_.setStaticPower(config_.result_adder.static_power_mW * result_adder_cnt);
+    ipu_energy_counter_.addDynamicPowerParam(config_.ipu.dynamic_power_mW);
+    meta_buffer_energy_counter_.addDynamicPowerParam(config_.bit_sparse_config.reg_buffer_dynamic_power_mW_per_unit);
 
     if (independent_ipu_) {
         cim_unit_energy_counter.addSubEnergyCounter("ipu", &ipu_energy_counter_);
@@ -77,18 +82,21 @@ void Macro::waitUntilFinishIfBusy() {
 
 void Macro::setActivationElementColumn(const std::vector<unsigned char> &macros_activation_element_col_mask,
                                        int start_index) {
-    activation_element_col_cnt_ = 0;
-    for (int i = 0; i < macro_size_.element_cnt_per_compartment; i++) {
-        if (getMaskBit(macros_activation_element_col_mask, i + start_index) != 0) {
-            activation_element_col_cnt_++;
-        }
-    }
+    activation_element_col_cnt_ =
+        countMaskBits(macros_activation_element_col_mask, start_index, macro_size_.element_cnt_per_compartment);
 }
 
 int Macro::getActivationElementColumnCount() const {
     return activation_element_col_cnt_;
 }
 
+MacroTimingKey Macro::getTimingKey(const MacroPayload &payload) const {
+    auto [batch_cnt, activation_compartment_num] = getBatchCountAndActivationCompartmentCount(payload);
+    return {.activation_element_col_cnt = activation_element_col_cnt_,
+            .batch_cnt = batch_cnt,
+            .compartment_cnt = activation_compartment_num};
+}
+
 void Macro::bindNextModuleSocket(MacroStageSocket *next_module_socket) {
     result_adder_.bindNextStageSocket(next_module_socket, false);
 }
@@ -119,10 +127,10 @@ void Macro::processIPUAndIssue() {
         if (config_.bit_sparse && payload.bit_sparse && batch_cnt > 0) {
             int meta_size_byte = config_.bit_sparse_config.mask_bit_width * macro_size_.element_cnt_per_compartment *
                                  macro_size_.compartment_cnt_per_macro / BYTE_TO_BIT;
-            double meta_read_dynamic_power_mW = config_.bit_sparse_config.reg_buffer_dynamic_power_mW_per_unit *
-                                                IntDivCeil(meta_size_byte, config_.bit_sparse_config.unit_byte);
+            int meta_unit_cnt = IntDivCeil(meta_size_byte, config_.bit_sparse_config.unit_byte);
             meta_buffer_energy_counter_.addDynamicEnergyPJ(
-                period_ns_, meta_read_dynamic_power_mW * submodule_payload.sub_ins_info->simulated_macro_cnt,
+                period_ns_, config_.bit_sparse_config.reg_buffer_dynamic_power_mW_per_unit,
+                meta_unit_cnt * submodule_payload.sub_ins_info->simulated_macro_cnt,
                 {.core_id = core_id_,
                  .ins_id = payload.cim_ins_info.ins_id,
                  .inst_opcode = payload.cim_ins_info.inst_opcode,
@@ -131,15 +139,16 @@ void Macro::processIPUAndIssue() {
         }
 
         for (int batch = 0; batch < batch_cnt; batch++) {
-            submodule_payload.batch_info = std::make_shared<MacroBatchInfo>(
-                MacroBatchInfo{.batch_num = batch, .last_batch = (batch == batch_cnt - 1)});
+            submodule_payload.batch_info = MacroBatchInfo{.batch_num = batch, .last_batch = (batch == batch_cnt - 1)};
 
             CORE_LOG(fmt::format("{} start ipu and issue, ins pc: {}, sub ins num: {}, batch: {}", getName(),
                                  cim_ins_info.ins_pc, cim_ins_info.sub_ins_num,
-                                 submodule_payload.batch_info->batch_num));
-            double dynamic_power_mW = config_.ipu.dynamic_power_mW;
+                                 submodule_payload.batch_info.batch_num));
+            // in value sparse mode every macro has its own ipu
+            int ipu_cnt = config_.value_sparse ? payload.class_macro_cnt : 1;
             double latency = config_.ipu.latency_cycle * period_ns_;
-            ipu_energy_counter_.addDynamicEnergyPJ(latency, dynamic_power_mW * sub_ins_info.simulated_group_cnt,
+            ipu_energy_counter_.addDynamicEnergyPJ(latency, config_.ipu.dynamic_power_mW,
+                                                   ipu_cnt * sub_ins_info.simulated_group_cnt,
                                                    {.core_id = core_id_,
                                                     .ins_id = payload.cim_ins_info.ins_id,
                                                     .inst_opcode = payload.cim_ins_info.inst_opcode,
@@ -154,50 +163,47 @@ void Macro::processIPUAndIssue() {
     }
 }
 
-double Macro::getSRAMReadDynamicPower(const CimUnitConfig &config, const MacroSubmodulePayload &payload) {
-    double dynamic_power_mW = config.sram.read_dynamic_power_per_bit_mW * config.macro_size.bit_width_per_row * 1 *
-                              config.macro_size.element_cnt_per_compartment *
-                              config.macro_size.compartment_cnt_per_macro;
-    return dynamic_power_mW * payload.sub_ins_info->simulated_macro_cnt;
+double Macro::getSRAMReadPowerUnitCount(const CimUnitConfig &config, const MacroSubmodulePayload &payload) {
+    int bit_cnt = config.macro_size.bit_width_per_row * 1 * config.macro_size.element_cnt_per_compartment *
+                  config.macro_size.compartment_cnt_per_macro;
+    return bit_cnt * payload.sub_ins_info->simulated_macro_cnt;
 }
 
-double Macro::getPostProcessDynamicPower(const CimUnitConfig &config, const MacroSubmodulePayload &payload) {
-    double dynamic_power_mW = config.bit_sparse_config.dynamic_power_mW *
-                              payload.sub_ins_info->activation_element_col_cnt * payload.sub_ins_info->compartment_num;
-    return config.bit_sparse && payload.sub_ins_info->bit_sparse
-               ? dynamic_power_mW * payload.sub_ins_info->simulated_macro_cnt
-               : 0;
+double Macro::getPostProcessPowerUnitCount(const CimUnitConfig &config, const MacroSubmodulePayload &payload) {
+    int unit_cnt = payload.sub_ins_info->activation_element_col_cnt * payload.sub_ins_info->compartment_num;
+    return config.bit_sparse && payload.sub_ins_info->bit_sparse ? unit_cnt * payload.sub_ins_info->simulated_macro_cnt
+                                                                 : 0;
 }
 
-double Macro::getAdderTreeDynamicPower(const CimUnitConfig &config, const MacroSubmodulePayload &payload) {
-    double dynamic_power_mW = config.adder_tree.dynamic_power_mW * payload.sub_ins_info->activation_element_col_cnt;
-    return dynamic_power_mW * payload.sub_ins_info->simulated_macro_cnt;
+double Macro::getAdderTreePowerUnitCount(const CimUnitConfig &config, const MacroSubmodulePayload &payload) {
+    return payload.sub_ins_info->activation_element_col_cnt * payload.sub_ins_info->simulated_macro_cnt;
 }
 
-double Macro::getShiftAdderDynamicPower(const CimUnitConfig &config, const MacroSubmodulePayload &payload) {
-    double dynamic_power_mW = config.shift_adder.dynamic_power_mW * payload.sub_ins_info->activation_element_col_cnt;
-    return dynamic_power_mW * payload.sub_ins_info->simulated_macro_cnt;
+double Macro::getShiftAdderPowerUnitCount(const CimUnitConfig &config, const MacroSubmodulePayload &payload) {
+    return payload.sub_ins_info->activation_element_col_cnt * payload.sub_ins_info->simulated_macro_cnt;
 }
 
-double Macro::getResultAdderDynamicPower(const CimUnitConfig &config, const MacroSubmodulePayload &payload) {
-    double dynamic_power_mW = config.result_adder.dynamic_power_mW * payload.sub_ins_info->activation_element_col_cnt;
-    return dynamic_power_mW * payload.sub_ins_info->simulated_macro_cnt;
+double Macro::getResultAdderPowerUnitCount(const CimUnitConfig &config, const MacroSubmodulePayload &payload) {
+    return payload.sub_ins_info->activation_element_col_cnt * payload.sub_ins_info->simulated_macro_cnt;
 }
 
 std::pair<int, int> Macro::getBatchCountAndActivationCompartmentCount(const MacroPayload &payload) const {
-    int valid_input_cnt = std::min(macro_size_.compartment_cnt_per_macro, static_cast<int>(payload.inputs.size()));
-    int activation_compartment_num = static_cast<int>(std::count_if(
-        payload.inputs.begin(), payload.inputs.begin() + valid_input_cnt, [](auto input) { return input != 0; }));
+    int valid_input_cnt = std::min(macro_size_.compartment_cnt_per_macro, payload.inputs.size());
+    int activation_compartment_num = 0;
+    for (int i = 0; i < valid_input_cnt; i++) {
+        if (payload.inputs[i] != 0) {
+            activation_compartment_num++;
+        }
+    }
     int batch_num;
     if (data_mode_ == +DataMode::real_data) {
         if (config_.input_bit_sparse && payload.bit_sparse) {
-            batch_num = 0;
-            for (int i = 0; i < payload.input_bit_width; i++) {
-                if (std::any_of(payload.inputs.begin(), payload.inputs.begin() + valid_input_cnt,
-                                [i](auto input) { return (input & (1 << i)) != 0; })) {
-                    batch_num++;
-                }
+            // or all inputs once, each set bit is a non-zero bit plane which needs one batch
+            unsigned long long bit_planes = payload.inputs.getBitPlanes(valid_input_cnt);
+            if (payload.input_bit_width < 64) {
+                bit_planes &= (1ULL << payload.input_bit_width) - 1;
             }
+            batch_num = popcount(bit_planes);
         } else {
             batch_num = activation_compartment_num == 0 ? 0 : payload.input_bit_width;
         }
@@ -13,6 +13,18 @@ namespace cimsim {
 
 using MacroSubmoduleSocket = SubmoduleSocket<MacroSubmodulePayload>;
 
+struct MacroTimingKey {
+    // macros with the same key take the same time and energy for the same instruction
+    int activation_element_col_cnt{0};
+    int batch_cnt{0};
+    int compartment_cnt{0};
+
+    bool operator==(const MacroTimingKey& other) const {
+        return activation_element_col_cnt == other.activation_element_col_cnt && batch_cnt == other.batch_cnt &&
+               compartment_cnt == other.compartment_cnt;
+    }
+};
+
 class Macro : public BaseModule {
 public:
     SC_HAS_PROCESS(Macro);
@@ -26,16 +38,17 @@ public:
     void setActivationElementColumn(const std::vector<unsigned char>& macros_activation_element_col_mask,
                                     int start_index = 0);
     int getActivationElementColumnCount() const;
+    MacroTimingKey getTimingKey(const MacroPayload& payload) const;
 
     void bindNextModuleSocket(MacroStageSocket* next_module_socket);
 private:
     [[noreturn]] void processIPUAndIssue();
 
-    static double getSRAMReadDynamicPower(const CimUnitConfig& config, const MacroSubmodulePayload& payload);
-    static double getPostProcessDynamicPower(const CimUnitConfig& config, const MacroSubmodulePayload& payload);
-    static double getAdderTreeDynamicPower(const CimUnitConfig& config, const MacroSubmodulePayload& payload);
-    static double getShiftAdderDynamicPower(const CimUnitConfig& config, const MacroSubmodulePayload& payload);
-    static double getResultAdderDynamicPower(const CimUnitConfig& config, const MacroSubmodulePayload& payload);
+    static double getSRAMReadPowerUnitCount(const CimUnitConfig& config, const MacroSubmodulePayload& payload);
+    static double getPostProcessPowerUnitCount(const CimUnitConfig& config, const MacroSubmodulePayload& payload);
+    static double getAdderTreePowerUnitCount(const CimUnitConfig& config, const MacroSubmodulePayload& payload);
+    static double getShiftAdderPowerUnitCount(const CimUnitConfig& config, const MacroSubmodulePayload& payload);
+    static double getResultAdderPowerUnitCount(const CimUnitConfig& config, const MacroSubmodulePayload& payload);
 
     std::pair<int, int> getBatchCountAndActivationCompartmentCount(const MacroPayload& payload) const;
 
@@ -4,6 +4,8 @@
 
 #include "macro_group.h"
 
+#include <stdexcept>
+
 #include "fmt/format.h"
 #include "util/log.h"
 #include "util/util.h"
@@ -11,11 +13,15 @@
 namespace cimsim {
 
 MacroGroup::MacroGroup(const sc_module_name &name, const CimUnitConfig &config, const BaseInfo &base_info,
-                       EnergyCounter &cim_unit_energy_counter, bool macro_simulation)
+                       EnergyCounter &cim_unit_energy_counter, bool macro_simulation, int group_id,
+                       CimComputeEngine *compute_engine)
     : BaseModule(name, base_info)
     , config_(config)
     , macro_size_(config.macro_size)
     , activation_macro_cnt_(config.macro_group_size)
+    , macro_equivalence_simulation_(base_info.sim_config.macro_equivalence_simulation && !macro_simulation)
+    , group_id_(group_id)
+    , compute_engine_(compute_engine)
     , sram_read_("sram_read", base_info, config_.sram.read_latency_cycle, 1, false)
     , post_process_("post_process", base_info, config_.bit_sparse ? config_.bit_sparse_config.latency_cycle : 0, 1,
                     false)
@@ -23,11 +29,15 @@ MacroGroup::MacroGroup(const sc_module_name &name, const CimUnitConfig &config,
     , shift_adder_("shift_adder", base_info, config_.shift_adder, false)
     , result_adder_("result_adder", base_info, config_.result_adder, true) {
     SC_THREAD(processIPUAndIssue)
+    setThreadStackSize();
 
     sram_read_.bindNextStageSocket(post_process_.getExecuteSocket(), false);
     post_process_.bindNextStageSocket(adder_tree_.getExecuteSocket(), false);
     adder_tree_.bindNextStageSocket(shift_adder_.getExecuteSocket(), false);
     shift_adder_.bindNextStageSocket(result_adder_.getExecuteSocket(), true);
+    if (compute_engine_ != nullptr) {
+        result_adder_.setFinishGroupFunc([this]() { commitResult(); });
+    }
 
     for (int i = 0; i < (macro_simulation ? 1 : config_.macro_group_size); i++) {
         auto macro_name = fmt::format("Macro_{}", i);
@@ -35,6 +45,8 @@ MacroGroup::MacroGroup(const sc_module_name &name, const CimUnitConfig &config,
         macro_list_.push_back(std::make_shared<Macro>(macro_name.c_str(), config_, base_info, independent_ipu,
                                                       cim_unit_energy_counter, macro_simulation));
     }
+    activation_index_list_ = MacroGroupInputs::getActivationIndexList({}, static_cast<int>(macro_list_.size()),
+                                                                      macro_size_.element_cnt_per_compartment);
 }
 
 void MacroGroup::startExecute(cimsim::MacroGroupPayload payload) {
@@ -56,14 +68,17 @@ void MacroGroup::setFinishInsFunc(std::function<void()> finish_ins_func) {
 
 void MacroGroup::setMacrosActivationElementColumn(
     const std::vector<unsigned char> &macros_activation_element_col_mask) {
+    activation_element_col_mask_ = macros_activation_element_col_mask;
     for (int i = 0; i < macro_list_.size(); i++) {
         int start_index = i * macro_size_.element_cnt_per_compartment;
         macro_list_[i]->setActivationElementColumn(macros_activation_element_col_mask, start_index);
     }
 
-    activation_macro_cnt_ = std::transform_reduce(
-        macro_list_.begin(), macro_list_.end(), 0, [](int a, int b) { return a + b; },
-        [](const std::shared_ptr<Macro> &macro) { return (macro->getActivationElementColumnCount() > 0) ? 1 : 0; });
+    activation_macro_cnt_ = 0;
+    for (int i = 0; i < macro_list_.size(); i++) {
+        bool activated = macro_list_[i]->getActivationElementColumnCount() > 0;
+        activation_index_list_[i] = activated ? activation_macro_cnt_++ : -1;
+    }
 }
 
 int MacroGroup::getActivationMacroCount() const {
@@ -76,6 +91,95 @@ int MacroGroup::getActivationElementColumnCount() const {
         [](const std::shared_ptr<Macro> &macro) { return macro->getActivationElementColumnCount(); });
 }
 
+const std::vector<unsigned char> &MacroGroup::getActivationElementColumnMask() const {
+    return activation_element_col_mask_;
+}
+
+const std::vector<long long> &MacroGroup::getResult() const {
+    return result_;
+}
+
+void MacroGroup::setResult(std::vector<long long> result) {
+    result_ = std::move(result);
+}
+
+void MacroGroup::computeResult(const MacroGroupPayload &payload) {
+    if (config_.bit_sparse && payload.bit_sparse) {
+        throw std::runtime_error{fmt::format("{}: real data mode does not decode bit sparse weights, ins pc: {}",
+                                             getFullName(), payload.cim_ins_info.ins_pc)};
+    }
+    computing_result_queue_.emplace(
+        compute_engine_->computeGroupAsync(group_id_, payload.row, payload.macro_inputs, activation_element_col_mask_));
+}
+
+void MacroGroup::commitResult() {
+    if (!computing_result_queue_.empty()) {
+        result_ = computing_result_queue_.front().get();
+        computing_result_queue_.pop();
+    }
+}
+
+void MacroGroup::issueMacros(MacroGroupPayload &payload) {
+    for (int macro_id = 0; macro_id < macro_list_.size(); macro_id++) {
+        MacroPayload macro_payload{.cim_ins_info = payload.cim_ins_info,
+                                   .row = payload.row,
+                                   .input_bit_width = payload.input_bit_width,
+                                   .bit_sparse = payload.bit_sparse,
+                                   .inputs = payload.macro_inputs.getMacroInputs(activation_index_list_[macro_id]),
+                                   .simulated_group_cnt = payload.simulated_group_cnt,
+                                   .simulated_macro_cnt = payload.simulated_macro_cnt};
+
+        auto &macro = macro_list_[macro_id];
+        macro->waitUntilFinishIfBusy();
+        macro->startExecute(std::move(macro_payload));
+    }
+}
+
+void MacroGroup::issueMacrosByEquivalenceClass(MacroGroupPayload &payload) {
+    // macros with the same timing key behave the same, so only the first macro of each class is simulated, with its
+    // energy scaled by the class size. Macros without activation element columns do nothing and are skipped.
+    macro_class_list_.clear();
+    macro_class_id_list_.assign(macro_list_.size(), -1);
+    for (int macro_id = 0; macro_id < macro_list_.size(); macro_id++) {
+        if (macro_list_[macro_id]->getActivationElementColumnCount() == 0) {
+            continue;
+        }
+        MacroPayload key_payload{.input_bit_width = payload.input_bit_width,
+                                 .bit_sparse = payload.bit_sparse,
+                                 .inputs = payload.macro_inputs.getMacroInputs(activation_index_list_[macro_id])};
+        auto key = macro_list_[macro_id]->getTimingKey(key_payload);
+
+        auto found = std::find_if(macro_class_list_.begin(), macro_class_list_.end(),
+                                  [&key](const MacroClass &macro_class) { return macro_class.key == key; });
+        if (found == macro_class_list_.end()) {
+            macro_class_list_.push_back({.key = key, .representative_macro_id = macro_id, .macro_cnt = 0});
+            found = macro_class_list_.end() - 1;
+        }
+        found->macro_cnt++;
+        macro_class_id_list_[macro_id] = static_cast<int>(found - macro_class_list_.begin());
+    }
+
+    for (int class_id = 0; class_id < macro_class_list_.size(); class_id++) {
+        const auto &macro_class = macro_class_list_[class_id];
+        for (int macro_id = 0; macro_id < macro_list_.size(); macro_id++) {
+            if (macro_class_id_list_[macro_id] == class_id) {
+                macro_list_[macro_id]->waitUntilFinishIfBusy();
+            }
+        }
+
+        int macro_id = macro_class.representative_macro_id;
+        MacroPayload macro_payload{.cim_ins_info = payload.cim_ins_info,
+                                   .row = payload.row,
+                                   .input_bit_width = payload.input_bit_width,
+                                   .bit_sparse = payload.bit_sparse,
+                                   .inputs = payload.macro_inputs.getMacroInputs(activation_index_list_[macro_id]),
+                                   .simulated_group_cnt = payload.simulated_group_cnt,
+                                   .simulated_macro_cnt = payload.simulated_macro_cnt * macro_class.macro_cnt,
+                                   .class_macro_cnt = macro_class.macro_cnt};
+        macro_list_[macro_id]->startExecute(std::move(macro_payload));
+    }
+}
+
 void MacroGroup::processIPUAndIssue() {
     while (true) {
         macro_group_socket_.waitUntilStart();
@@ -85,20 +189,17 @@ void MacroGroup::processIPUAndIssue() {
         CORE_LOG(fmt::format("{} start, ins pc: {}, sub ins num: {}", getName(), cim_ins_info.ins_pc,
                              cim_ins_info.sub_ins_num));
 
-        for (int macro_id = 0; macro_id < macro_list_.size(); macro_id++) {
-            MacroPayload macro_payload{.cim_ins_info = cim_ins_info,
-                                       .row = payload.row,
-                                       .input_bit_width = payload.input_bit_width,
-                                       .bit_sparse = payload.bit_sparse,
-                                       .simulated_group_cnt = payload.simulated_group_cnt,
-                                       .simulated_macro_cnt = payload.simulated_macro_cnt};
-            if (macro_id < payload.macro_inputs.size()) {
-                macro_payload.inputs.swap(payload.macro_inputs[macro_id]);
+        if (compute_engine_ != nullptr) {
+            computeResult(payload);
+            if (payload.input_bit_width <= 0) {
+                commitResult();
             }
+        }
 
-            auto &macro = macro_list_[macro_id];
-            macro->waitUntilFinishIfBusy();
-            macro->startExecute(std::move(macro_payload));
+        if (macro_equivalence_simulation_) {
+            issueMacrosByEquivalenceClass(payload);
+        } else {
+            issueMacros(payload);
         }
 
         MacroGroupSubmodulePayload submodule_payload{
@@ -106,12 +207,11 @@ void MacroGroup::processIPUAndIssue() {
                 .cim_ins_info = cim_ins_info, .last_group = payload.last_group, .bit_sparse = payload.bit_sparse})};
         int batch_count = payload.input_bit_width;
         for (int batch = 0; batch < batch_count; batch++) {
-            submodule_payload.batch_info = std::make_shared<MacroBatchInfo>(
-                MacroBatchInfo{.batch_num = batch, .last_batch = (batch == batch_count - 1)});
+            submodule_payload.batch_info = MacroBatchInfo{.batch_num = batch, .last_batch = (batch == batch_count - 1)};
 
             CORE_LOG(fmt::format("{} start ipu and issue, ins pc: {}, sub ins num: {}, batch: {}", getName(),
                                  cim_ins_info.ins_pc, cim_ins_info.sub_ins_num,
-                                 submodule_payload.batch_info->batch_num));
+                                 submodule_payload.batch_info.batch_num));
             double latency = config_.ipu.latency_cycle * period_ns_;
             wait(latency, SC_NS);
             waitAndStartNextStage(submodule_payload, *(sram_read_.getExecuteSocket()));
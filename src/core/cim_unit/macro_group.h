@@ -3,9 +3,12 @@
 //
 
 #pragma once
+#include <future>
+#include <queue>
 #include <vector>
 
 #include "base_component/base_module.h"
+#include "cim_compute_engine.h"
 #include "config/config.h"
 #include "macro.h"
 #include "macro_group_module.h"
@@ -17,7 +20,8 @@ public:
     SC_HAS_PROCESS(MacroGroup);
 
     MacroGroup(const sc_module_name& name, const CimUnitConfig& config, const BaseInfo& base_info,
-               EnergyCounter& cim_unit_energy_counter, bool macro_simulation = false);
+               EnergyCounter& cim_unit_energy_counter, bool macro_simulation = false, int group_id = 0,
+               CimComputeEngine* compute_engine = nullptr);
 
     void startExecute(MacroGroupPayload payload);
     void waitUntilFinishIfBusy();
@@ -28,16 +32,44 @@ public:
     void setMacrosActivationElementColumn(const std::vector<unsigned char>& macros_activation_element_col_mask);
     int getActivationMacroCount() const;
     int getActivationElementColumnCount() const;
+    const std::vector<unsigned char>& getActivationElementColumnMask() const;
+
+    // results of the last finished cim compute ins, only in real data mode
+    const std::vector<long long>& getResult() const;
+    void setResult(std::vector<long long> result);
 
 private:
     [[noreturn]] void processIPUAndIssue();
 
+    void computeResult(const MacroGroupPayload& payload);
+    void commitResult();
+
+    void issueMacros(MacroGroupPayload& payload);
+    void issueMacrosByEquivalenceClass(MacroGroupPayload& payload);
+
 private:
     const CimUnitConfig& config_;
     const CimMacroSizeConfig& macro_size_;
 
     std::vector<std::shared_ptr<Macro>> macro_list_;
     int activation_macro_cnt_{0};
+    std::vector<int> activation_index_list_{};  // index of each macro's inputs in MacroGroupInputs
+
+    struct MacroClass {
+        MacroTimingKey key{};
+        int representative_macro_id{0};
+        int macro_cnt{0};
+    };
+    const bool macro_equivalence_simulation_;
+    std::vector<MacroClass> macro_class_list_{};
+    std::vector<int> macro_class_id_list_{};
+    std::vector<unsigned char> activation_element_col_mask_{};
+
+    const int group_id_;
+    CimComputeEngine* compute_engine_;
+    // results are computed on workers and wait until result adder finishes
+    std::queue<std::future<std::vector<long long>>> computing_result_queue_{};
+    std::vector<long long> result_{};
 
     SubmoduleSocket<MacroGroupPayload> macro_group_socket_{};
 
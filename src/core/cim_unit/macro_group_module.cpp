@@ -17,6 +17,7 @@ MacroGroupPipelineNormalStage::MacroGroupPipelineNormalStage(const sc_module_nam
                                                              int latency_cycle)
     : MacroGroupPipelineStage(name, base_info, latency_cycle) {
     SC_THREAD(processExecute)
+    setThreadStackSize();
 }
 
 [[noreturn]] void MacroGroupPipelineNormalStage::processExecute() {
@@ -26,12 +27,12 @@ MacroGroupPipelineNormalStage::MacroGroupPipelineNormalStage(const sc_module_nam
         const auto& payload = exec_socket_.payload;
         const auto& cim_ins_info = payload.sub_ins_info->cim_ins_info;
         CORE_LOG(fmt::format("{} start, ins pc: {}, sub ins num: {}, batch: {}", getFullName(), cim_ins_info.ins_pc,
-                             cim_ins_info.sub_ins_num, payload.batch_info->batch_num));
+                             cim_ins_info.sub_ins_num, payload.batch_info.batch_num));
 
         double latency = latency_cycle_ * period_ns_;
         wait(latency, SC_NS);
 
-        if (next_stage_socket_ != nullptr && (!last_batch_trigger_next_ || payload.batch_info->last_batch)) {
+        if (next_stage_socket_ != nullptr && (!last_batch_trigger_next_ || payload.batch_info.last_batch)) {
             waitAndStartNextStage(payload, *next_stage_socket_);
         }
 
@@ -43,6 +44,7 @@ MacroGroupPipelineLastStage::MacroGroupPipelineLastStage(const sc_module_name& n
                                                          int latency_cycle)
     : MacroGroupPipelineStage(name, base_info, latency_cycle) {
     SC_THREAD(processExecute)
+    setThreadStackSize();
 }
 
 [[noreturn]] void MacroGroupPipelineLastStage::processExecute() {
@@ -52,7 +54,7 @@ MacroGroupPipelineLastStage::MacroGroupPipelineLastStage(const sc_module_name& n
         const auto& payload = exec_socket_.payload;
         const auto& cim_ins_info = payload.sub_ins_info->cim_ins_info;
         CORE_LOG(fmt::format("{} start, ins pc: {}, sub ins num: {}, batch: {}", getFullName(), cim_ins_info.ins_pc,
-                             cim_ins_info.sub_ins_num, payload.batch_info->batch_num));
+                             cim_ins_info.sub_ins_num, payload.batch_info.batch_num));
 
         if (release_resource_func_ && payload.sub_ins_info->last_group && cim_ins_info.last_sub_ins) {
             release_resource_func_(cim_ins_info.ins_id);
@@ -61,12 +63,15 @@ MacroGroupPipelineLastStage::MacroGroupPipelineLastStage(const sc_module_name& n
         double latency = latency_cycle_ * period_ns_;
         wait(latency, SC_NS);
 
+        if (finish_group_func_ && payload.batch_info.last_batch) {
+            finish_group_func_();
+        }
         if (finish_ins_func_ && payload.sub_ins_info->last_group && cim_ins_info.last_sub_ins) {
             finish_ins_func_();
         }
 
         CORE_LOG(fmt::format("{} end, ins pc: {}, sub ins num: {}, batch: {}", getFullName(), cim_ins_info.ins_pc,
-                             cim_ins_info.sub_ins_num, payload.batch_info->batch_num));
+                             cim_ins_info.sub_ins_num, payload.batch_info.batch_num));
 
         exec_socket_.finish();
     }
@@ -122,4 +127,11 @@ void MacroGroupModule::setFinishInsFunc(std::function<void()> finish_ins_func) {
     }
 }
 
+void MacroGroupModule::setFinishGroupFunc(std::function<void()> finish_group_func) {
+    if (last_module_) {
+        auto stage_ptr = std::dynamic_pointer_cast<MacroGroupPipelineLastStage>(stage_list_[stage_list_.size() - 1]);
+        stage_ptr->finish_group_func_ = std::move(finish_group_func);
+    }
+}
+
 }  // namespace cimsim
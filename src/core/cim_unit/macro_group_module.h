@@ -46,6 +46,7 @@ public:
 public:
     std::function<void(int ins_id)> release_resource_func_;
     std::function<void()> finish_ins_func_;
+    std::function<void()> finish_group_func_;
 };
 
 class MacroGroupModule : public BaseModule {
@@ -61,6 +62,7 @@ public:
 
     void setReleaseResourceFunc(std::function<void(int ins_pc)> release_resource_func);
     void setFinishInsFunc(std::function<void()> finish_ins_func);
+    void setFinishGroupFunc(std::function<void()> finish_group_func);
 
 private:
     std::vector<std::shared_ptr<MacroGroupPipelineStage>> stage_list_{};
@@ -10,63 +10,65 @@
 namespace cimsim {
 
 MacroPipelineStage::MacroPipelineStage(const sc_module_name& name, const BaseInfo& base_info,
-                                       const CimUnitConfig& config, MacroDynamicPowerFunc get_power, int latency_cycle,
+                                       const CimUnitConfig& config, const double& dynamic_power_mW,
+                                       MacroPowerUnitCountFunc get_power_unit_cnt, int latency_cycle,
                                        EnergyCounter& module_energy_counter, const std::string& module_name)
     : BaseModule(name, base_info)
     , config_(config)
-    , get_power_(get_power)
+    , dynamic_power_mW_(dynamic_power_mW)
+    , get_power_unit_cnt_(get_power_unit_cnt)
     , latency_cycle_(latency_cycle)
     , module_energy_counter_(module_energy_counter)
     , module_name_(module_name) {
-    SC_THREAD(processExecute)
+    SC_METHOD(processExecute)
+    sensitive << exec_socket_.start_exec;
+    dont_initialize();
 }
 
 void MacroPipelineStage::processExecute() {
-    while (true) {
-        exec_socket_.waitUntilStart();
-
-        const auto& payload = exec_socket_.payload;
+    const auto& payload = exec_socket_.payload;
+    auto* next_stage_socket =
+        (!last_batch_trigger_next_ || payload.batch_info.last_batch) ? next_stage_socket_ : nullptr;
+    stage_method_.step(exec_socket_, next_stage_socket, [this](const MacroSubmodulePayload& payload) {
         const auto& cim_ins_info = payload.sub_ins_info->cim_ins_info;
         CORE_LOG(fmt::format("{} start, ins pc: {}, sub ins num: {}, batch: {}", getFullName(), cim_ins_info.ins_pc,
-                             cim_ins_info.sub_ins_num, payload.batch_info->batch_num));
+                             cim_ins_info.sub_ins_num, payload.batch_info.batch_num));
 
-        double dynamic_power_mW = get_power_(config_, payload);
         double latency = latency_cycle_ * period_ns_;
-        module_energy_counter_.addDynamicEnergyPJ(std::max(latency, period_ns_), dynamic_power_mW,
+        module_energy_counter_.addDynamicEnergyPJ(std::max(latency, period_ns_), dynamic_power_mW_,
+                                                  get_power_unit_cnt_(config_, payload),
                                                   {.core_id = core_id_,
                                                    .ins_id = cim_ins_info.ins_id,
                                                    .inst_opcode = cim_ins_info.inst_opcode,
                                                    .inst_group_tag = cim_ins_info.inst_group_tag,
                                                    .inst_profiler_operator = module_name_});
-        wait(latency, SC_NS);
-
-        if (next_stage_socket_ != nullptr && (!last_batch_trigger_next_ || payload.batch_info->last_batch)) {
-            waitAndStartNextStage(payload, *next_stage_socket_);
-        }
-
-        exec_socket_.finish();
-    }
+        return latency;
+    });
 }
 
 MacroModule::MacroModule(const sc_module_name& name, const BaseInfo& base_info, const CimUnitConfig& config,
-                         MacroDynamicPowerFunc get_power, int latency_cycle, int pipeline_stage_cnt)
+                         const double& dynamic_power_mW, MacroPowerUnitCountFunc get_power_unit_cnt,
+                         int latency_cycle, int pipeline_stage_cnt)
     : BaseModule(name, base_info), module_energy_counter_(pipeline_stage_cnt > 1) {
     int pipeline_stage_latency_cycle = latency_cycle / pipeline_stage_cnt;
-    stage_list_.emplace_back(std::make_shared<MacroPipelineStage>(
-        "pipeline_0", base_info, config, get_power, pipeline_stage_latency_cycle, module_energy_counter_, getName()));
+    stage_list_.emplace_back(std::make_shared<MacroPipelineStage>("pipeline_0", base_info, config, dynamic_power_mW,
+                                                                  get_power_unit_cnt, pipeline_stage_latency_cycle,
+                                                                  module_energy_counter_, getName()));
 
     for (int i = 1; i < pipeline_stage_cnt; i++) {
-        auto stage_ptr =
-            std::make_shared<MacroPipelineStage>(fmt::format("pipeline_{}", i).c_str(), base_info, config, get_power,
-                                                 pipeline_stage_latency_cycle, module_energy_counter_, getName());
+        auto stage_ptr = std::make_shared<MacroPipelineStage>(
+            fmt::format("pipeline_{}", i).c_str(), base_info, config, dynamic_power_mW, get_power_unit_cnt,
+            pipeline_stage_latency_cycle, module_energy_counter_, getName());
         stage_list_[i - 1]->next_stage_socket_ = &(stage_ptr->exec_socket_);
         stage_list_.emplace_back(stage_ptr);
     }
+    module_energy_counter_.addDynamicPowerParam(dynamic_power_mW);
 }
 
 MacroModule::MacroModule(const sc_module_name& name, const BaseInfo& base_info, const CimUnitConfig& config,
-                         const CimModuleConfig& module_config, MacroDynamicPowerFunc get_power)
-    : MacroModule(name, base_info, config, get_power, module_config.latency_cycle, module_config.pipeline_stage_cnt) {}
+                         const CimModuleConfig& module_config, MacroPowerUnitCountFunc get_power_unit_cnt)
+    : MacroModule(name, base_info, config, module_config.dynamic_power_mW, get_power_unit_cnt,
+                  module_config.latency_cycle, module_config.pipeline_stage_cnt) {}
 
 MacroStageSocket* MacroModule::getExecuteSocket() const {
     return &(stage_list_[0]->exec_socket_);
@@ -10,7 +10,8 @@
 
 namespace cimsim {
 
-using MacroDynamicPowerFunc = double (*)(const CimUnitConfig& config, const MacroSubmodulePayload& payload);
+// dynamic power of a macro module is its power param * unit count of payload
+using MacroPowerUnitCountFunc = double (*)(const CimUnitConfig& config, const MacroSubmodulePayload& payload);
 using MacroStageSocket = SubmoduleSocket<MacroSubmodulePayload>;
 
 class MacroPipelineStage : public BaseModule {
@@ -18,10 +19,10 @@ public:
     SC_HAS_PROCESS(MacroPipelineStage);
 
     MacroPipelineStage(const sc_module_name& name, const BaseInfo& base_info, const CimUnitConfig& config,
-                       MacroDynamicPowerFunc get_power, int latency_cycle, EnergyCounter& module_energy_counter,
-                       const std::string& module_name);
+                       const double& dynamic_power_mW, MacroPowerUnitCountFunc get_power_unit_cnt, int latency_cycle,
+                       EnergyCounter& module_energy_counter, const std::string& module_name);
 
-    [[noreturn]] void processExecute();
+    void processExecute();
 
 public:
     MacroStageSocket exec_socket_;
@@ -31,20 +32,24 @@ public:
 private:
     const CimUnitConfig& config_;
 
-    MacroDynamicPowerFunc get_power_;
+    const double& dynamic_power_mW_;
+    MacroPowerUnitCountFunc get_power_unit_cnt_;
     int latency_cycle_;
 
     EnergyCounter& module_energy_counter_;
     const std::string& module_name_;
+
+    SubmoduleStageMethod<MacroSubmodulePayload> stage_method_;
 };
 
 class MacroModule : public BaseModule {
 public:
     MacroModule(const sc_module_name& name, const BaseInfo& base_info, const CimUnitConfig& config,
-                MacroDynamicPowerFunc get_power, int latency_cycle, int pipeline_stage_cnt);
+                const double& dynamic_power_mW, MacroPowerUnitCountFunc get_power_unit_cnt, int latency_cycle,
+                int pipeline_stage_cnt);
 
     MacroModule(const sc_module_name& name, const BaseInfo& base_info, const CimUnitConfig& config,
-                const CimModuleConfig& module_config, MacroDynamicPowerFunc get_power);
+                const CimModuleConfig& module_config, MacroPowerUnitCountFunc get_power_unit_cnt);
 
     MacroStageSocket* getExecuteSocket() const;
     void bindNextStageSocket(MacroStageSocket* next_stage_socket, bool last_batch_trigger);
@@ -4,11 +4,170 @@
 
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
+#include "isa/isa_v2.h"
+#include "util/bit_kernel.h"
+#include "util/util.h"
+
 namespace cimsim {
 
+struct CimInputBuffer {
+    /* Inputs of one macro group in their native bit width, shared by all macros in the group and never modified
+     * once created. In value sparse mode, macro i uses the elements indexed by
+     * sparse_index_list[sparse_offset_list[i], sparse_offset_list[i + 1]), otherwise all macros use all elements.
+     */
+    std::vector<unsigned char> data{};
+    int bit_width{0};
+    int element_cnt{0};
+
+    bool value_sparse{false};
+    std::vector<int> sparse_index_list{};
+    std::vector<int> sparse_offset_list{};
+
+    [[nodiscard]] unsigned long long getElement(int index) const {
+        if (bit_width == BYTE_TO_BIT) {
+            return data[index];
+        }
+        return getBitField(data, static_cast<long long>(index) * bit_width, bit_width);
+    }
+};
+
+class MacroInputs {
+    // view of the inputs of one macro in a shared CimInputBuffer, copying it does not copy inputs
+public:
+    MacroInputs() = default;
+    MacroInputs(std::shared_ptr<const CimInputBuffer> buffer, int macro_id) : buffer_(std::move(buffer)) {
+        if (buffer_ == nullptr) {
+            return;
+        }
+        if (buffer_->value_sparse) {
+            int begin = buffer_->sparse_offset_list[macro_id];
+            index_list_ = buffer_->sparse_index_list.data() + begin;
+            size_ = buffer_->sparse_offset_list[macro_id + 1] - begin;
+        } else {
+            size_ = buffer_->element_cnt;
+        }
+    }
+
+    [[nodiscard]] int size() const {
+        return size_;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return size_ == 0;
+    }
+
+    unsigned long long operator[](int index) const {
+        return buffer_->getElement(index_list_ == nullptr ? index : index_list_[index]);
+    }
+
+    // or of the first cnt inputs, each set bit is a non-zero input bit plane
+    [[nodiscard]] unsigned long long getBitPlanes(int cnt) const {
+        if (buffer_ == nullptr || cnt <= 0) {
+            return 0;
+        }
+        cnt = std::min(cnt, size_);
+        if (index_list_ == nullptr && buffer_->bit_width == BYTE_TO_BIT) {
+            return orReduceBytes(buffer_->data.data(), cnt);
+        }
+        unsigned long long bit_planes = 0;
+        for (int i = 0; i < cnt; i++) {
+            bit_planes |= (*this)[i];
+        }
+        return bit_planes;
+    }
+
+    [[nodiscard]] std::vector<unsigned long long> toVector() const {
+        std::vector<unsigned long long> values(size_);
+        for (int i = 0; i < size_; i++) {
+            values[i] = (*this)[i];
+        }
+        return values;
+    }
+
+private:
+    std::shared_ptr<const CimInputBuffer> buffer_{};
+    const int* index_list_{nullptr};
+    int size_{0};
+};
+
+struct MacroGroupInputs {
+    std::shared_ptr<const CimInputBuffer> buffer{};
+    int macro_cnt{0};
+
+    // inputs are stored in order of activated macros, which have at least one activated element column, so the
+    // index is the rank of the macro among activated macros rather than its macro id, see getActivationIndexList
+    [[nodiscard]] MacroInputs getMacroInputs(int activation_index) const {
+        if (activation_index < 0 || activation_index >= macro_cnt) {
+            return {};
+        }
+        return {buffer, activation_index};
+    }
+
+    // activation index of each macro in a group, -1 for macros without activated element columns. An empty mask
+    // activates all macros.
+    static std::vector<int> getActivationIndexList(const std::vector<unsigned char>& activation_element_col_mask,
+                                                   int macro_cnt, int element_col_cnt_per_macro) {
+        std::vector<int> activation_index_list(macro_cnt, -1);
+        int activation_index = 0;
+        for (int macro_id = 0; macro_id < macro_cnt; macro_id++) {
+            if (activation_element_col_mask.empty() ||
+                countMaskBits(activation_element_col_mask, macro_id * element_col_cnt_per_macro,
+                              element_col_cnt_per_macro) > 0) {
+                activation_index_list[macro_id] = activation_index++;
+            }
+        }
+        return activation_index_list;
+    }
+
+    // inputs read from memory, in value sparse mode macro i takes at most compartment_cnt inputs selected by mask bits
+    // [i * input_len, (i + 1) * input_len) of value_sparse_mask
+    static MacroGroupInputs fromReadData(std::vector<unsigned char> read_data, int bit_width, int input_len,
+                                         int macro_cnt, int compartment_cnt,
+                                         const std::vector<unsigned char>* value_sparse_mask = nullptr) {
+        auto buffer = std::make_shared<CimInputBuffer>();
+        buffer->element_cnt = static_cast<int>(read_data.size() * BYTE_TO_BIT / bit_width);
+        buffer->bit_width = bit_width;
+        buffer->data = std::move(read_data);
+
+        if (value_sparse_mask != nullptr) {
+            int input_cnt = std::min(input_len, buffer->element_cnt);
+            buffer->value_sparse = true;
+            buffer->sparse_index_list.reserve(macro_cnt * compartment_cnt);
+            buffer->sparse_offset_list.reserve(macro_cnt + 1);
+            buffer->sparse_offset_list.push_back(0);
+            for (int macro_id = 0; macro_id < macro_cnt; macro_id++) {
+                compressIndexByMask(input_cnt, *value_sparse_mask, macro_id * input_len, compartment_cnt,
+                                    buffer->sparse_index_list);
+                buffer->sparse_offset_list.push_back(static_cast<int>(buffer->sparse_index_list.size()));
+            }
+        }
+
+        return {.buffer = std::move(buffer), .macro_cnt = macro_cnt};
+    }
+
+    // inputs given value by value, each macro has its own values, only used in tests
+    static MacroGroupInputs fromValues(const std::vector<std::vector<unsigned long long>>& macro_values) {
+        auto buffer = std::make_shared<CimInputBuffer>();
+        buffer->bit_width = 64;
+        buffer->value_sparse = true;
+        buffer->sparse_offset_list.push_back(0);
+        for (const auto& values : macro_values) {
+            for (auto value : values) {
+                buffer->data.resize(buffer->data.size() + sizeof(value));
+                setBitField(buffer->data, static_cast<long long>(buffer->element_cnt) * buffer->bit_width,
+                            buffer->bit_width, value);
+                buffer->sparse_index_list.push_back(buffer->element_cnt++);
+            }
+            buffer->sparse_offset_list.push_back(buffer->element_cnt);
+        }
+        return {.buffer = std::move(buffer), .macro_cnt = static_cast<int>(macro_values.size())};
+    }
+};
+
 struct CimInsInfo {
     int ins_pc{-1}, sub_ins_num{-1};
     bool last_sub_ins{false};
@@ -25,10 +184,11 @@ struct MacroPayload {
     int input_bit_width{0};
     bool bit_sparse{false};
 
-    std::vector<unsigned long long> inputs{};
+    MacroInputs inputs{};
 
     int simulated_group_cnt{1};
     int simulated_macro_cnt{1};
+    int class_macro_cnt{1};  // count of macros in the same equivalence class simulated by this macro
 };
 
 struct MacroSubInsInfo {
@@ -48,7 +208,7 @@ struct MacroBatchInfo {
 
 struct MacroSubmodulePayload {
     std::shared_ptr<MacroSubInsInfo> sub_ins_info;
-    std::shared_ptr<MacroBatchInfo> batch_info;
+    MacroBatchInfo batch_info{};
 };
 
 struct MacroGroupPayload {
@@ -63,7 +223,7 @@ struct MacroGroupPayload {
     bool bit_sparse{false};
 
     // inputs
-    std::vector<std::vector<unsigned long long>> macro_inputs{};
+    MacroGroupInputs macro_inputs{};
 
     // control
     int simulated_group_cnt{1};
@@ -94,7 +254,7 @@ struct MacroGroupSubInsInfo {
 
 struct MacroGroupSubmodulePayload {
     std::shared_ptr<MacroGroupSubInsInfo> sub_ins_info{};
-    std::shared_ptr<MacroBatchInfo> batch_info{};
+    MacroBatchInfo batch_info{};
 };
 
 }  // namespace cimsim
@@ -18,16 +18,17 @@ Core::ExecuteUnitInfo::ExecuteUnitInfo(ExecuteUnitType type, ExecuteUnit *execut
     , conflict_signal(fmt::format("{}_conflict_signal", type._to_string()).c_str()) {}
 
 Core::Core(const sc_module_name &name, const CoreConfig &config, const BaseInfo &base_info, Clock *clk, int global_id,
-           std::vector<Instruction> ins_list, std::function<void()> finish_run_call)
+           int core_cnt, std::vector<Instruction> ins_list, std::function<void()> finish_run_call)
     : BaseModule(name, base_info)
     , core_config_(config)
+    , sim_config_(base_info.sim_config)
     , ins_list_(std::move(ins_list))
 
     , cim_unit_("CimUnit", core_config_.cim_unit_config, base_info)
     , local_memory_unit_("LocalMemoryUnit", core_config_.local_memory_unit_config, base_info, false)
     , reg_unit_("RegUnit", core_config_.register_unit_config, base_info)
     , core_switch_("Switch", base_info)
-    , decoder_("Decoder", config, base_info)
+    , decoder_("Decoder", config, base_info, core_cnt)
 
     , scalar_unit_("ScalarUnit", core_config_.scalar_unit_config, base_info, clk)
     , simd_unit_("SIMDUnit", core_config_.simd_unit_config, base_info, clk)
@@ -71,16 +72,126 @@ int Core::getCoreId() const {
     return core_id_;
 }
 
+long long Core::getDecodedInsCount() const {
+    return decoded_ins_cnt_;
+}
+
+const LoopExtrapolationStat &Core::getLoopExtrapolationStat() const {
+    return loop_extrapolation_stat_;
+}
+
+void Core::loadArchState(const CoreArchState &state) {
+    ins_index_ = state.ins_index;
+    for (int i = 0; i < GENERAL_REG_NUM; i++) {
+        reg_unit_.writeRegister({.id = i, .value = state.general_regs[i], .special = false});
+    }
+    for (int i = 0; i < SPECIAL_REG_NUM; i++) {
+        if (reg_unit_.getSpecialBoundGeneralId(i) == -1) {
+            reg_unit_.writeRegister({.id = i, .value = state.special_regs[i], .special = true});
+        }
+    }
+
+    for (int group_id = 0; group_id < state.group_activation_mask_list.size(); group_id++) {
+        if (!state.group_activation_mask_list[group_id].empty()) {
+            cim_unit_.setMacroGroupActivationElementColumn(state.group_activation_mask_list[group_id], false,
+                                                           group_id);
+        }
+    }
+    for (int group_id = 0; group_id < state.group_result_list.size(); group_id++) {
+        cim_unit_.setMacroGroupResult(group_id, state.group_result_list[group_id]);
+    }
+
+    local_memory_unit_.setMemoryDataList(state.memory_data_list);
+}
+
+void Core::saveArchState(CoreArchState &state) const {
+    state.ins_index = ins_index_;
+    for (int i = 0; i < GENERAL_REG_NUM; i++) {
+        state.general_regs[i] = reg_unit_.readRegister(i, false);
+    }
+    for (int i = 0; i < SPECIAL_REG_NUM; i++) {
+        state.special_regs[i] = reg_unit_.readRegister(i, true);
+    }
+
+    int group_cnt = cim_unit_.getConfigMacroGroupCount();
+    state.group_activation_mask_list.resize(group_cnt);
+    state.group_result_list.resize(group_cnt);
+    for (int group_id = 0; group_id < group_cnt; group_id++) {
+        state.group_activation_mask_list[group_id] = cim_unit_.getMacroGroupActivationElementColumnMask(group_id);
+        state.group_result_list[group_id] = cim_unit_.getMacroGroupResult(group_id);
+    }
+
+    state.memory_data_list = local_memory_unit_.getMemoryDataList();
+}
+
+void Core::setRegionEndTrigger(const RegionTriggerConfig *trigger) {
+    region_end_trigger_ = trigger;
+}
+
+void Core::setPauseTrigger(std::function<bool(long long)> pause_trigger, std::function<void()> pause_call) {
+    pause_trigger_ = std::move(pause_trigger);
+    pause_call_ = std::move(pause_call);
+}
+
+void Core::resume(const sc_time &delay) {
+    // at least delta notification, the last paused core calls resume inside its pause_call, before it waits for
+    // resume_event_, so an immediate notification would be lost and that core would never resume
+    resume_event_.notify(delay);
+}
+
+int Core::getPendingTransferCount() const {
+    return transfer_unit_.getPendingTransferCount();
+}
+
+void Core::setLayerFinishCall(std::function<void()> layer_finish_call) {
+    layer_finish_call_ = std::move(layer_finish_call);
+}
+
+void Core::loadLayer(std::vector<Instruction> ins_list, bool last_layer) {
+    ins_list_ = std::move(ins_list);
+    ins_index_ = 0;
+    decoded_ins_cnt_ = 0;
+    loop_state_ = LoopState{};
+    if (last_layer) {
+        layer_finish_call_ = nullptr;
+    }
+    resume();
+}
+
+sc_time Core::getLayerFinishTime() const {
+    sc_time finish_time = layer_decode_finish_time_;
+    for (const auto &exe_unit_info : execute_unit_list_) {
+        finish_time = std::max(finish_time, exe_unit_info->execute_unit->getLastFinishTime());
+    }
+    return finish_time;
+}
+
+void Core::resetTiming(const sc_time &start_time) {
+    local_memory_unit_.resetTiming(start_time);
+    transfer_unit_.resetTiming();
+}
+
 [[noreturn]] void Core::processDecode() {
     wait(period_ns_ - 1, SC_NS);
 
     std::shared_ptr<ExecuteInsPayload> payload{nullptr};
     while (true) {
         if (cur_ins_conflict_info_.unit_type == +ExecuteUnitType::none) {
-            if (ins_index_ < ins_list_.size()) {
+            if (pause_trigger_ && ins_index_ < ins_list_.size() && pause_trigger_(decoded_ins_cnt_)) {
+                pauseAndWaitResume();
+            }
+            if (ins_index_ < ins_list_.size() &&
+                (region_end_trigger_ == nullptr ||
+                 !region_end_trigger_->match(ins_index_, ins_list_[ins_index_].inst_group_tag, decoded_ins_cnt_))) {
                 cur_ins_payload_ =
                     decoder_.decode(ins_list_[ins_index_], ins_index_ + 1, pc_increment_, cur_ins_conflict_info_);
+                decoded_ins_cnt_++;
+                if (sim_config_.loop_extrapolation) {
+                    trackLoopIteration();
+                }
                 decode_new_ins_trigger_.notify();
+            } else if (layer_finish_call_) {
+                finishLayerAndWaitNext();
             } else {
                 pc_increment_ = 0;
                 id_finish_.write(true);
@@ -90,6 +201,37 @@ int Core::getCoreId() const {
     }
 }
 
+void Core::waitExecuteUnitsIdle() {
+    // instructions issued in the last cycles reach their execute units before draining is checked
+    wait(2 * period_ns_, SC_NS);
+    while (!std::all_of(execute_unit_list_.begin(), execute_unit_list_.end(),
+                        [](const std::shared_ptr<ExecuteUnitInfo> &exe_unit_info) {
+                            return exe_unit_info->execute_unit->isIdle();
+                        })) {
+        wait(period_ns_, SC_NS);
+    }
+}
+
+void Core::pauseAndWaitResume() {
+    pause_trigger_ = nullptr;
+    pc_increment_ = 0;
+    waitExecuteUnitsIdle();
+
+    CORE_LOG(fmt::format("pause at ins index {}", ins_index_));
+    pause_call_();
+    wait(resume_event_);
+}
+
+void Core::finishLayerAndWaitNext() {
+    pc_increment_ = 0;
+    layer_decode_finish_time_ = sc_time_stamp();
+    waitExecuteUnitsIdle();
+
+    CORE_LOG(fmt::format("finish layer"));
+    layer_finish_call_();
+    wait(resume_event_);
+}
+
 [[noreturn]] void Core::processUpdatePC() {
     while (true) {
         if (!id_stall_.read()) {
@@ -157,6 +299,161 @@ void Core::bindExecuteUnit(ExecuteUnitType type, ExecuteUnit *execute_unit) {
     // bind decoder
     decoder_.bindExecuteUnit(type, execute_unit);
 }
+void Core::trackLoopIteration() {
+    auto &loop = loop_state_;
+    if (cur_ins_payload_ != nullptr && cur_ins_payload_->ins.unit_type == +ExecuteUnitType::transfer &&
+        castInsPayload<TransferInsPayload>(cur_ins_payload_)->type != +TransferType::local_trans) {
+        loop.iteration_local = false;
+    }
+    if (pc_increment_ >= 0) {
+        return;
+    }
+
+    // a taken backward branch ends one iteration of loop [ins_index_ + pc_increment_, ins_index_]
+    int back_edge_index = ins_index_;
+    int start_index = ins_index_ + pc_increment_;
+    auto now = sc_time_stamp();
+    auto energy = energy_counter_.getDynamicEnergyList();
+    if (loop.back_edge_index != back_edge_index) {
+        loop = LoopState{.back_edge_index = back_edge_index,
+                         .extrapolatable = isLoopBodyExtrapolatable(start_index, back_edge_index),
+                         .iteration_start_time = now,
+                         .iteration_start_energy = std::move(energy)};
+        return;
+    }
+
+    std::vector<double> iteration_energy(energy.size());
+    for (int i = 0; i < energy.size(); i++) {
+        iteration_energy[i] = energy[i] - loop.iteration_start_energy[i];
+    }
+    auto iteration_latency = now - loop.iteration_start_time;
+    bool same = loop.iteration_local && iteration_latency == loop.iteration_latency &&
+                std::equal(iteration_energy.begin(), iteration_energy.end(), loop.iteration_energy.begin(),
+                           loop.iteration_energy.end(), [](double a, double b) {
+                               return std::abs(a - b) <= 1e-9 * std::max(std::abs(a), std::abs(b)) + delta;
+                           });
+    loop.steady_iteration_cnt = same ? loop.steady_iteration_cnt + 1 : 1;
+    loop.iteration_latency = iteration_latency;
+    loop.iteration_energy = std::move(iteration_energy);
+    loop.iteration_start_time = now;
+    loop.iteration_start_energy = std::move(energy);
+    loop.iteration_local = true;
+
+    if (loop.extrapolatable && loop.steady_iteration_cnt >= sim_config_.loop_steady_iteration_cnt) {
+        extrapolateLoop(start_index, back_edge_index);
+    }
+}
+
+bool Core::isLoopBodyExtrapolatable(int start_index, int back_edge_index) const {
+    // registers are advanced without memory data, and other cores are not synchronized with skipped iterations
+    if (ins_list_[back_edge_index].getOpcodeEnum() == +OPCODE::JMP) {
+        return false;
+    }
+    return std::none_of(ins_list_.begin() + start_index, ins_list_.begin() + back_edge_index, [](const InstV2 &ins) {
+        auto op = ins.getOpcodeEnum();
+        return ins.getOpcodeClass() == +OPCODE_CLASS::CONTROL || op == +OPCODE::SC_LD || op == +OPCODE::SC_LDG ||
+               op == +OPCODE::SEND || op == +OPCODE::SEND_MC || op == +OPCODE::RECV;
+    });
+}
+
+void Core::extrapolateLoop(int start_index, int back_edge_index) {
+    auto &loop = loop_state_;
+
+    // hold pc at the back edge, scalar instructions of the last iteration finish within one steady iteration
+    pc_increment_ = 0;
+    wait(loop.iteration_latency);
+
+    std::array<int, GENERAL_REG_NUM> general_regs{};
+    std::array<int, SPECIAL_REG_NUM> special_regs{};
+    for (int i = 0; i < GENERAL_REG_NUM; i++) {
+        general_regs[i] = reg_unit_.readRegister(i, false);
+    }
+    for (int i = 0; i < SPECIAL_REG_NUM; i++) {
+        special_regs[i] = reg_unit_.readRegister(i, true);
+    }
+    int iteration_cnt = advanceLoopRegisters(start_index, back_edge_index, general_regs, special_regs);
+    if (iteration_cnt == 0) {
+        // loop does not exit, go on simulating, the waited iteration is counted as error
+        ins_index_ = start_index;
+        loop_extrapolation_stat_.error_bound_ns += loop.iteration_latency.to_seconds() * 1e9;
+        loop = LoopState{};
+        return;
+    }
+
+    if (iteration_cnt > 1) {
+        wait(loop.iteration_latency * (iteration_cnt - 1));
+    }
+    for (int i = 0; i < GENERAL_REG_NUM; i++) {
+        reg_unit_.writeRegister({.id = i, .value = general_regs[i], .special = false});
+    }
+    for (int i = 0; i < SPECIAL_REG_NUM; i++) {
+        if (reg_unit_.getSpecialBoundGeneralId(i) == -1) {
+            reg_unit_.writeRegister({.id = i, .value = special_regs[i], .special = true});
+        }
+    }
+    energy_counter_.addDynamicEnergyList(loop.iteration_energy, iteration_cnt);
+    ins_index_ = back_edge_index + 1;
+
+    double iteration_latency_ns = loop.iteration_latency.to_seconds() * 1e9;
+    loop_extrapolation_stat_.loop_cnt++;
+    loop_extrapolation_stat_.iteration_cnt += iteration_cnt;
+    loop_extrapolation_stat_.ins_cnt += static_cast<long long>(iteration_cnt) * (back_edge_index - start_index + 1);
+    loop_extrapolation_stat_.latency_ns += iteration_latency_ns * iteration_cnt;
+    loop_extrapolation_stat_.error_bound_ns += iteration_latency_ns;
+    CORE_LOG(fmt::format("extrapolate loop [{}, {}] for {} iterations", start_index, back_edge_index, iteration_cnt));
+    loop = LoopState{};
+}
+
+int Core::advanceLoopRegisters(int start_index, int back_edge_index, std::array<int, GENERAL_REG_NUM> &general_regs,
+                               std::array<int, SPECIAL_REG_NUM> &special_regs) const {
+    constexpr int max_iteration_cnt = 1 << 24;
+
+    auto reg = [&](int id, bool special) -> int & {
+        if (!special) {
+            return general_regs[id];
+        }
+        int bound_id = reg_unit_.getSpecialBoundGeneralId(id);
+        return bound_id == -1 ? special_regs[id] : general_regs[bound_id];
+    };
+
+    const auto &back_edge = ins_list_[back_edge_index];
+    for (int iteration_cnt = 1; iteration_cnt <= max_iteration_cnt; iteration_cnt++) {
+        for (int index = start_index; index < back_edge_index; index++) {
+            const auto &ins = ins_list_[index];
+            switch (ins.getOpcodeEnum()) {
+                case OPCODE::SC_RR:
+                    reg(ins.rd, false) = ScalarUnit::calculate(ScalarOperator::_from_integral(ins.funct),
+                                                               reg(ins.rs, false), reg(ins.rt, false));
+                    break;
+                case OPCODE::SC_RI:
+                    reg(ins.rd, false) =
+                        ScalarUnit::calculate(ScalarOperator::_from_integral(ins.funct), reg(ins.rs, false), ins.imm);
+                    break;
+                case OPCODE::G_LI: reg(ins.rd, false) = ins.imm; break;
+                case OPCODE::S_LI: reg(ins.rd, true) = ins.imm; break;
+                case OPCODE::GS_MOV: reg(ins.rd, true) = reg(ins.rs, false); break;
+                case OPCODE::SG_MOV: reg(ins.rd, false) = reg(ins.rs, true); break;
+                default: break;
+            }
+        }
+
+        int src_value1 = reg(back_edge.rs, false);
+        int src_value2 = reg(back_edge.rt, false);
+        bool branch = false;
+        switch (back_edge.getOpcodeEnum()) {
+            case OPCODE::BEQ: branch = (src_value1 == src_value2); break;
+            case OPCODE::BNE: branch = (src_value1 != src_value2); break;
+            case OPCODE::BGT: branch = (src_value1 > src_value2); break;
+            case OPCODE::BLT: branch = (src_value1 < src_value2); break;
+            default: break;
+        }
+        if (!branch) {
+            return iteration_cnt;
+        }
+    }
+    return 0;
+}
+
 void Core::bindModules() {
     // bind execute unit
     bindExecuteUnit(ExecuteUnitType::scalar, &scalar_unit_);
@@ -180,7 +477,9 @@ void Core::bindModules() {
 
 void Core::setThreadAndMethod() {
     SC_THREAD(processDecode)
+    setThreadStackSize();
     SC_THREAD(processUpdatePC)
+    setThreadStackSize();
 
     SC_METHOD(processIssue)
     sensitive << decode_new_ins_trigger_ << id_stall_;
@@ -6,6 +6,7 @@
 #include <iostream>
 #include <vector>
 
+#include "arch_state.h"
 #include "base_component/base_module.h"
 #include "conflict/conflict_handler.h"
 #include "core/cim_unit/cim_unit.h"
@@ -27,12 +28,21 @@ namespace cimsim {
 using DecoderImpl = DecoderV2;
 using Instruction = DecoderImpl::Instruction;
 
+struct LoopExtrapolationStat {
+    int loop_cnt{0};
+    long long iteration_cnt{0};
+    long long ins_cnt{0};
+    double latency_ns{0.0};
+    // pipeline overlap at the boundary of extrapolated iterations is not simulated, at most one iteration latency
+    double error_bound_ns{0.0};
+};
+
 class Core : public BaseModule {
 public:
     SC_HAS_PROCESS(Core);
 
     Core(const sc_module_name& name, const CoreConfig& config, const BaseInfo& base_info, Clock* clk, int global_id,
-         std::vector<Instruction> ins_list, std::function<void()> finish_run_call);
+         int core_cnt, std::vector<Instruction> ins_list, std::function<void()> finish_run_call);
     void bindNetwork(Network* network);
 
     EnergyReporter getEnergyReporter() const;
@@ -42,7 +52,30 @@ public:
 
     bool checkInsStat(const std::string& expected_ins_stat_file) const;
 
+    // architectural state, loaded before simulation starts and saved after it finishes
+    void loadArchState(const CoreArchState& state);
+    void saveArchState(CoreArchState& state) const;
+    // stop decoding at the first instruction matching trigger, as if the program ends there
+    void setRegionEndTrigger(const RegionTriggerConfig* trigger);
+
+    // before decoding, pause once pause_trigger(decoded ins count) returns true, call pause_call after execute units
+    // drain, then wait until resume is called. A paused core decodes again right when it resumes after delay
+    void setPauseTrigger(std::function<bool(long long)> pause_trigger, std::function<void()> pause_call);
+    void resume(const sc_time& delay = SC_ZERO_TIME);
+    [[nodiscard]] int getPendingTransferCount() const;
+
+    // batch mode, at the end of instructions call layer_finish_call after execute units drain instead of finishing,
+    // then wait until loadLayer gives instructions of the next layer. The last layer finishes as usual.
+    void setLayerFinishCall(std::function<void()> layer_finish_call);
+    void loadLayer(std::vector<Instruction> ins_list, bool last_layer);
+    // when the last instruction of the finished layer completed, not counting the drain check
+    [[nodiscard]] sc_time getLayerFinishTime() const;
+    // restart timing of local memories and transfer unit as if simulation started at start_time
+    void resetTiming(const sc_time& start_time);
+
     [[nodiscard]] int getCoreId() const;
+    [[nodiscard]] long long getDecodedInsCount() const;
+    [[nodiscard]] const LoopExtrapolationStat& getLoopExtrapolationStat() const;
 
 private:
     struct ExecuteUnitInfo {
@@ -57,6 +90,9 @@ private:
 
 private:
     [[noreturn]] void processDecode();
+    void waitExecuteUnitsIdle();
+    void pauseAndWaitResume();
+    void finishLayerAndWaitNext();
     [[noreturn]] void processUpdatePC();
     void processIssue();
 
@@ -66,15 +102,41 @@ private:
 
     void bindExecuteUnit(ExecuteUnitType type, ExecuteUnit* execute_unit);
 
+    // loop extrapolation, called in processDecode after each instruction is decoded
+    void trackLoopIteration();
+    [[nodiscard]] bool isLoopBodyExtrapolatable(int start_index, int back_edge_index) const;
+    void extrapolateLoop(int start_index, int back_edge_index);
+    // run scalar instructions of loop body on registers until the loop exits, return count of iterations, 0 if the
+    // loop does not exit within limit
+    int advanceLoopRegisters(int start_index, int back_edge_index, std::array<int, GENERAL_REG_NUM>& general_regs,
+                             std::array<int, SPECIAL_REG_NUM>& special_regs) const;
+
     void bindModules();
     void setThreadAndMethod();
 
+private:
+    struct LoopState {
+        int back_edge_index{-1};
+        bool extrapolatable{false};
+        bool iteration_local{true};  // no global memory or inter-core transfer in current iteration
+
+        sc_time iteration_start_time{};
+        std::vector<double> iteration_start_energy{};
+
+        sc_time iteration_latency{};
+        std::vector<double> iteration_energy{};
+        int steady_iteration_cnt{0};
+    };
+
 private:
     const CoreConfig& core_config_;
+    const SimConfig& sim_config_;
 
     // instruction
     std::vector<Instruction> ins_list_;
     int ins_index_{0};
+    long long decoded_ins_cnt_{0};
+    const RegionTriggerConfig* region_end_trigger_{nullptr};
 
     // modules
     CimUnit cim_unit_;
@@ -106,6 +168,19 @@ private:
 
     // finish run
     std::function<void()> finish_run_call_;
+
+    // pause, for checkpoint
+    std::function<bool(long long)> pause_trigger_{};
+    std::function<void()> pause_call_{};
+    sc_event resume_event_;
+
+    // batch mode
+    std::function<void()> layer_finish_call_{};
+    sc_time layer_decode_finish_time_{};
+
+    // loop extrapolation
+    LoopState loop_state_{};
+    LoopExtrapolationStat loop_extrapolation_stat_{};
 };
 
 }  // namespace cimsim
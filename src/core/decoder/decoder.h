@@ -3,11 +3,15 @@
 //
 
 #pragma once
+#include <stdexcept>
+
 #include "address_space/address_space.h"
 #include "base_component/base_module.h"
 #include "core/execute_unit/execute_unit.h"
 #include "core/reg_unit/reg_unit.h"
+#include "core/execute_unit/ins_payload_pool.h"
 #include "data_path_manager.h"
+#include "fmt/format.h"
 #include "isa/inst_v1.h"
 #include "isa/inst_v2.h"
 #include "isa/inst_v3.h"
@@ -20,9 +24,10 @@ class Decoder : public BaseModule {
 public:
     using Instruction = Inst;
 
-    Decoder(const sc_module_name& name, const CoreConfig& core_config, const BaseInfo& base_info)
+    Decoder(const sc_module_name& name, const CoreConfig& core_config, const BaseInfo& base_info, int core_cnt)
         : BaseModule(name, base_info)
         , as_(AddressSapce::getInstance())
+        , core_cnt_(core_cnt)
         , simd_unit_config_(core_config.simd_unit_config)
         , reduce_unit_config_(core_config.reduce_unit_config)
         , data_path_manager_(core_config.transfer_unit_config.local_dedicated_data_path_list) {
@@ -92,6 +97,20 @@ protected:
         return nullptr;
     }
 
+    // multicast destinations are dst_cnt cores from dst_id on, which must all be cores of the chip
+    void checkMulticastDstRange(int dst_id, int dst_cnt) const {
+        if (dst_cnt <= 0 || dst_id < 0 || dst_id + dst_cnt > core_cnt_) {
+            throw std::runtime_error{fmt::format("Core {}: invalid multicast destination range, first dst id: {}, "
+                                                 "dst cnt: {}, core cnt: {}",
+                                                 core_id_, dst_id, dst_cnt, core_cnt_)};
+        }
+    }
+
+    // payload without operands, for control instructions and instructions not executed by any unit
+    std::shared_ptr<ExecuteInsPayload> createInsPayload(ExecuteUnitType unit_type) const {
+        return ins_payload_pool_.create(ExecuteInsPayload{InstructionPayload{.unit_type = unit_type}});
+    }
+
 private:
     virtual std::shared_ptr<ExecuteInsPayload> decodeCimIns(const Inst& ins) const = 0;
     virtual std::shared_ptr<ExecuteInsPayload> decodeVectorIns(const Inst& ins) const = 0;
@@ -101,6 +120,7 @@ private:
 
 protected:
     const AddressSapce& as_;
+    const int core_cnt_;
     const SIMDUnitConfig& simd_unit_config_;
     const ReduceUnitConfig& reduce_unit_config_;
     const DataPathManager data_path_manager_;
@@ -111,6 +131,9 @@ protected:
     RegUnit* reg_unit_{};
     std::unordered_map<std::string, ExecuteUnit*> execute_unit_map_;
 
+    // decode functions are const, recycling payload slots does not change decoder state
+    mutable InsPayloadPool ins_payload_pool_;
+
 private:
     std::unordered_map<unsigned int, const SIMDInstructionConfig*> simd_ins_config_map_;
     std::unordered_map<std::string, const SIMDFunctorConfig*> simd_func_config_map_;
@@ -33,7 +33,7 @@ std::shared_ptr<ExecuteInsPayload> DecoderV1::decode(const InstV1& ins, int pc,
     } else if (ins.class_code == InstClass::cim) {
         payload = decodeCimIns(ins);
     } else if (ins.class_code == InstClass::control) {
-        payload = std::make_shared<ExecuteInsPayload>(InstructionPayload{.unit_type = ExecuteUnitType::control});
+        payload = createInsPayload(ExecuteUnitType::control);
         pc_increment = decodeControlInsAndGetPCIncrement(ins);
     }
     payload->ins.pc = pc;
@@ -65,7 +65,7 @@ std::shared_ptr<ExecuteInsPayload> DecoderV1::decodeCimIns(const InstV1& ins) co
         p.value_sparse = (ins.value_sparse != 0);
         p.value_sparse_mask_addr_byte = reg_unit_->readRegister(SpecialRegId::value_sparse_mask_addr, true);
 
-        payload = std::make_shared<CimComputeInsPayload>(p);
+        payload = ins_payload_pool_.create(p);
     } else if (ins.type == CIMInstType::set) {
         CimControlInsPayload p;
         p.ins.unit_type = ExecuteUnitType::cim_control;
@@ -75,7 +75,7 @@ std::shared_ptr<ExecuteInsPayload> DecoderV1::decodeCimIns(const InstV1& ins) co
         p.group_id = reg_unit_->readRegister(ins.rs1, false);
         p.mask_addr_byte = reg_unit_->readRegister(ins.rs2, false);
 
-        payload = std::make_shared<CimControlInsPayload>(p);
+        payload = ins_payload_pool_.create(p);
     } else if (ins.type == CIMInstType::output) {
         CimControlInsPayload p;
         p.ins.unit_type = ExecuteUnitType::cim_control;
@@ -89,7 +89,7 @@ std::shared_ptr<ExecuteInsPayload> DecoderV1::decodeCimIns(const InstV1& ins) co
         p.output_bit_width = reg_unit_->readRegister(SpecialRegId::cim_output_bit_width, true);
         p.output_mask_addr_byte = reg_unit_->readRegister(ins.rs2, false);
 
-        payload = std::make_shared<CimControlInsPayload>(p);
+        payload = ins_payload_pool_.create(p);
     }
     return payload;
 }
@@ -121,12 +121,12 @@ std::shared_ptr<ExecuteInsPayload> DecoderV1::decodeVectorIns(const InstV1& ins)
     if (ins_cfg == nullptr || func_cfg == nullptr) {
         std::cerr << fmt::format("No match {}, Invalid SIMD instruction: \n{}",
                                  (ins_cfg == nullptr ? "inst" : "functor"), p.toString());
-        return std::make_shared<ExecuteInsPayload>(InstructionPayload{.unit_type = ExecuteUnitType::none});
+        return createInsPayload(ExecuteUnitType::none);
     }
     p.ins_cfg = ins_cfg;
     p.func_cfg = func_cfg;
 
-    return std::make_shared<SIMDInsPayload>(p);
+    return ins_payload_pool_.create(p);
 }
 
 std::shared_ptr<ExecuteInsPayload> DecoderV1::decodeScalarIns(const InstV1& ins) const {
@@ -169,7 +169,7 @@ std::shared_ptr<ExecuteInsPayload> DecoderV1::decodeScalarIns(const InstV1& ins)
             p.write_special_register = false;
         }
     }
-    return std::make_shared<ScalarInsPayload>(p);
+    return ins_payload_pool_.create(p);
 }
 
 std::shared_ptr<ExecuteInsPayload> DecoderV1::decodeTransferIns(const InstV1& ins) const {
@@ -204,7 +204,7 @@ std::shared_ptr<ExecuteInsPayload> DecoderV1::decodeTransferIns(const InstV1& in
         p.dst_id = core_id_;
         p.transfer_id_tag = reg_unit_->readRegister(ins.reg_id, false);
     }
-    return std::make_shared<TransferInsPayload>(p);
+    return ins_payload_pool_.create(p);
 }
 
 int DecoderV1::decodeControlInsAndGetPCIncrement(const InstV1& ins) const {
@@ -25,7 +25,7 @@ std::shared_ptr<ExecuteInsPayload> DecoderV2::decode(const InstV2& ins, int pc,
     } else if (op_class == +OPCODE_CLASS::TRANS) {
         payload = decodeTransferIns(ins);
     } else if (op_class == +OPCODE_CLASS::CONTROL) {
-        payload = std::make_shared<ExecuteInsPayload>(InstructionPayload{.unit_type = ExecuteUnitType::control});
+        payload = createInsPayload(ExecuteUnitType::control);
         pc_increment = decodeControlInsAndGetPCIncrement(ins);
     }
     payload->ins.pc = pc;
@@ -61,7 +61,7 @@ std::shared_ptr<ExecuteInsPayload> DecoderV2::decodeCimIns(const InstV2& ins) co
         p.value_sparse = ins.SP_V;
         p.value_sparse_mask_addr_byte = reg_unit_->readRegister(SpecialRegId::value_sparse_mask_addr, true);
 
-        payload = std::make_shared<CimComputeInsPayload>(p);
+        payload = ins_payload_pool_.create(p);
     } else if (op == +OPCODE::CIM_CFG) {
         CimControlInsPayload p;
         p.ins.unit_type = ExecuteUnitType::cim_control;
@@ -71,7 +71,7 @@ std::shared_ptr<ExecuteInsPayload> DecoderV2::decodeCimIns(const InstV2& ins) co
         p.group_id = reg_unit_->readRegister(ins.rs, false);
         p.mask_addr_byte = reg_unit_->readRegister(ins.rt, false);
 
-        payload = std::make_shared<CimControlInsPayload>(p);
+        payload = ins_payload_pool_.create(p);
     } else if (op == +OPCODE::CIM_OUT) {
         CimControlInsPayload p;
         p.ins.unit_type = ExecuteUnitType::cim_control;
@@ -85,7 +85,7 @@ std::shared_ptr<ExecuteInsPayload> DecoderV2::decodeCimIns(const InstV2& ins) co
         p.output_bit_width = reg_unit_->readRegister(SpecialRegId::cim_output_bit_width, true);
         p.output_mask_addr_byte = reg_unit_->readRegister(ins.rt, false);
 
-        payload = std::make_shared<CimControlInsPayload>(p);
+        payload = ins_payload_pool_.create(p);
     }
     return payload;
 }
@@ -136,7 +136,7 @@ std::shared_ptr<ExecuteInsPayload> DecoderV2::decodeScalarIns(const InstV2& ins)
         p.dst_reg = ins.rd;
         p.write_special_register = (op == +OPCODE::GS_MOV);
     }
-    return std::make_shared<ScalarInsPayload>(p);
+    return ins_payload_pool_.create(p);
 }
 
 std::shared_ptr<ExecuteInsPayload> DecoderV2::decodeTransferIns(const InstV2& ins) const {
@@ -166,6 +166,19 @@ std::shared_ptr<ExecuteInsPayload> DecoderV2::decodeTransferIns(const InstV2& in
         p.size_byte = reg_unit_->readRegister(ins.re, false);
         p.transfer_id_tag = reg_unit_->readRegister(ins.rf, false);
         p.data_path_payload = {.type = DataPathType::inter_core_bus, .local_dedicated_data_path_id = 0};
+    } else if (op == +OPCODE::SEND_MC) {
+        // rt holds destination core range: (dst_cnt << 16) | first dst_id
+        int dst_range = reg_unit_->readRegister(ins.rt, false);
+        p.type = TransferType::multicast;
+        p.src_id = core_id_;
+        p.src_address_byte = reg_unit_->readRegister(ins.rs, false);
+        p.dst_id = dst_range & 0xffff;
+        p.dst_cnt = (dst_range >> 16) & 0xffff;
+        checkMulticastDstRange(p.dst_id, p.dst_cnt);
+        p.dst_address_byte = reg_unit_->readRegister(ins.rd, false);
+        p.size_byte = reg_unit_->readRegister(ins.re, false);
+        p.transfer_id_tag = reg_unit_->readRegister(ins.rf, false);
+        p.data_path_payload = {.type = DataPathType::inter_core_bus, .local_dedicated_data_path_id = 0};
     } else if (op == +OPCODE::RECV) {
         p.type = TransferType::receive;
         p.src_id = reg_unit_->readRegister(ins.rs, false);
@@ -176,7 +189,7 @@ std::shared_ptr<ExecuteInsPayload> DecoderV2::decodeTransferIns(const InstV2& in
         p.transfer_id_tag = reg_unit_->readRegister(ins.rf, false);
         p.data_path_payload = {.type = DataPathType::inter_core_bus, .local_dedicated_data_path_id = 0};
     }
-    return std::make_shared<TransferInsPayload>(p);
+    return ins_payload_pool_.create(p);
 }
 
 int DecoderV2::decodeControlInsAndGetPCIncrement(const InstV2& ins) const {
@@ -227,12 +240,12 @@ std::shared_ptr<ExecuteInsPayload> DecoderV2::decodeSIMDIns(const InstV2& ins) c
                                  (ins_cfg == nullptr ? "inst" : "functor"), p.toString());
         std::cerr << fmt::format("ins opcode: {}, input cnt: {}, funct: {}", ins.opcode, input_cnt, opcode);
 
-        return std::make_shared<ExecuteInsPayload>(InstructionPayload{.unit_type = ExecuteUnitType::none});
+        return createInsPayload(ExecuteUnitType::none);
     }
     p.ins_cfg = ins_cfg;
     p.func_cfg = func_cfg;
 
-    return std::make_shared<SIMDInsPayload>(p);
+    return ins_payload_pool_.create(p);
 }
 
 std::shared_ptr<ExecuteInsPayload> DecoderV2::decodeReduceIns(const InstV2& ins) const {
@@ -248,10 +261,10 @@ std::shared_ptr<ExecuteInsPayload> DecoderV2::decodeReduceIns(const InstV2& ins)
     p.func_cfg = getReduceFunctor(static_cast<unsigned int>(ins.funct), p.input_bit_width, p.output_bit_width);
     if (p.func_cfg == nullptr) {
         std::cerr << fmt::format("No match functor, Invalid Reduce instruction: \n{}", p.toString());
-        return std::make_shared<ExecuteInsPayload>(InstructionPayload{.unit_type = ExecuteUnitType::none});
+        return createInsPayload(ExecuteUnitType::none);
     }
 
-    return std::make_shared<ReduceInsPayload>(p);
+    return ins_payload_pool_.create(p);
 }
 
 }  // namespace cimsim
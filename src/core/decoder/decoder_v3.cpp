@@ -22,10 +22,10 @@ std::shared_ptr<ExecuteInsPayload> DecoderV3::decode(const InstV3& ins, int pc,
         payload = decodeVectorIns(ins);
     } else if ((opcode & OPCODE_MASK::INST_CLASS_2BIT) == OPCODE_CLASS::SC) {
         payload = decodeScalarIns(ins);
-    } else if ((opcode & OPCODE_MASK::INST_CLASS_3BIT) == OPCODE_CLASS::TRANS) {
+    } else if ((opcode & OPCODE_MASK::INST_CLASS_3BIT) == OPCODE_CLASS::TRANS || opcode == OPCODE::SEND_MC) {
         payload = decodeTransferIns(ins);
     } else {
-        payload = std::make_shared<ExecuteInsPayload>(InstructionPayload{.unit_type = ExecuteUnitType::control});
+        payload = createInsPayload(ExecuteUnitType::control);
         pc_increment = decodeControlInsAndGetPCIncrement(ins);
     }
     payload->ins.pc = pc;
@@ -58,7 +58,7 @@ std::shared_ptr<ExecuteInsPayload> DecoderV3::decodeCimIns(const InstV3& ins) co
         p.value_sparse = ins.getFlag(FLAG_POSITION::CIM_MVM_SP_V);
         p.value_sparse_mask_addr_byte = reg_unit_->readRegister(SpecialRegId::value_sparse_mask_addr, true);
 
-        payload = std::make_shared<CimComputeInsPayload>(p);
+        payload = ins_payload_pool_.create(p);
     } else if ((opcode & OPCODE_MASK::INST_TYPE_2BIT) == OPCODE::CIM_CFG) {
         CimControlInsPayload p;
         p.ins.unit_type = ExecuteUnitType::cim_control;
@@ -68,7 +68,7 @@ std::shared_ptr<ExecuteInsPayload> DecoderV3::decodeCimIns(const InstV3& ins) co
         p.group_id = reg_unit_->readRegister(ins.getR1(), false);
         p.mask_addr_byte = reg_unit_->readRegister(ins.getR2(), false);
 
-        payload = std::make_shared<CimControlInsPayload>(p);
+        payload = ins_payload_pool_.create(p);
     } else if ((opcode & OPCODE_MASK::INST_TYPE_2BIT) == OPCODE::CIM_OUT) {
         CimControlInsPayload p;
         p.ins.unit_type = ExecuteUnitType::cim_control;
@@ -82,7 +82,7 @@ std::shared_ptr<ExecuteInsPayload> DecoderV3::decodeCimIns(const InstV3& ins) co
         p.output_bit_width = reg_unit_->readRegister(SpecialRegId::cim_output_bit_width, true);
         p.output_mask_addr_byte = reg_unit_->readRegister(ins.getR2(), false);
 
-        payload = std::make_shared<CimControlInsPayload>(p);
+        payload = ins_payload_pool_.create(p);
     }
     return payload;
 }
@@ -114,12 +114,12 @@ std::shared_ptr<ExecuteInsPayload> DecoderV3::decodeVectorIns(const InstV3& ins)
     if (ins_cfg == nullptr || func_cfg == nullptr) {
         std::cerr << fmt::format("No match {}, Invalid SIMD instruction: \n{}",
                                  (ins_cfg == nullptr ? "inst" : "functor"), p.toString());
-        return std::make_shared<ExecuteInsPayload>(InstructionPayload{.unit_type = ExecuteUnitType::none});
+        return createInsPayload(ExecuteUnitType::none);
     }
     p.ins_cfg = ins_cfg;
     p.func_cfg = func_cfg;
 
-    return std::make_shared<SIMDInsPayload>(p);
+    return ins_payload_pool_.create(p);
 }
 
 std::shared_ptr<ExecuteInsPayload> DecoderV3::decodeScalarIns(const InstV3& ins) const {
@@ -157,7 +157,7 @@ std::shared_ptr<ExecuteInsPayload> DecoderV3::decodeScalarIns(const InstV3& ins)
         p.dst_reg = ins.getR2();
         p.write_special_register = opcode == OPCODE::GS_MOV;
     }
-    return std::make_shared<ScalarInsPayload>(p);
+    return ins_payload_pool_.create(p);
 }
 
 std::shared_ptr<ExecuteInsPayload> DecoderV3::decodeTransferIns(const InstV3& ins) const {
@@ -177,6 +177,18 @@ std::shared_ptr<ExecuteInsPayload> DecoderV3::decodeTransferIns(const InstV3& in
         } else if (as_.isAddressGlobal(p.dst_address_byte)) {
             p.type = TransferType::global_store;
         }
+    } else if (opcode == OPCODE::SEND_MC) {
+        // R2 holds destination core range: (dst_cnt << 16) | first dst_id
+        int dst_range = reg_unit_->readRegister(ins.getR2(), false);
+        p.type = TransferType::multicast;
+        p.src_id = core_id_;
+        p.src_address_byte = reg_unit_->readRegister(ins.getR1(), false);
+        p.dst_id = dst_range & 0xffff;
+        p.dst_cnt = (dst_range >> 16) & 0xffff;
+        checkMulticastDstRange(p.dst_id, p.dst_cnt);
+        p.dst_address_byte = reg_unit_->readRegister(ins.getR3(), false);
+        p.size_byte = reg_unit_->readRegister(ins.getR4(), false);
+        p.transfer_id_tag = reg_unit_->readRegister(ins.getR5(), false);
     } else if ((opcode & OPCODE_MASK::TRANS_TYPE_5BIT) == OPCODE::SEND) {
         p.type = TransferType::send;
         p.src_id = core_id_;
@@ -194,7 +206,7 @@ std::shared_ptr<ExecuteInsPayload> DecoderV3::decodeTransferIns(const InstV3& in
         p.size_byte = reg_unit_->readRegister(ins.getR4(), false);
         p.transfer_id_tag = reg_unit_->readRegister(ins.getR5(), false);
     }
-    return std::make_shared<TransferInsPayload>(p);
+    return ins_payload_pool_.create(p);
 }
 
 int DecoderV3::decodeControlInsAndGetPCIncrement(const InstV3& ins) const {
@@ -14,9 +14,13 @@ CimComputeUnit::CimComputeUnit(const sc_module_name &name, const CimUnitConfig &
                                Clock *clk)
     : ExecuteUnit(name, base_info, clk, ExecuteUnitType::cim_compute), config_(config), macro_size_(config.macro_size) {
     SC_THREAD(processIssue)
+    setThreadStackSize();
     SC_THREAD(processSubIns)
+    setThreadStackSize();
     SC_THREAD(readValueSparseMaskSubmodule)
+    setThreadStackSize();
     SC_THREAD(readBitSparseMetaSubmodule)
+    setThreadStackSize();
 
     if (config_.value_sparse) {
         value_sparse_network_energy_counter_.setStaticPowerMW(config_.value_sparse_config.static_power_mW);
@@ -26,6 +30,8 @@ CimComputeUnit::CimComputeUnit(const sc_module_name &name, const CimUnitConfig &
         meta_buffer_energy_counter_.setStaticPowerMW(config_.bit_sparse_config.reg_buffer_static_power_mW);
         energy_counter_.addSubEnergyCounter("meta buffer", &meta_buffer_energy_counter_);
     }
+    value_sparse_network_energy_counter_.addDynamicPowerParam(config_.value_sparse_config.dynamic_power_mW);
+    meta_buffer_energy_counter_.addDynamicPowerParam(config_.bit_sparse_config.reg_buffer_dynamic_power_mW_per_unit);
 }
 
 void CimComputeUnit::bindCimUnit(CimUnit *cim_unit) {
@@ -135,17 +141,19 @@ void CimComputeUnit::processSubInsCompute(const CimComputeSubInsPayload &sub_ins
                                         .bit_sparse = config_.bit_sparse && payload.bit_sparse,
                                         .simulated_group_cnt = total_activation_group_cnt,
                                         .simulated_macro_cnt = total_activation_macro_cnt};
+        // simulated groups read the same inputs, so only the last read data is kept
+        std::vector<uint8_t> read_data;
         for (int i = 0; i < total_activation_group_cnt; i++) {
-            group_payload.macro_inputs =
-                getMacroGroupInputs(group_id, get_address_byte(group_id), size_byte, sub_ins_payload);
+            read_data = memory_socket_.readLocal(payload.ins, get_address_byte(group_id), size_byte);
         }
+        group_payload.macro_inputs = getMacroGroupInputs(group_id, std::move(read_data), sub_ins_payload);
         cim_unit_->runMacroGroup(group_id, std::move(group_payload));
 
         if (config_.value_sparse && payload.value_sparse &&
             (group_id + 1) % config_.value_sparse_config.output_macro_group_cnt == 0) {
-            double dynamic_power_mW = config_.value_sparse_config.dynamic_power_mW;
             double latency = config_.value_sparse_config.latency_cycle * period_ns_;
-            value_sparse_network_energy_counter_.addDynamicEnergyPJ(latency, dynamic_power_mW,
+            value_sparse_network_energy_counter_.addDynamicEnergyPJ(latency,
+                                                                    config_.value_sparse_config.dynamic_power_mW, 1,
                                                                     {.core_id = core_id_,
                                                                      .ins_id = payload.ins.ins_id,
                                                                      .inst_opcode = payload.ins.inst_opcode,
@@ -157,45 +165,19 @@ void CimComputeUnit::processSubInsCompute(const CimComputeSubInsPayload &sub_ins
     wait(SC_ZERO_TIME);
 }
 
-std::vector<std::vector<unsigned long long>> CimComputeUnit::getMacroGroupInputs(
-    int group_id, int addr_byte, int size_byte, const cimsim::CimComputeSubInsPayload &sub_ins_payload) {
+MacroGroupInputs CimComputeUnit::getMacroGroupInputs(int group_id, std::vector<uint8_t> read_data,
+                                                     const cimsim::CimComputeSubInsPayload &sub_ins_payload) {
     const auto &payload = sub_ins_payload.ins_payload;
-
-    auto read_data = memory_socket_.readLocal(payload.ins, addr_byte, size_byte);
-    if (data_mode_ == +DataMode::not_real_data) {
+    if (data_mode_ == +DataMode::not_real_data || payload.input_bit_width <= 0) {
         return {};
     }
 
-    std::vector<unsigned long long> input_data;
-    if (payload.input_bit_width == BYTE_TO_BIT) {
-        input_data.resize(read_data.size());
-        std::transform(read_data.begin(), read_data.end(), input_data.begin(),
-                       [](unsigned char data) { return static_cast<unsigned long long>(data); });
-    }
-
-    std::vector<std::vector<unsigned long long>> macro_group_inputs;
-    if (config_.value_sparse && payload.value_sparse) {
-        const auto &mask_byte_data = read_value_sparse_mask_socket_.payload.data;
-        for (int macro_id = 0; macro_id < cim_unit_->getMacroGroupActivationMacroCount(group_id); macro_id++) {
-            std::vector<unsigned long long> macro_input;
-            macro_input.reserve(macro_size_.compartment_cnt_per_macro);
-            for (int i = 0; i < payload.input_len; i++) {
-                if (getMaskBit(mask_byte_data, macro_id * payload.input_len + i) != 0) {
-                    macro_input.push_back(input_data[i]);
-                }
-                if (macro_input.size() == macro_size_.compartment_cnt_per_macro) {
-                    break;
-                }
-            }
-            macro_group_inputs.push_back(std::move(macro_input));
-        }
-    } else {
-        for (int i = 0; i < cim_unit_->getMacroGroupActivationMacroCount(group_id); i++) {
-            macro_group_inputs.push_back(input_data);
-        }
-    }
-
-    return std::move(macro_group_inputs);
+    // inputs are kept in native bit width and shared by all macros in the group
+    bool value_sparse = config_.value_sparse && payload.value_sparse;
+    return MacroGroupInputs::fromReadData(std::move(read_data), payload.input_bit_width, payload.input_len,
+                                          cim_unit_->getMacroGroupActivationMacroCount(group_id),
+                                          macro_size_.compartment_cnt_per_macro,
+                                          value_sparse ? &read_value_sparse_mask_socket_.payload.data : nullptr);
 }
 
 void CimComputeUnit::readValueSparseMaskSubmodule() {
@@ -216,9 +198,10 @@ void CimComputeUnit::readBitSparseMetaSubmodule() {
         auto &payload = read_bit_sparse_meta_socket_.payload;
         payload.data = memory_socket_.readLocal(payload.ins, payload.addr_byte, payload.size_byte);
 
-        double dynamic_power_mW = config_.bit_sparse_config.reg_buffer_dynamic_power_mW_per_unit *
-                                  IntDivCeil(payload.size_byte, config_.bit_sparse_config.unit_byte);
-        meta_buffer_energy_counter_.addDynamicEnergyPJ(period_ns_, dynamic_power_mW,
+        int meta_unit_cnt = IntDivCeil(payload.size_byte, config_.bit_sparse_config.unit_byte);
+        meta_buffer_energy_counter_.addDynamicEnergyPJ(period_ns_,
+                                                       config_.bit_sparse_config.reg_buffer_dynamic_power_mW_per_unit,
+                                                       meta_unit_cnt,
                                                        {.core_id = core_id_,
                                                         .ins_id = payload.ins.ins_id,
                                                         .inst_opcode = payload.ins.inst_opcode,
@@ -249,7 +232,7 @@ ResourceAllocatePayload CimComputeUnit::getDataConflictInfo(const cimsim::CimCom
 }
 
 ResourceAllocatePayload CimComputeUnit::getDataConflictInfo(const std::shared_ptr<ExecuteInsPayload> &payload) {
-    return getDataConflictInfo(*std::dynamic_pointer_cast<CimComputeInsPayload>(payload));
+    return getDataConflictInfo(*castInsPayload<CimComputeInsPayload>(payload));
 }
 
 }  // namespace cimsim
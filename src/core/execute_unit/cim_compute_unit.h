@@ -46,8 +46,8 @@ private:
     [[noreturn]] void readValueSparseMaskSubmodule();
     [[noreturn]] void readBitSparseMetaSubmodule();
 
-    std::vector<std::vector<unsigned long long>> getMacroGroupInputs(int group_id, int addr_byte, int size_byte,
-                                                                     const CimComputeSubInsPayload& sub_ins_payload);
+    MacroGroupInputs getMacroGroupInputs(int group_id, std::vector<uint8_t> read_data,
+                                         const CimComputeSubInsPayload& sub_ins_payload);
 
 private:
     const CimUnitConfig& config_;
@@ -5,6 +5,7 @@
 #include "cim_control_unit.h"
 
 #include "fmt/format.h"
+#include "util/bit_kernel.h"
 #include "util/log.h"
 #include "util/util.h"
 
@@ -14,9 +15,12 @@ CimControlUnit::CimControlUnit(const sc_module_name &name, const CimUnitConfig &
                                Clock *clk)
     : ExecuteUnit(name, base_info, clk, ExecuteUnitType::cim_control), config_(config), macro_size_(config.macro_size) {
     SC_THREAD(processIssue)
+    setThreadStackSize();
     SC_THREAD(processExecute)
+    setThreadStackSize();
 
     energy_counter_.addSubEnergyCounter("result adder", &result_adder_energy_counter_);
+    result_adder_energy_counter_.addDynamicPowerParam(config_.result_adder.dynamic_power_mW);
 }
 
 void CimControlUnit::bindCimUnit(CimUnit *cim_unit) {
@@ -78,25 +82,19 @@ void CimControlUnit::processOnlyOutput(const CimControlInsPayload &payload) {
 
     int size_byte =
         IntDivCeil(payload.output_bit_width * payload.output_cnt_per_group * payload.activation_group_num, BYTE_TO_BIT);
-    memory_socket_.writeLocal(payload.ins, payload.output_addr_byte, size_byte, {});
+    memory_socket_.writeLocal(payload.ins, payload.output_addr_byte, size_byte, getOutputData(payload, size_byte));
 }
 
 void CimControlUnit::processOutputSum(const CimControlInsPayload &payload) {
     // read and process sum mask
     int mask_size_byte = IntDivCeil(payload.output_cnt_per_group, BYTE_TO_BIT);
     auto mask_byte_data = memory_socket_.readLocal(payload.ins, payload.output_mask_addr_byte, mask_size_byte);
-    int sum_times_per_group = 0;
-    for (int i = 0; i < payload.output_cnt_per_group; i++) {
-        if (getMaskBit(mask_byte_data, i) != 0) {
-            sum_times_per_group++;
-        }
-    }
+    int sum_times_per_group = countMaskBits(mask_byte_data, 0, payload.output_cnt_per_group);
 
     // sum
     double sum_latency = config_.result_adder.latency_cycle * period_ns_;
-    double sum_dynamic_power_mW =
-        config_.result_adder.dynamic_power_mW * sum_times_per_group * payload.activation_group_num;
-    result_adder_energy_counter_.addDynamicEnergyPJ(sum_latency, sum_dynamic_power_mW,
+    result_adder_energy_counter_.addDynamicEnergyPJ(sum_latency, config_.result_adder.dynamic_power_mW,
+                                                    sum_times_per_group * payload.activation_group_num,
                                                     {.core_id = core_id_,
                                                      .ins_id = payload.ins.ins_id,
                                                      .inst_opcode = payload.ins.inst_opcode,
@@ -113,16 +111,16 @@ void CimControlUnit::processOutputSum(const CimControlInsPayload &payload) {
     int valid_output_cnt_per_group = payload.output_cnt_per_group - sum_times_per_group;
     int size_byte =
         IntDivCeil(payload.output_bit_width * valid_output_cnt_per_group * payload.activation_group_num, BYTE_TO_BIT);
-    memory_socket_.writeLocal(payload.ins, payload.output_addr_byte, size_byte, {});
+    memory_socket_.writeLocal(payload.ins, payload.output_addr_byte, size_byte,
+                              getOutputData(payload, size_byte, mask_byte_data));
 }
 
 void CimControlUnit::processOutputSumMove(const CimControlInsPayload &payload) {
     int sum_times_per_group = payload.output_cnt_per_group;
 
     double sum_latency = config_.result_adder.latency_cycle * period_ns_;
-    double sum_dynamic_power_mW =
-        config_.result_adder.dynamic_power_mW * sum_times_per_group * payload.activation_group_num;
-    result_adder_energy_counter_.addDynamicEnergyPJ(sum_latency, sum_dynamic_power_mW,
+    result_adder_energy_counter_.addDynamicEnergyPJ(sum_latency, config_.result_adder.dynamic_power_mW,
+                                                    sum_times_per_group * payload.activation_group_num,
                                                     {.core_id = core_id_,
                                                      .ins_id = payload.ins.ins_id,
                                                      .inst_opcode = payload.ins.inst_opcode,
@@ -140,7 +138,56 @@ void CimControlUnit::processOutputSumMove(const CimControlInsPayload &payload) {
     int size_byte =
         IntDivCeil(payload.output_bit_width * valid_output_cnt_per_group * payload.activation_group_num, BYTE_TO_BIT);
     CORE_LOG(fmt::format("size_byte: {}", size_byte));
-    memory_socket_.writeLocal(payload.ins, payload.output_addr_byte, size_byte, {});
+    memory_socket_.writeLocal(payload.ins, payload.output_addr_byte, size_byte, getOutputData(payload, size_byte));
+}
+
+std::vector<uint8_t> CimControlUnit::getOutputData(const CimControlInsPayload &payload, int size_byte,
+                                                   const std::vector<unsigned char> &sum_mask) const {
+    if (data_mode_ != +DataMode::real_data || cim_unit_ == nullptr) {
+        return {};
+    }
+    return packOutputData(payload, size_byte, sum_mask,
+                          [this](int group_id) -> const std::vector<long long> & {
+                              return cim_unit_->getMacroGroupResult(group_id);
+                          });
+}
+
+std::vector<uint8_t> CimControlUnit::packOutputData(
+    const CimControlInsPayload &payload, int size_byte, const std::vector<unsigned char> &sum_mask,
+    const std::function<const std::vector<long long> &(int)> &get_group_result) {
+    std::vector<uint8_t> data(size_byte, 0);
+    long long bit_offset = 0;
+    auto write_output = [&](long long value) {
+        setBitField(data, bit_offset, payload.output_bit_width, static_cast<unsigned long long>(value));
+        bit_offset += payload.output_bit_width;
+    };
+
+    for (int group_id = 0; group_id < payload.activation_group_num; group_id++) {
+        const auto &result = get_group_result(group_id);
+        auto get_result = [&](int index) { return index < result.size() ? result[index] : 0LL; };
+
+        if (payload.op == +CimControlOperator::only_output) {
+            for (int i = 0; i < payload.output_cnt_per_group; i++) {
+                write_output(get_result(i));
+            }
+        } else if (payload.op == +CimControlOperator::output_sum) {
+            // mask bit 1 means this output is added to the next one
+            long long sum = 0;
+            for (int i = 0; i < payload.output_cnt_per_group; i++) {
+                sum += get_result(i);
+                if (getMaskBit(sum_mask, i) == 0) {
+                    write_output(sum);
+                    sum = 0;
+                }
+            }
+        } else if (payload.op == +CimControlOperator::output_sum_move) {
+            for (int i = 0; i < payload.output_cnt_per_group; i++) {
+                write_output(get_result(2 * i) + get_result(2 * i + 1));
+            }
+        }
+    }
+
+    return data;
 }
 
 ResourceAllocatePayload CimControlUnit::getDataConflictInfo(const CimControlInsPayload &payload) const {
@@ -166,7 +213,7 @@ ResourceAllocatePayload CimControlUnit::getDataConflictInfo(const CimControlInsP
 }
 
 ResourceAllocatePayload CimControlUnit::getDataConflictInfo(const std::shared_ptr<ExecuteInsPayload> &payload) {
-    return getDataConflictInfo(*std::dynamic_pointer_cast<CimControlInsPayload>(payload));
+    return getDataConflictInfo(*castInsPayload<CimControlInsPayload>(payload));
 }
 
 }  // namespace cimsim
@@ -22,6 +22,11 @@ public:
     ResourceAllocatePayload getDataConflictInfo(const CimControlInsPayload& payload) const;
     ResourceAllocatePayload getDataConflictInfo(const std::shared_ptr<ExecuteInsPayload>& payload) override;
 
+    // pack results of activated macro groups into output data of an output instruction
+    static std::vector<uint8_t> packOutputData(
+        const CimControlInsPayload& payload, int size_byte, const std::vector<unsigned char>& sum_mask,
+        const std::function<const std::vector<long long>&(int)>& get_group_result);
+
 private:
     [[noreturn]] void processIssue();
     [[noreturn]] void processExecute();
@@ -31,6 +36,10 @@ private:
     void processOutputSum(const CimControlInsPayload& payload);
     void processOutputSumMove(const CimControlInsPayload& payload);
 
+    // pack results of activated macro groups, only in real data mode
+    std::vector<uint8_t> getOutputData(const CimControlInsPayload& payload, int size_byte,
+                                       const std::vector<unsigned char>& sum_mask = {}) const;
+
 private:
     const CimUnitConfig& config_;
     const CimMacroSizeConfig& macro_size_;
@@ -82,8 +82,17 @@ void ExecuteUnit::releaseResource(int ins_id) {
     release_resource_trigger_.notify(SC_ZERO_TIME);
 }
 
+bool ExecuteUnit::isIdle() const {
+    return running_ins_cnt_ == 0 && ports_.ready_port_.read();
+}
+
+const sc_time& ExecuteUnit::getLastFinishTime() const {
+    return last_finish_time_;
+}
+
 void ExecuteUnit::finishInstruction(double t) {
     wait(t, SC_NS);
+    last_finish_time_ = sc_time_stamp();
     running_ins_cnt_--;
     if (running_ins_cnt_ == 0 && finish_decode_) {
         finish_run_ = true;
@@ -71,6 +71,11 @@ public:
 
     virtual ResourceAllocatePayload getDataConflictInfo(const std::shared_ptr<ExecuteInsPayload>& payload);
 
+    // no instruction is executing in this unit
+    [[nodiscard]] bool isIdle() const;
+    // when the last instruction of this unit finished
+    [[nodiscard]] const sc_time& getLastFinishTime() const;
+
 protected:
     template <class InsPayload>
     std::shared_ptr<InsPayload> waitForExecuteAndGetPayload() {
@@ -78,7 +83,7 @@ protected:
         ports_.ready_port_.write(false);
         running_ins_cnt_++;
 
-        return std::dynamic_pointer_cast<InsPayload>(fsm_out_.read().payload);
+        return castInsPayload<InsPayload>(fsm_out_.read().payload);
     }
 
     void readyForNextExecute();
@@ -105,6 +110,7 @@ private:
 
     int running_ins_cnt_{0};
     bool finish_decode_{false};
+    sc_time last_finish_time_{SC_ZERO_TIME};
     sc_event finish_run_trigger_;
     bool finish_run_{false};
 };
@@ -0,0 +1,381 @@
+#include "functional_kernel.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "util/kernel_isa.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define CIMSIM_X86_KERNEL_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace cimsim {
+
+namespace {
+
+enum SIMDOpcode : unsigned int {
+    simd_add = 0x00,
+    simd_add_scalar = 0x01,
+    simd_multiply = 0x02,
+    simd_quantify = 0x03,
+    simd_quantify_resadd = 0x04,
+    simd_quantify_multiply = 0x05
+};
+
+enum ReduceFunct : unsigned int { reduce_sum = 0, reduce_max = 1, reduce_min = 2 };
+
+using BinaryKernel = void (*)(const uint8_t* a, const uint8_t* b, uint8_t* out, int len);
+using ReduceKernel = long long (*)(const uint8_t* in, int len);
+
+constexpr int WIDTH_KIND_CNT = 3;  // 8, 16, 32 bits
+
+int getWidthKind(int bit_width) {
+    switch (bit_width) {
+        case 8: return 0;
+        case 16: return 1;
+        case 32: return 2;
+        default: return -1;
+    }
+}
+
+template <typename T>
+T loadAt(const uint8_t* data, int index) {
+    T value;
+    std::memcpy(&value, data + static_cast<size_t>(index) * sizeof(T), sizeof(T));
+    return value;
+}
+
+template <typename T>
+void storeAt(uint8_t* data, int index, T value) {
+    std::memcpy(data + static_cast<size_t>(index) * sizeof(T), &value, sizeof(T));
+}
+
+// portable kernels, written as plain loops so that compiler can auto vectorize them
+template <typename T>
+void addGeneric(const uint8_t* a, const uint8_t* b, uint8_t* out, int len) {
+    using U = std::make_unsigned_t<T>;
+    for (int i = 0; i < len; i++) {
+        storeAt<U>(out, i, static_cast<U>(loadAt<U>(a, i) + loadAt<U>(b, i)));
+    }
+}
+
+template <typename T>
+void multiplyGeneric(const uint8_t* a, const uint8_t* b, uint8_t* out, int len) {
+    using U = std::make_unsigned_t<T>;
+    for (int i = 0; i < len; i++) {
+        storeAt<U>(out, i, static_cast<U>(static_cast<unsigned long long>(loadAt<U>(a, i)) * loadAt<U>(b, i)));
+    }
+}
+
+template <typename T>
+long long sumGeneric(const uint8_t* in, int len) {
+    long long sum = 0;
+    for (int i = 0; i < len; i++) {
+        sum += loadAt<T>(in, i);
+    }
+    return sum;
+}
+
+template <typename T>
+long long maxGeneric(const uint8_t* in, int len) {
+    T result = std::numeric_limits<T>::min();
+    for (int i = 0; i < len; i++) {
+        result = std::max(result, loadAt<T>(in, i));
+    }
+    return result;
+}
+
+template <typename T>
+long long minGeneric(const uint8_t* in, int len) {
+    T result = std::numeric_limits<T>::max();
+    for (int i = 0; i < len; i++) {
+        result = std::min(result, loadAt<T>(in, i));
+    }
+    return result;
+}
+
+#ifdef CIMSIM_X86_KERNEL_DISPATCH
+// AVX2 kernels, only selected when cpu supports avx2 at runtime
+#define CIMSIM_AVX2_KERNEL __attribute__((target("avx2")))
+
+#define DEFINE_AVX2_BINARY_KERNEL(func_name, T, intrinsic, tail_func)                             \
+    CIMSIM_AVX2_KERNEL void func_name(const uint8_t* a, const uint8_t* b, uint8_t* out, int len) { \
+        constexpr int step = 32 / sizeof(T);                                                       \
+        int i = 0;                                                                                 \
+        for (; i + step <= len; i += step) {                                                       \
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i * sizeof(T)));   \
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i * sizeof(T)));   \
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * sizeof(T)), intrinsic(x, y)); \
+        }                                                                                          \
+        size_t offset = static_cast<size_t>(i) * sizeof(T);                                        \
+        tail_func(a + offset, b + offset, out + offset, len - i);                                  \
+    }
+
+DEFINE_AVX2_BINARY_KERNEL(addInt8AVX2, int8_t, _mm256_add_epi8, addGeneric<int8_t>)
+DEFINE_AVX2_BINARY_KERNEL(addInt16AVX2, int16_t, _mm256_add_epi16, addGeneric<int16_t>)
+DEFINE_AVX2_BINARY_KERNEL(addInt32AVX2, int32_t, _mm256_add_epi32, addGeneric<int32_t>)
+DEFINE_AVX2_BINARY_KERNEL(multiplyInt16AVX2, int16_t, _mm256_mullo_epi16, multiplyGeneric<int16_t>)
+DEFINE_AVX2_BINARY_KERNEL(multiplyInt32AVX2, int32_t, _mm256_mullo_epi32, multiplyGeneric<int32_t>)
+
+#define DEFINE_AVX2_MAX_MIN_KERNEL(func_name, T, vec_intrinsic, scalar_func, init_value)                           \
+    CIMSIM_AVX2_KERNEL long long func_name(const uint8_t* in, int len) {                                          \
+        constexpr int step = 32 / sizeof(T);                                                                      \
+        alignas(32) T lanes[step];                                                                                 \
+        std::fill_n(lanes, step, init_value);                                                                     \
+        __m256i acc = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes));                                 \
+        int i = 0;                                                                                                \
+        for (; i + step <= len; i += step) {                                                                      \
+            acc = vec_intrinsic(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i * sizeof(T))));   \
+        }                                                                                                         \
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);                                               \
+        T result = init_value;                                                                                    \
+        for (T lane : lanes) {                                                                                    \
+            result = scalar_func(result, lane);                                                                   \
+        }                                                                                                         \
+        for (; i < len; i++) {                                                                                    \
+            result = scalar_func(result, loadAt<T>(in, i));                                                       \
+        }                                                                                                         \
+        return result;                                                                                            \
+    }
+
+DEFINE_AVX2_MAX_MIN_KERNEL(maxInt8AVX2, int8_t, _mm256_max_epi8, std::max<int8_t>, INT8_MIN)
+DEFINE_AVX2_MAX_MIN_KERNEL(maxInt16AVX2, int16_t, _mm256_max_epi16, std::max<int16_t>, INT16_MIN)
+DEFINE_AVX2_MAX_MIN_KERNEL(maxInt32AVX2, int32_t, _mm256_max_epi32, std::max<int32_t>, INT32_MIN)
+DEFINE_AVX2_MAX_MIN_KERNEL(minInt8AVX2, int8_t, _mm256_min_epi8, std::min<int8_t>, INT8_MAX)
+DEFINE_AVX2_MAX_MIN_KERNEL(minInt16AVX2, int16_t, _mm256_min_epi16, std::min<int16_t>, INT16_MAX)
+DEFINE_AVX2_MAX_MIN_KERNEL(minInt32AVX2, int32_t, _mm256_min_epi32, std::min<int32_t>, INT32_MAX)
+
+CIMSIM_AVX2_KERNEL long long sumInt32AVX2(const uint8_t* in, int len) {
+    __m256i acc = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 4 <= len; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * sizeof(int32_t)));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(x));
+    }
+    alignas(32) long long lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    long long sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (; i < len; i++) {
+        sum += loadAt<int32_t>(in, i);
+    }
+    return sum;
+}
+
+#undef DEFINE_AVX2_BINARY_KERNEL
+#undef DEFINE_AVX2_MAX_MIN_KERNEL
+#undef CIMSIM_AVX2_KERNEL
+#endif
+
+struct KernelTable {
+    BinaryKernel add[WIDTH_KIND_CNT]{addGeneric<int8_t>, addGeneric<int16_t>, addGeneric<int32_t>};
+    BinaryKernel multiply[WIDTH_KIND_CNT]{multiplyGeneric<int8_t>, multiplyGeneric<int16_t>,
+                                          multiplyGeneric<int32_t>};
+    ReduceKernel sum[WIDTH_KIND_CNT]{sumGeneric<int8_t>, sumGeneric<int16_t>, sumGeneric<int32_t>};
+    ReduceKernel max[WIDTH_KIND_CNT]{maxGeneric<int8_t>, maxGeneric<int16_t>, maxGeneric<int32_t>};
+    ReduceKernel min[WIDTH_KIND_CNT]{minGeneric<int8_t>, minGeneric<int16_t>, minGeneric<int32_t>};
+};
+
+KernelTable createKernelTable(KernelIsa limit) {
+    KernelTable table{};
+#ifdef CIMSIM_X86_KERNEL_DISPATCH
+    if (isKernelIsaAllowed(limit, KernelIsa::avx2)) {
+        table.add[0] = addInt8AVX2;
+        table.add[1] = addInt16AVX2;
+        table.add[2] = addInt32AVX2;
+        table.multiply[1] = multiplyInt16AVX2;
+        table.multiply[2] = multiplyInt32AVX2;
+        table.sum[2] = sumInt32AVX2;
+        table.max[0] = maxInt8AVX2;
+        table.max[1] = maxInt16AVX2;
+        table.max[2] = maxInt32AVX2;
+        table.min[0] = minInt8AVX2;
+        table.min[1] = minInt16AVX2;
+        table.min[2] = minInt32AVX2;
+    }
+#endif
+    return table;
+}
+
+const KernelTable& getKernelTable() {
+    static const KernelTable table_list[] = {createKernelTable(KernelIsa::generic), createKernelTable(KernelIsa::avx2),
+                                             createKernelTable(KernelIsa::avx512)};
+    return table_list[getKernelIsaLimit()._to_integral()];
+}
+
+long long saturate(long long value, int bit_width) {
+    if (bit_width >= 64) {
+        return value;
+    }
+    long long max_value = (1LL << (bit_width - 1)) - 1;
+    long long min_value = -(1LL << (bit_width - 1));
+    return std::clamp(value, min_value, max_value);
+}
+
+long long arithmeticShiftRight(long long value, long long shift) {
+    if (shift <= 0) {
+        return value;
+    }
+    return value >> std::min(shift, 63LL);
+}
+
+long long loadOperand(const KernelOperand& operand, int index) {
+    return loadElement(operand.data, operand.bit_width, operand.scalar ? 0 : index);
+}
+
+bool allVectorWithWidth(const std::vector<KernelOperand>& inputs, int bit_width) {
+    return std::all_of(inputs.begin(), inputs.end(), [bit_width](const KernelOperand& operand) {
+        return !operand.scalar && operand.bit_width == bit_width;
+    });
+}
+
+void runQuantify(unsigned int opcode, const std::vector<KernelOperand>& inputs, uint8_t* output,
+                 int output_bit_width, int len) {
+    const auto& param = opcode == simd_quantify_resadd ? inputs[2] : inputs[1];
+    const auto& shift = opcode == simd_quantify_resadd ? inputs[3] : inputs[2];
+    for (int i = 0; i < len; i++) {
+        auto param_value = static_cast<unsigned long long>(loadOperand(param, i));
+        auto bias = static_cast<long long>(static_cast<int32_t>(param_value & 0xFFFFFFFFULL));
+        auto mult = static_cast<long long>(static_cast<int32_t>(param_value >> 32));
+        long long x = loadOperand(inputs[0], i);
+
+        long long value;
+        if (opcode == simd_quantify) {
+            value = (x + bias) * mult;
+        } else if (opcode == simd_quantify_resadd) {
+            value = (x + loadOperand(inputs[1], i) + bias) * mult;
+        } else {
+            value = x * mult + bias;
+        }
+        value = arithmeticShiftRight(value, loadOperand(shift, i));
+        storeElement(output, output_bit_width, i, saturate(value, output_bit_width));
+    }
+}
+
+unsigned int getQuantifyInputCnt(unsigned int opcode) {
+    return opcode == simd_quantify_resadd ? 4 : 3;
+}
+
+}  // namespace
+
+long long loadElement(const uint8_t* data, int bit_width, int index) {
+    switch (bit_width) {
+        case 8: return loadAt<int8_t>(data, index);
+        case 16: return loadAt<int16_t>(data, index);
+        case 32: return loadAt<int32_t>(data, index);
+        case 64: return loadAt<int64_t>(data, index);
+        default: break;
+    }
+
+    long long bit_offset = static_cast<long long>(index) * bit_width;
+    unsigned long long value = 0;
+    for (int b = 0; b < bit_width; b++) {
+        long long bit = bit_offset + b;
+        value |= static_cast<unsigned long long>((data[bit / 8] >> (bit % 8)) & 1) << b;
+    }
+    if (bit_width < 64 && ((value >> (bit_width - 1)) & 1) != 0) {
+        value |= ~0ULL << bit_width;
+    }
+    return static_cast<long long>(value);
+}
+
+void storeElement(uint8_t* data, int bit_width, int index, long long value) {
+    switch (bit_width) {
+        case 8: storeAt<int8_t>(data, index, static_cast<int8_t>(value)); return;
+        case 16: storeAt<int16_t>(data, index, static_cast<int16_t>(value)); return;
+        case 32: storeAt<int32_t>(data, index, static_cast<int32_t>(value)); return;
+        case 64: storeAt<int64_t>(data, index, static_cast<int64_t>(value)); return;
+        default: break;
+    }
+
+    long long bit_offset = static_cast<long long>(index) * bit_width;
+    for (int b = 0; b < bit_width; b++) {
+        long long bit = bit_offset + b;
+        auto mask = static_cast<uint8_t>(1 << (bit % 8));
+        if (((static_cast<unsigned long long>(value) >> b) & 1) != 0) {
+            data[bit / 8] |= mask;
+        } else {
+            data[bit / 8] &= static_cast<uint8_t>(~mask);
+        }
+    }
+}
+
+bool runSIMDKernel(unsigned int opcode, const std::vector<KernelOperand>& inputs, uint8_t* output,
+                   int output_bit_width, int len) {
+    const auto& table = getKernelTable();
+    switch (opcode) {
+        case simd_add:
+        case simd_add_scalar:
+        case simd_multiply: {
+            if (inputs.size() != 2) {
+                return false;
+            }
+            int width_kind = getWidthKind(output_bit_width);
+            if (width_kind >= 0 && allVectorWithWidth(inputs, output_bit_width)) {
+                auto kernel = opcode == simd_multiply ? table.multiply[width_kind] : table.add[width_kind];
+                kernel(inputs[0].data, inputs[1].data, output, len);
+                return true;
+            }
+            for (int i = 0; i < len; i++) {
+                long long x = loadOperand(inputs[0], i);
+                long long y = loadOperand(inputs[1], i);
+                storeElement(output, output_bit_width, i, opcode == simd_multiply ? x * y : x + y);
+            }
+            return true;
+        }
+        case simd_quantify:
+        case simd_quantify_resadd:
+        case simd_quantify_multiply: {
+            if (inputs.size() != getQuantifyInputCnt(opcode)) {
+                return false;
+            }
+            runQuantify(opcode, inputs, output, output_bit_width, len);
+            return true;
+        }
+        default: return false;
+    }
+}
+
+bool runReduceKernel(unsigned int funct, const KernelOperand& input, int len, uint8_t* output, int output_bit_width,
+                     int output_index) {
+    const auto& table = getKernelTable();
+    int width_kind = getWidthKind(input.bit_width);
+
+    long long result;
+    switch (funct) {
+        case reduce_sum: {
+            if (width_kind >= 0) {
+                result = table.sum[width_kind](input.data, len);
+            } else {
+                result = 0;
+                for (int i = 0; i < len; i++) {
+                    result += loadElement(input.data, input.bit_width, i);
+                }
+            }
+            break;
+        }
+        case reduce_max:
+        case reduce_min: {
+            if (len <= 0) {
+                result = 0;
+            } else if (width_kind >= 0) {
+                result = funct == reduce_max ? table.max[width_kind](input.data, len)
+                                             : table.min[width_kind](input.data, len);
+            } else {
+                result = loadElement(input.data, input.bit_width, 0);
+                for (int i = 1; i < len; i++) {
+                    long long x = loadElement(input.data, input.bit_width, i);
+                    result = funct == reduce_max ? std::max(result, x) : std::min(result, x);
+                }
+            }
+            break;
+        }
+        default: return false;
+    }
+
+    storeElement(output, output_bit_width, output_index, result);
+    return true;
+}
+
+}  // namespace cimsim
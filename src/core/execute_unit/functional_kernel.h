@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace cimsim {
+
+/* Functional kernels of simd unit and reduce unit, only used in real data mode
+ * All data are little-endian signed integers packed with their bit width, kernels work on memory views directly.
+ * SIMD opcode follows doc/ISA.md:
+ *      0x00 add:               out = in1 + in2
+ *      0x01 add-scalar:        out = in1 + scalar2
+ *      0x02 multiply:          out = in1 * in2
+ *      0x03 quantify:          out = sat(((in1 + bias) * mult) >> shift3),           in2 = {bias, mult}
+ *      0x04 quantify-resadd:   out = sat(((in1 + in2 + bias) * mult) >> shift4),     in3 = {bias, mult}
+ *      0x05 quantify-multiply: out = sat((in1 * mult + bias) >> shift3),             in2 = {bias, mult}
+ * where {bias, mult} is a 64-bit element with bias in low 32 bits and mult in high 32 bits.
+ * add and multiply wrap around output bit width, quantify saturates to output bit width.
+ * Reduce funct:
+ *      0 sum, 1 max, 2 min
+ */
+
+struct KernelOperand {
+    const uint8_t* data{nullptr};
+    int bit_width{0};
+    bool scalar{false};
+};
+
+// return false if opcode or data width is not supported, output is left unchanged
+bool runSIMDKernel(unsigned int opcode, const std::vector<KernelOperand>& inputs, uint8_t* output,
+                   int output_bit_width, int len);
+
+// reduce len inputs into one output
+bool runReduceKernel(unsigned int funct, const KernelOperand& input, int len, uint8_t* output, int output_bit_width,
+                     int output_index);
+
+long long loadElement(const uint8_t* data, int bit_width, int index);
+void storeElement(uint8_t* data, int bit_width, int index, long long value);
+
+}  // namespace cimsim
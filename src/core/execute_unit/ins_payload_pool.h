@@ -0,0 +1,62 @@
+#pragma once
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "payload.h"
+
+namespace cimsim {
+
+/* Slab of recycled instruction payloads of one type.
+ * A payload is in flight while anyone besides the slab holds it (decoder, id-ex signals, fsm, execute unit thread),
+ * once the slab is the only owner the slot is reused, so steady state decode does not allocate.
+ */
+template <class InsPayload>
+class InsPayloadSlab {
+public:
+    std::shared_ptr<InsPayload> create(const InsPayload& payload) {
+        const int slot_cnt = static_cast<int>(slot_list_.size());
+        for (int i = 0; i < slot_cnt; i++) {
+            int index = (next_slot_ + i) % slot_cnt;
+            if (auto& slot = slot_list_[index]; slot.use_count() == 1) {
+                *slot = payload;
+                next_slot_ = (index + 1) % slot_cnt;
+                return slot;
+            }
+        }
+
+        slot_list_.push_back(std::make_shared<InsPayload>(payload));
+        next_slot_ = 0;
+        return slot_list_.back();
+    }
+
+    int getSlotCount() const {
+        return static_cast<int>(slot_list_.size());
+    }
+
+private:
+    std::vector<std::shared_ptr<InsPayload>> slot_list_;
+    int next_slot_{0};
+};
+
+// one slab per execute unit payload type, decoder writes every decoded instruction into a recycled slot
+class InsPayloadPool {
+public:
+    template <class InsPayload>
+    std::shared_ptr<InsPayload> create(const InsPayload& payload) {
+        return std::get<InsPayloadSlab<InsPayload>>(slab_list_).create(payload);
+    }
+
+    template <class InsPayload>
+    int getSlotCount() const {
+        return std::get<InsPayloadSlab<InsPayload>>(slab_list_).getSlotCount();
+    }
+
+private:
+    std::tuple<InsPayloadSlab<ExecuteInsPayload>, InsPayloadSlab<ScalarInsPayload>, InsPayloadSlab<SIMDInsPayload>,
+               InsPayloadSlab<ReduceInsPayload>, InsPayloadSlab<TransferInsPayload>,
+               InsPayloadSlab<CimComputeInsPayload>, InsPayloadSlab<CimControlInsPayload>>
+        slab_list_;
+};
+
+}  // namespace cimsim
@@ -20,7 +20,7 @@ BETTER_ENUM(CimControlOperator, int,  // NOLINT(*-explicit-constructor, *-no-rec
             set_activation = 0, only_output, output_sum, output_sum_move)
 
 BETTER_ENUM(TransferType, int,  // NOLINT(*-explicit-constructor, *-no-recursion)
-            local_trans = 0, global_load, global_store, send, receive)
+            local_trans = 0, global_load, global_store, send, receive, multicast)
 DECLARE_TYPE_FROM_TO_JSON_FUNCTION_NON_INTRUSIVE(TransferType)
 
 struct ExecuteInsPayload {
@@ -45,6 +45,8 @@ struct ExecuteUnitPayload {
 };
 
 struct SIMDInsPayload : public ExecuteInsPayload {
+    static constexpr ExecuteUnitType::_enumerated UNIT_TYPE = ExecuteUnitType::simd;
+
     // compute ins and functor info
     const SIMDInstructionConfig* ins_cfg{nullptr};
     const SIMDFunctorConfig* func_cfg{nullptr};
@@ -65,6 +67,8 @@ struct SIMDInsPayload : public ExecuteInsPayload {
 };
 
 struct TransferInsPayload : public ExecuteInsPayload {
+    static constexpr ExecuteUnitType::_enumerated UNIT_TYPE = ExecuteUnitType::transfer;
+
     TransferType type{TransferType::local_trans};
     DataPathPayload data_path_payload;
 
@@ -74,13 +78,16 @@ struct TransferInsPayload : public ExecuteInsPayload {
 
     int src_id{0};
     int dst_id{0};
+    int dst_cnt{1};  // multicast to core dst_id ~ dst_id + dst_cnt - 1
     int transfer_id_tag{0};
 
     DEFINE_EXECUTE_INS_PAYLOAD_FUNCTIONS(TransferInsPayload, ins, type, data_path_payload, src_address_byte,
-                                         dst_address_byte, size_byte, src_id, dst_id, transfer_id_tag)
+                                         dst_address_byte, size_byte, src_id, dst_id, dst_cnt, transfer_id_tag)
 };
 
 struct ScalarInsPayload : public ExecuteInsPayload {
+    static constexpr ExecuteUnitType::_enumerated UNIT_TYPE = ExecuteUnitType::scalar;
+
     ScalarOperator op{ScalarOperator::add};
 
     int src1_value{0}, src2_value{0}, offset{0};
@@ -93,6 +100,8 @@ struct ScalarInsPayload : public ExecuteInsPayload {
 };
 
 struct CimComputeInsPayload : public ExecuteInsPayload {
+    static constexpr ExecuteUnitType::_enumerated UNIT_TYPE = ExecuteUnitType::cim_compute;
+
     // input info
     int input_addr_byte{0}, input_len{0}, input_bit_width{0};
 
@@ -117,6 +126,8 @@ struct CimComputeInsPayload : public ExecuteInsPayload {
 };
 
 struct CimControlInsPayload : public ExecuteInsPayload {
+    static constexpr ExecuteUnitType::_enumerated UNIT_TYPE = ExecuteUnitType::cim_control;
+
     CimControlOperator op{CimControlOperator::set_activation};
 
     // set activation
@@ -134,6 +145,8 @@ struct CimControlInsPayload : public ExecuteInsPayload {
 };
 
 struct ReduceInsPayload : public ExecuteInsPayload {
+    static constexpr ExecuteUnitType::_enumerated UNIT_TYPE = ExecuteUnitType::reduce;
+
     const ReduceFunctorConfig* func_cfg{nullptr};
 
     int input_bit_width{0}, output_bit_width{0};
@@ -145,4 +158,13 @@ struct ReduceInsPayload : public ExecuteInsPayload {
                                          input_address_byte, output_address_byte, length)
 };
 
+// payloads are tagged by ins.unit_type and only dispatched to the unit of that type, so no rtti is needed to downcast
+template <class InsPayload>
+std::shared_ptr<InsPayload> castInsPayload(const std::shared_ptr<ExecuteInsPayload>& payload) {
+    if (payload == nullptr || payload->ins.unit_type != +InsPayload::UNIT_TYPE) {
+        return nullptr;
+    }
+    return std::static_pointer_cast<InsPayload>(payload);
+}
+
 }  // namespace cimsim
@@ -5,6 +5,7 @@
 #include "reduce_unit.h"
 
 #include "fmt/format.h"
+#include "functional_kernel.h"
 #include "profiler/profiler.h"
 #include "util/log.h"
 #include "util/util.h"
@@ -20,7 +21,9 @@ ReduceFunctorPipelineStage::ReduceFunctorPipelineStage(const sc_module_name& nam
     , pipeline_stage_latency_cycle_(functor_config.latency_cycle / functor_config.pipeline_stage_cnt)
     , functor_energy_counter_(functor_energy_counter)
     , functor_name_(functor_name) {
-    SC_THREAD(processExecute);
+    SC_METHOD(processExecute);
+    sensitive << exec_socket_.start_exec;
+    dont_initialize();
 }
 
 ReduceStageSocket* ReduceFunctorPipelineStage::getExecuteSocket() {
@@ -32,26 +35,19 @@ void ReduceFunctorPipelineStage::setNextStageSocket(ReduceStageSocket* next_stag
 }
 
 void ReduceFunctorPipelineStage::processExecute() {
-    while (true) {
-        exec_socket_.waitUntilStart();
-
-        const auto& payload = exec_socket_.payload;
+    stage_method_.step(exec_socket_, next_stage_socket_, [this](const ReduceStagePayload& payload) {
         CORE_LOG(fmt::format("{} start, pc: {}, ins id: {}, batch: {}", getFullName(), payload.ins_info->ins.pc,
-                             payload.ins_info->ins.ins_id, payload.batch_info->batch_num));
+                             payload.ins_info->ins.ins_id, payload.batch_info.batch_num));
 
         double latency = pipeline_stage_latency_cycle_ * period_ns_;
-        functor_energy_counter_.addDynamicEnergyPJ(latency, dynamic_power_mW_,
+        functor_energy_counter_.addDynamicEnergyPJ(latency, dynamic_power_mW_, 1,
                                                    {.core_id = core_id_,
                                                     .ins_id = payload.ins_info->ins.ins_id,
                                                     .inst_opcode = payload.ins_info->ins.inst_opcode,
                                                     .inst_group_tag = payload.ins_info->ins.inst_group_tag,
                                                     .inst_profiler_operator = functor_name_});
-        wait(latency, SC_NS);
-
-        waitAndStartNextStage(payload, *next_stage_socket_);
-
-        exec_socket_.finish();
-    }
+        return latency;
+    });
 }
 
 ReduceFunctor::ReduceFunctor(const sc_module_name& name, const BaseInfo& base_info,
@@ -70,6 +66,7 @@ ReduceFunctor::ReduceFunctor(const sc_module_name& name, const BaseInfo& base_in
     stage_list_[stage_list_.size() - 1]->setNextStageSocket(next_stage_socket);
 
     functor_energy_counter_.setStaticPowerMW(functor_config_.static_power_mW);
+    functor_energy_counter_.addDynamicPowerParam(functor_config_.dynamic_power_mW);
 }
 
 ReduceStageSocket* ReduceFunctor::getExecuteSocket() const {
@@ -88,8 +85,11 @@ ReduceUnit::ReduceUnit(const sc_module_name& name, const ReduceUnitConfig& confi
                        Clock* clk)
     : ExecuteUnit(name, base_info, clk, ExecuteUnitType::reduce), config_(config) {
     SC_THREAD(processIssue)
+    setThreadStackSize();
     SC_THREAD(processReadStage)
+    setThreadStackSize();
     SC_THREAD(processWriteStage)
+    setThreadStackSize();
 
     for (const auto& functor_config : config_.functor_list) {
         auto functor = std::make_shared<ReduceFunctor>(fmt::format("Functor_{}", functor_config.name).c_str(),
@@ -115,15 +115,15 @@ void ReduceUnit::processIssue() {
         int process_times = IntDivCeil(payload->length, payload->func_cfg->reduce_input_cnt);
         ReduceStagePayload stage_payload{.ins_info = std::make_shared<ReduceInstructionInfo>(ins_info)};
         for (int batch = 0; batch < process_times; batch++) {
-            stage_payload.batch_info = std::make_shared<ReduceBatchInfo>(ReduceBatchInfo{
+            stage_payload.batch_info = ReduceBatchInfo{
                 .batch_vector_len = (batch == process_times - 1)
                                         ? (payload->length - batch * payload->func_cfg->reduce_input_cnt)
                                         : payload->func_cfg->reduce_input_cnt,
                 .batch_num = batch,
-                .last_batch = (batch == process_times - 1)});
+                .last_batch = (batch == process_times - 1)};
             waitAndStartNextStage(stage_payload, read_stage_socket_);
 
-            if (!stage_payload.batch_info->last_batch) {
+            if (!stage_payload.batch_info.last_batch) {
                 wait(cur_ins_next_batch_);
             }
         }
@@ -136,20 +136,23 @@ void ReduceUnit::processReadStage() {
     while (true) {
         read_stage_socket_.waitUntilStart();
 
-        const auto& payload = read_stage_socket_.payload;
+        auto& payload = read_stage_socket_.payload;
         CORE_LOG(fmt::format("Reduce read start, pc: {}, ins id: {}, batch: {}", payload.ins_info->ins.pc,
-                             payload.ins_info->ins.ins_id, payload.batch_info->batch_num));
+                             payload.ins_info->ins.ins_id, payload.batch_info.batch_num));
 
         int address_byte = payload.ins_info->input_start_address_byte +
-                           (payload.batch_info->batch_num * payload.ins_info->functor_config->input_bit_width *
+                           (payload.batch_info.batch_num * payload.ins_info->functor_config->input_bit_width *
                             payload.ins_info->functor_config->reduce_input_cnt / BYTE_TO_BIT);
         int size_byte =
-            payload.ins_info->functor_config->input_bit_width * payload.batch_info->batch_vector_len / BYTE_TO_BIT;
-        memory_socket_.readLocal(payload.ins_info->ins, address_byte, size_byte);
+            payload.ins_info->functor_config->input_bit_width * payload.batch_info.batch_vector_len / BYTE_TO_BIT;
+        auto data = memory_socket_.readLocal(payload.ins_info->ins, address_byte, size_byte);
+        if (data_mode_ == +DataMode::real_data) {
+            payload.data = std::make_shared<std::vector<uint8_t>>(std::move(data));
+        }
 
         waitAndStartNextStage(payload, *(executing_functor_->getExecuteSocket()));
 
-        if (payload.ins_info->use_pipeline && !payload.batch_info->last_batch) {
+        if (payload.ins_info->use_pipeline && !payload.batch_info.last_batch) {
             cur_ins_next_batch_.notify();
         }
 
@@ -159,17 +162,33 @@ void ReduceUnit::processReadStage() {
 
 void ReduceUnit::processWriteStage() {
     int output_cumulative_cnt{0}, write_cumulative_cnt{0};
+    std::vector<uint8_t> output_data;
     while (true) {
         write_stage_socket_.waitUntilStart();
 
         const auto& payload = write_stage_socket_.payload;
+        const auto& functor_config = *payload.ins_info->functor_config;
         output_cumulative_cnt++;
 
-        if (output_cumulative_cnt == payload.ins_info->write_batch_vector_len || payload.batch_info->last_batch) {
+        bool has_output_data = data_mode_ == +DataMode::real_data && payload.data != nullptr;
+        if (has_output_data) {
+            if (output_cumulative_cnt == 1) {
+                output_data.assign(
+                    IntDivCeil(functor_config.output_bit_width * payload.ins_info->write_batch_vector_len, BYTE_TO_BIT),
+                    0);
+            }
+            has_output_data = runReduceKernel(
+                functor_config.funct,
+                KernelOperand{.data = payload.data->data(), .bit_width = functor_config.input_bit_width},
+                payload.batch_info.batch_vector_len, output_data.data(), functor_config.output_bit_width,
+                output_cumulative_cnt - 1);
+        }
+
+        if (output_cumulative_cnt == payload.ins_info->write_batch_vector_len || payload.batch_info.last_batch) {
             CORE_LOG(fmt::format("Reduce write start, pc: {}, ins id: {}, batch: {}", payload.ins_info->ins.pc,
-                                 payload.ins_info->ins.ins_id, payload.batch_info->batch_num));
+                                 payload.ins_info->ins.ins_id, payload.batch_info.batch_num));
 
-            if (payload.batch_info->last_batch) {
+            if (payload.batch_info.last_batch) {
                 releaseResource(payload.ins_info->ins.ins_id);
             }
 
@@ -177,20 +196,25 @@ void ReduceUnit::processWriteStage() {
                                (write_cumulative_cnt * payload.ins_info->functor_config->output_bit_width *
                                 payload.ins_info->write_batch_vector_len / BYTE_TO_BIT);
             int size_byte = payload.ins_info->functor_config->output_bit_width * output_cumulative_cnt / BYTE_TO_BIT;
-            memory_socket_.writeLocal(payload.ins_info->ins, address_byte, size_byte, {});
+            if (has_output_data) {
+                output_data.resize(size_byte);
+                memory_socket_.writeLocal(payload.ins_info->ins, address_byte, size_byte, std::move(output_data));
+            } else {
+                memory_socket_.writeLocal(payload.ins_info->ins, address_byte, size_byte, {});
+            }
 
             CORE_LOG(fmt::format("Reduce write end, pc: {}, ins id: {}, batch: {}, the {}th writting, data cnt: {}",
-                                 payload.ins_info->ins.pc, payload.ins_info->ins.ins_id, payload.batch_info->batch_num,
+                                 payload.ins_info->ins.pc, payload.ins_info->ins.ins_id, payload.batch_info.batch_num,
                                  write_cumulative_cnt + 1, output_cumulative_cnt));
             output_cumulative_cnt = 0;
             write_cumulative_cnt++;
         }
 
-        if (!payload.ins_info->use_pipeline && !payload.batch_info->last_batch) {
+        if (!payload.ins_info->use_pipeline && !payload.batch_info.last_batch) {
             cur_ins_next_batch_.notify();
         }
 
-        if (payload.batch_info->last_batch) {
+        if (payload.batch_info.last_batch) {
             write_cumulative_cnt = 0;
             finishInstruction();
         }
@@ -200,7 +224,7 @@ void ReduceUnit::processWriteStage() {
 }
 
 ResourceAllocatePayload ReduceUnit::getDataConflictInfo(const std::shared_ptr<ExecuteInsPayload>& payload) {
-    return getDataConflictInfo(*std::dynamic_pointer_cast<ReduceInsPayload>(payload));
+    return getDataConflictInfo(*castInsPayload<ReduceInsPayload>(payload));
 }
 
 ResourceAllocatePayload ReduceUnit::getDataConflictInfo(const ReduceInsPayload& payload) const {
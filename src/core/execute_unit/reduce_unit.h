@@ -29,7 +29,8 @@ struct ReduceBatchInfo {
 
 struct ReduceStagePayload {
     std::shared_ptr<ReduceInstructionInfo> ins_info;
-    std::shared_ptr<ReduceBatchInfo> batch_info;
+    ReduceBatchInfo batch_info{};
+    std::shared_ptr<std::vector<uint8_t>> data{};  // only in real data mode
 };
 
 using ReduceStageSocket = SubmoduleSocket<ReduceStagePayload>;
@@ -45,10 +46,10 @@ public:
     ReduceStageSocket* getExecuteSocket();
     void setNextStageSocket(ReduceStageSocket* next_stage_socket);
 
-    [[noreturn]] void processExecute();
+    void processExecute();
 
 private:
-    const double dynamic_power_mW_{1.0};
+    const double& dynamic_power_mW_;
     const int pipeline_stage_latency_cycle_{1};
 
     ReduceStageSocket exec_socket_;
@@ -56,6 +57,8 @@ private:
 
     EnergyCounter& functor_energy_counter_;
     const std::string& functor_name_;
+
+    SubmoduleStageMethod<ReduceStagePayload> stage_method_;
 };
 
 class ReduceFunctor : public BaseModule {
@@ -14,14 +14,18 @@ ScalarUnit::ScalarUnit(const sc_module_name &name, const ScalarUnitConfig &confi
                        Clock *clk)
     : ExecuteUnit(name, base_info, clk, ExecuteUnitType::scalar), config_(config) {
     SC_THREAD(process)
+    setThreadStackSize();
     SC_THREAD(executeInst)
+    setThreadStackSize();
 
     double scalar_functors_total_static_power_mW = config_.default_functor_static_power_mW;
     for (const auto &scalar_functor_config : config_.functor_list) {
         scalar_functors_total_static_power_mW += scalar_functor_config.static_power_mW;
         functor_config_map_.emplace(scalar_functor_config.inst_name, &scalar_functor_config);
+        energy_counter_.addDynamicPowerParam(scalar_functor_config.dynamic_power_mW);
     }
     energy_counter_.setStaticPowerMW(scalar_functors_total_static_power_mW);
+    energy_counter_.addDynamicPowerParam(config_.default_functor_dynamic_power_mW);
 }
 
 void ScalarUnit::process() {
@@ -36,9 +40,10 @@ void ScalarUnit::process() {
 
         // statistic energy
         auto functor_found = functor_config_map_.find(payload->op._to_string());
-        double dynamic_power_mW = functor_found == functor_config_map_.end() ? config_.default_functor_dynamic_power_mW
-                                                                             : functor_found->second->dynamic_power_mW;
-        energy_counter_.addDynamicEnergyPJ(period_ns_, dynamic_power_mW,
+        const double &dynamic_power_mW = functor_found == functor_config_map_.end()
+                                             ? config_.default_functor_dynamic_power_mW
+                                             : functor_found->second->dynamic_power_mW;
+        energy_counter_.addDynamicEnergyPJ(period_ns_, dynamic_power_mW, 1,
                                            {.core_id = core_id_,
                                             .ins_id = payload->ins.ins_id,
                                             .inst_opcode = payload->ins.inst_opcode,
@@ -92,76 +97,6 @@ void ScalarUnit::executeInst() {
 RegUnitWritePayload ScalarUnit::executeAndWriteRegister(const cimsim::ScalarInsPayload &payload) {
     RegUnitWritePayload write_payload{.id = payload.dst_reg, .special = false};
     switch (payload.op) {
-        case ScalarOperator::add: {
-            write_payload.value = payload.src1_value + payload.src2_value;
-            break;
-        }
-        case ScalarOperator::sub: {
-            write_payload.value = payload.src1_value - payload.src2_value;
-            break;
-        }
-        case ScalarOperator::mul: {
-            write_payload.value = payload.src1_value * payload.src2_value;
-            break;
-        }
-        case ScalarOperator::div: {
-            write_payload.value = payload.src1_value / payload.src2_value;
-            break;
-        }
-        case ScalarOperator::sll: {
-            write_payload.value = (payload.src1_value << payload.src2_value);
-            break;
-        }
-        case ScalarOperator::srl: {
-            unsigned int result =
-                (static_cast<unsigned int>(payload.src1_value) >> static_cast<unsigned int>(payload.src2_value));
-            write_payload.value = static_cast<int>(result);
-            break;
-        }
-        case ScalarOperator::sra: {
-            write_payload.value = (payload.src1_value >> payload.src2_value);
-            break;
-        }
-        case ScalarOperator::mod: {
-            write_payload.value = payload.src1_value % payload.src2_value;
-            break;
-        }
-        case ScalarOperator::min: {
-            write_payload.value = std::min(payload.src1_value, payload.src2_value);
-            break;
-        }
-        case ScalarOperator::max: {
-            write_payload.value = std::max(payload.src1_value, payload.src2_value);
-            break;
-        }
-        case ScalarOperator::s_and: {
-            write_payload.value = (payload.src1_value & payload.src2_value);
-            break;
-        }
-        case ScalarOperator::s_or: {
-            write_payload.value = (payload.src1_value | payload.src2_value);
-            break;
-        }
-        case ScalarOperator::eq: {
-            write_payload.value = (payload.src1_value == payload.src2_value) ? 1 : 0;
-            break;
-        }
-        case ScalarOperator::ne: {
-            write_payload.value = (payload.src1_value != payload.src2_value) ? 1 : 0;
-            break;
-        }
-        case ScalarOperator::gt: {
-            write_payload.value = (payload.src1_value > payload.src2_value) ? 1 : 0;
-            break;
-        }
-        case ScalarOperator::lt: {
-            write_payload.value = (payload.src1_value < payload.src2_value) ? 1 : 0;
-            break;
-        }
-        case ScalarOperator::lui: {
-            write_payload.value = (payload.src2_value << 16);
-            break;
-        }
         case ScalarOperator::load: {
             int address_byte = payload.src1_value + payload.offset;
             int size_byte = WORD_BYTE_SIZE;
@@ -182,10 +117,37 @@ RegUnitWritePayload ScalarUnit::executeAndWriteRegister(const cimsim::ScalarInsP
             break;
         }
         default: {
+            write_payload.value = calculate(payload.op, payload.src1_value, payload.src2_value);
             break;
         }
     }
     return write_payload;
 }
 
+int ScalarUnit::calculate(ScalarOperator op, int src1_value, int src2_value) {
+    switch (op) {
+        case ScalarOperator::add: return src1_value + src2_value;
+        case ScalarOperator::sub: return src1_value - src2_value;
+        case ScalarOperator::mul: return src1_value * src2_value;
+        case ScalarOperator::div: return src1_value / src2_value;
+        case ScalarOperator::sll: return (src1_value << src2_value);
+        case ScalarOperator::srl: {
+            unsigned int result = (static_cast<unsigned int>(src1_value) >> static_cast<unsigned int>(src2_value));
+            return static_cast<int>(result);
+        }
+        case ScalarOperator::sra: return (src1_value >> src2_value);
+        case ScalarOperator::mod: return src1_value % src2_value;
+        case ScalarOperator::min: return std::min(src1_value, src2_value);
+        case ScalarOperator::max: return std::max(src1_value, src2_value);
+        case ScalarOperator::s_and: return (src1_value & src2_value);
+        case ScalarOperator::s_or: return (src1_value | src2_value);
+        case ScalarOperator::eq: return (src1_value == src2_value) ? 1 : 0;
+        case ScalarOperator::ne: return (src1_value != src2_value) ? 1 : 0;
+        case ScalarOperator::gt: return (src1_value > src2_value) ? 1 : 0;
+        case ScalarOperator::lt: return (src1_value < src2_value) ? 1 : 0;
+        case ScalarOperator::lui: return (src2_value << 16);
+        default: return 0;
+    }
+}
+
 }  // namespace cimsim
@@ -21,6 +21,9 @@ public:
 
     void bindRegUnit(RegUnit* reg_unit);
 
+    // result of arithmetic, logic and compare operators
+    static int calculate(ScalarOperator op, int src1_value, int src2_value);
+
 private:
     [[noreturn]] void process();
     [[noreturn]] void executeInst();
@@ -5,6 +5,7 @@
 #include "simd_unit.h"
 
 #include "fmt/format.h"
+#include "functional_kernel.h"
 #include "util/log.h"
 #include "util/util.h"
 
@@ -19,7 +20,9 @@ SIMDFunctorPipelineStage::SIMDFunctorPipelineStage(const sc_module_name& name, c
     , pipeline_stage_latency_cycle_(config.latency_cycle / config.pipeline_stage_cnt)
     , functor_energy_counter_(functor_energy_counter)
     , functor_name_(functor_name) {
-    SC_THREAD(processExecute);
+    SC_METHOD(processExecute);
+    sensitive << exec_socket_.start_exec;
+    dont_initialize();
 }
 
 SIMDStageSocket* SIMDFunctorPipelineStage::getExecuteSocket() {
@@ -31,27 +34,20 @@ void SIMDFunctorPipelineStage::setNextStageSocket(SIMDStageSocket* next_stage_so
 }
 
 void SIMDFunctorPipelineStage::processExecute() {
-    while (true) {
-        exec_socket_.waitUntilStart();
-
-        const auto& payload = exec_socket_.payload;
+    stage_method_.step(exec_socket_, next_stage_socket_, [this](const SIMDStagePayload& payload) {
         CORE_LOG(fmt::format("{} start, pc: {}, ins id: {}, batch: {}", getFullName(), payload.ins_info->ins.pc,
-                             payload.ins_info->ins.ins_id, payload.batch_info->batch_num));
+                             payload.ins_info->ins.ins_id, payload.batch_info.batch_num));
 
-        double dynamic_power_mW = dynamic_power_per_functor_mW_ * payload.batch_info->batch_vector_len;
         double latency = pipeline_stage_latency_cycle_ * period_ns_;
-        functor_energy_counter_.addDynamicEnergyPJ(latency, dynamic_power_mW,
+        functor_energy_counter_.addDynamicEnergyPJ(latency, dynamic_power_per_functor_mW_,
+                                                   payload.batch_info.batch_vector_len,
                                                    {.core_id = core_id_,
                                                     .ins_id = payload.ins_info->ins.ins_id,
                                                     .inst_opcode = payload.ins_info->ins.inst_opcode,
                                                     .inst_group_tag = payload.ins_info->ins.inst_group_tag,
                                                     .inst_profiler_operator = functor_name_});
-        wait(latency, SC_NS);
-
-        waitAndStartNextStage(payload, *next_stage_socket_);
-
-        exec_socket_.finish();
-    }
+        return latency;
+    });
 }
 
 SIMDFunctor::SIMDFunctor(const sc_module_name& name, const BaseInfo& base_info, const SIMDFunctorConfig& functor_config,
@@ -71,6 +67,7 @@ SIMDFunctor::SIMDFunctor(const sc_module_name& name, const BaseInfo& base_info,
     stage_list_[stage_list_.size() - 1]->setNextStageSocket(next_stage_socket);
 
     functor_energy_counter_.setStaticPowerMW(functor_config_.static_power_per_functor_mW * functor_config_.functor_cnt);
+    functor_energy_counter_.addDynamicPowerParam(functor_config_.dynamic_power_per_functor_mW);
 }
 
 SIMDStageSocket* SIMDFunctor::getExecuteSocket() const {
@@ -88,8 +85,11 @@ EnergyCounter* SIMDFunctor::getEnergyCounterPtr() {
 SIMDUnit::SIMDUnit(const sc_module_name& name, const SIMDUnitConfig& config, const BaseInfo& base_info, Clock* clk)
     : ExecuteUnit(name, base_info, clk, ExecuteUnitType::simd), config_(config) {
     SC_THREAD(processIssue)
+    setThreadStackSize();
     SC_THREAD(processReadStage)
+    setThreadStackSize();
     SC_THREAD(processWriteStage)
+    setThreadStackSize();
 
     for (const auto& functor_config : config_.functor_list) {
         auto functor = std::make_shared<SIMDFunctor>(fmt::format("Functor_{}", functor_config.name).c_str(), base_info,
@@ -105,7 +105,7 @@ void SIMDUnit::processIssue() {
         auto payload = waitForExecuteAndGetPayload<SIMDInsPayload>();
 
         // Decode instruction
-        const auto& [ins_info, conflict_payload] = decodeAndGetInfo(*payload);
+        auto [ins_info, conflict_payload] = decodeAndGetInfo(*payload);
         ports_.resource_allocate_.write(conflict_payload);
 
         if (executing_functor_ == nullptr || executing_functor_->getFunctorConfig() != payload->func_cfg) {
@@ -113,23 +113,26 @@ void SIMDUnit::processIssue() {
         }
 
         for (const auto& scalar_input : ins_info.scalar_inputs) {
-            memory_socket_.readLocal(ins_info.ins, scalar_input.start_address_byte,
-                                     scalar_input.data_bit_width / BYTE_TO_BIT);
+            auto scalar_data = memory_socket_.readLocal(ins_info.ins, scalar_input.start_address_byte,
+                                                        scalar_input.data_bit_width / BYTE_TO_BIT);
+            if (data_mode_ == +DataMode::real_data) {
+                ins_info.scalar_data.emplace_back(std::move(scalar_data));
+            }
         }
 
         int vector_total_len = ins_info.vector_inputs.empty() ? 1 : payload->len;
         int process_times = IntDivCeil(vector_total_len, payload->func_cfg->functor_cnt);
         SIMDStagePayload stage_payload{.ins_info = std::make_shared<SIMDInstructionInfo>(ins_info)};
         for (int batch = 0; batch < process_times; batch++) {
-            stage_payload.batch_info = std::make_shared<SIMDBatchInfo>(
-                SIMDBatchInfo{.batch_vector_len = (batch == process_times - 1)
-                                                      ? (vector_total_len - batch * payload->func_cfg->functor_cnt)
-                                                      : payload->func_cfg->functor_cnt,
-                              .batch_num = batch,
-                              .last_batch = (batch == process_times - 1)});
+            stage_payload.batch_info = SIMDBatchInfo{
+                .batch_vector_len = (batch == process_times - 1)
+                                        ? (vector_total_len - batch * payload->func_cfg->functor_cnt)
+                                        : payload->func_cfg->functor_cnt,
+                .batch_num = batch,
+                .last_batch = (batch == process_times - 1)};
             waitAndStartNextStage(stage_payload, read_stage_socket_);
 
-            if (!stage_payload.batch_info->last_batch) {
+            if (!stage_payload.batch_info.last_batch) {
                 wait(cur_ins_next_batch_);
             }
         }
@@ -142,21 +145,27 @@ void SIMDUnit::processReadStage() {
     while (true) {
         read_stage_socket_.waitUntilStart();
 
-        const auto& payload = read_stage_socket_.payload;
+        auto& payload = read_stage_socket_.payload;
         CORE_LOG(fmt::format("SIMD read start, pc: {}, ins id: {}, batch: {}", payload.ins_info->ins.pc,
-                             payload.ins_info->ins.ins_id, payload.batch_info->batch_num));
+                             payload.ins_info->ins.ins_id, payload.batch_info.batch_num));
 
         for (const auto& vector_input : payload.ins_info->vector_inputs) {
             int address_byte =
-                vector_input.start_address_byte + (payload.batch_info->batch_num * vector_input.data_bit_width *
+                vector_input.start_address_byte + (payload.batch_info.batch_num * vector_input.data_bit_width *
                                                    payload.ins_info->functor_cnt / BYTE_TO_BIT);
-            int size_byte = vector_input.data_bit_width * payload.batch_info->batch_vector_len / BYTE_TO_BIT;
-            memory_socket_.readLocal(payload.ins_info->ins, address_byte, size_byte);
+            int size_byte = vector_input.data_bit_width * payload.batch_info.batch_vector_len / BYTE_TO_BIT;
+            auto vector_data = memory_socket_.readLocal(payload.ins_info->ins, address_byte, size_byte);
+            if (data_mode_ == +DataMode::real_data) {
+                if (payload.vector_data == nullptr) {
+                    payload.vector_data = std::make_shared<std::vector<std::vector<uint8_t>>>();
+                }
+                payload.vector_data->emplace_back(std::move(vector_data));
+            }
         }
 
         waitAndStartNextStage(payload, *(executing_functor_->getExecuteSocket()));
 
-        if (payload.ins_info->use_pipeline && !payload.batch_info->last_batch) {
+        if (payload.ins_info->use_pipeline && !payload.batch_info.last_batch) {
             cur_ins_next_batch_.notify();
         }
 
@@ -170,26 +179,27 @@ void SIMDUnit::processWriteStage() {
 
         const auto& payload = write_stage_socket_.payload;
         CORE_LOG(fmt::format("SIMD write start, pc: {}, ins id: {}, batch: {}", payload.ins_info->ins.pc,
-                             payload.ins_info->ins.ins_id, payload.batch_info->batch_num));
+                             payload.ins_info->ins.ins_id, payload.batch_info.batch_num));
 
-        if (payload.batch_info->last_batch) {
+        if (payload.batch_info.last_batch) {
             releaseResource(payload.ins_info->ins.ins_id);
         }
 
         int address_byte = payload.ins_info->output.start_address_byte +
-                           (payload.batch_info->batch_num * payload.ins_info->output.data_bit_width *
+                           (payload.batch_info.batch_num * payload.ins_info->output.data_bit_width *
                             payload.ins_info->functor_cnt / BYTE_TO_BIT);
-        int size_byte = payload.ins_info->output.data_bit_width * payload.batch_info->batch_vector_len / BYTE_TO_BIT;
-        memory_socket_.writeLocal(payload.ins_info->ins, address_byte, size_byte, {});
+        int size_byte = payload.ins_info->output.data_bit_width * payload.batch_info.batch_vector_len / BYTE_TO_BIT;
+        memory_socket_.writeLocal(payload.ins_info->ins, address_byte, size_byte,
+                                  computeOutputData(payload, size_byte));
 
         CORE_LOG(fmt::format("simd write end, pc: {}, ins id: {}, batch: {}", payload.ins_info->ins.pc,
-                             payload.ins_info->ins.ins_id, payload.batch_info->batch_num));
+                             payload.ins_info->ins.ins_id, payload.batch_info.batch_num));
 
-        if (!payload.ins_info->use_pipeline && !payload.batch_info->last_batch) {
+        if (!payload.ins_info->use_pipeline && !payload.batch_info.last_batch) {
             cur_ins_next_batch_.notify();
         }
 
-        if (payload.batch_info->last_batch) {
+        if (payload.batch_info.last_batch) {
             finishInstruction();
         }
 
@@ -222,6 +232,7 @@ std::pair<SIMDInstructionInfo, ResourceAllocatePayload> SIMDUnit::decodeAndGetIn
     bool use_pipeline =
         config_.pipeline && !conflict_payload.write_memory_id.intersectionWith(conflict_payload.read_memory_id);
     SIMDInstructionInfo ins_info{.ins = payload.ins,
+                                 .ins_cfg = payload.ins_cfg,
                                  .scalar_inputs = scalar_inputs,
                                  .vector_inputs = vector_inputs,
                                  .output = output,
@@ -231,6 +242,30 @@ std::pair<SIMDInstructionInfo, ResourceAllocatePayload> SIMDUnit::decodeAndGetIn
     return {ins_info, conflict_payload};
 }
 
+std::vector<uint8_t> SIMDUnit::computeOutputData(const SIMDStagePayload& payload, int size_byte) const {
+    if (data_mode_ != +DataMode::real_data) {
+        return {};
+    }
+
+    const auto& ins_info = *payload.ins_info;
+    std::vector<KernelOperand> inputs;
+    int vector_index = 0, scalar_index = 0;
+    for (unsigned int i = 0; i < ins_info.ins_cfg->input_cnt; i++) {
+        bool scalar = ins_info.ins_cfg->inputs_type[i] == +SIMDInputType::scalar;
+        const auto& info = scalar ? ins_info.scalar_inputs[scalar_index] : ins_info.vector_inputs[vector_index];
+        const auto& data =
+            scalar ? ins_info.scalar_data[scalar_index++] : (*payload.vector_data)[vector_index++];
+        inputs.emplace_back(KernelOperand{.data = data.data(), .bit_width = info.data_bit_width, .scalar = scalar});
+    }
+
+    std::vector<uint8_t> output_data(size_byte, 0);
+    if (!runSIMDKernel(ins_info.ins_cfg->opcode, inputs, output_data.data(), ins_info.output.data_bit_width,
+                       payload.batch_info.batch_vector_len)) {
+        return {};
+    }
+    return output_data;
+}
+
 ResourceAllocatePayload SIMDUnit::getDataConflictInfo(const SIMDInsPayload& payload) const {
     ResourceAllocatePayload cur_ins_conflict_info{.ins_id = payload.ins.ins_id, .unit_type = ExecuteUnitType::simd};
     for (unsigned int i = 0; i < payload.ins_cfg->input_cnt; i++) {
@@ -242,7 +277,7 @@ ResourceAllocatePayload SIMDUnit::getDataConflictInfo(const SIMDInsPayload& payl
 }
 
 ResourceAllocatePayload SIMDUnit::getDataConflictInfo(const std::shared_ptr<ExecuteInsPayload>& payload) {
-    return getDataConflictInfo(*std::dynamic_pointer_cast<SIMDInsPayload>(payload));
+    return getDataConflictInfo(*castInsPayload<SIMDInsPayload>(payload));
 }
 
 }  // namespace cimsim
@@ -22,6 +22,7 @@ struct SIMDInputOutputInfo {
 
 struct SIMDInstructionInfo {
     InstructionPayload ins{};
+    const SIMDInstructionConfig* ins_cfg{nullptr};
 
     std::vector<SIMDInputOutputInfo> scalar_inputs{};
     std::vector<SIMDInputOutputInfo> vector_inputs{};
@@ -29,6 +30,8 @@ struct SIMDInstructionInfo {
 
     int functor_cnt{0};
     bool use_pipeline{false};
+
+    std::vector<std::vector<uint8_t>> scalar_data{};  // only in real data mode
 };
 
 struct SIMDBatchInfo {
@@ -39,7 +42,8 @@ struct SIMDBatchInfo {
 
 struct SIMDStagePayload {
     std::shared_ptr<SIMDInstructionInfo> ins_info;
-    std::shared_ptr<SIMDBatchInfo> batch_info;
+    SIMDBatchInfo batch_info{};
+    std::shared_ptr<std::vector<std::vector<uint8_t>>> vector_data{};  // only in real data mode
 };
 
 using SIMDStageSocket = SubmoduleSocket<SIMDStagePayload>;
@@ -54,10 +58,10 @@ public:
     SIMDStageSocket* getExecuteSocket();
     void setNextStageSocket(SIMDStageSocket* next_stage_socket);
 
-    [[noreturn]] void processExecute();
+    void processExecute();
 
 private:
-    const double dynamic_power_per_functor_mW_{1.0};
+    const double& dynamic_power_per_functor_mW_;
     const int pipeline_stage_latency_cycle_{1};
 
     SIMDStageSocket exec_socket_;
@@ -65,6 +69,8 @@ private:
 
     EnergyCounter& functor_energy_counter_;
     const std::string& functor_name_;
+
+    SubmoduleStageMethod<SIMDStagePayload> stage_method_;
 };
 
 class SIMDFunctor : public BaseModule {
@@ -100,6 +106,7 @@ public:
 
 private:
     std::pair<SIMDInstructionInfo, ResourceAllocatePayload> decodeAndGetInfo(const SIMDInsPayload& payload) const;
+    std::vector<uint8_t> computeOutputData(const SIMDStagePayload& payload, int size_byte) const;
 
 private:
     const SIMDUnitConfig& config_;
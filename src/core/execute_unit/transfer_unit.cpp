@@ -4,6 +4,8 @@
 
 #include "transfer_unit.h"
 
+#include <stdexcept>
+
 #include "fmt/format.h"
 #include "util/log.h"
 #include "util/util.h"
@@ -14,8 +16,11 @@ LocalTransferDataPath::LocalTransferDataPath(const sc_module_name& name, const B
                                              TransferUnit& transfer_unit, bool pipeline)
     : BaseModule(name, base_info), transfer_unit_(transfer_unit), pipeline_(pipeline) {
     SC_THREAD(processIssue)
+    setThreadStackSize();
     SC_THREAD(processReadStage)
+    setThreadStackSize();
     SC_THREAD(processWriteStage)
+    setThreadStackSize();
 }
 
 void LocalTransferDataPath::processIssue() {
@@ -25,16 +30,16 @@ void LocalTransferDataPath::processIssue() {
         auto& payload = exec_socket_.payload;
         LocalTransferStagePayload stage_payload{.ins_info = payload.ins_info};
         for (int batch = 0; batch < payload.process_times; batch++) {
-            stage_payload.batch_info = std::make_shared<LocalTransferBatchInfo>(LocalTransferBatchInfo{
+            stage_payload.batch_info = LocalTransferBatchInfo{
                 .batch_num = batch,
                 .batch_data_size_byte =
                     (batch == payload.process_times - 1)
                         ? payload.data_size_byte - batch * payload.ins_info->batch_max_data_size_byte
                         : payload.ins_info->batch_max_data_size_byte,
-                .last_batch = (batch == payload.process_times - 1)});
+                .last_batch = (batch == payload.process_times - 1)};
             waitAndStartNextStage(stage_payload, read_stage_socket_);
 
-            if (!stage_payload.batch_info->last_batch) {
+            if (!stage_payload.batch_info.last_batch) {
                 wait(cur_ins_next_batch_);
             }
         }
@@ -49,16 +54,19 @@ void LocalTransferDataPath::processReadStage() {
 
         auto& payload = read_stage_socket_.payload;
         CORE_LOG(fmt::format("{} read start, pc: {}, batch: {}", getName(), payload.ins_info->ins.pc,
-                             payload.batch_info->batch_num));
+                             payload.batch_info.batch_num));
 
         int address_byte = payload.ins_info->src_start_address_byte +
-                           payload.batch_info->batch_num * payload.ins_info->batch_max_data_size_byte;
-        int size_byte = payload.batch_info->batch_data_size_byte;
-        payload.batch_info->data = memory_socket_.readLocal(payload.ins_info->ins, address_byte, size_byte);
+                           payload.batch_info.batch_num * payload.ins_info->batch_max_data_size_byte;
+        int size_byte = payload.batch_info.batch_data_size_byte;
+        auto data = memory_socket_.readLocal(payload.ins_info->ins, address_byte, size_byte);
+        if (data_mode_ == +DataMode::real_data) {
+            payload.batch_info.data = std::make_shared<std::vector<uint8_t>>(std::move(data));
+        }
 
         waitAndStartNextStage(payload, write_stage_socket_);
 
-        if (!payload.batch_info->last_batch && payload.ins_info->use_pipeline) {
+        if (!payload.batch_info.last_batch && payload.ins_info->use_pipeline) {
             cur_ins_next_batch_.notify();
         }
 
@@ -72,25 +80,29 @@ void LocalTransferDataPath::processWriteStage() {
 
         const auto& payload = write_stage_socket_.payload;
         CORE_LOG(fmt::format("{} write start, pc: {}, batch: {}", getName(), payload.ins_info->ins.pc,
-                             payload.batch_info->batch_num));
+                             payload.batch_info.batch_num));
 
-        if (payload.batch_info->last_batch) {
+        if (payload.batch_info.last_batch) {
             transfer_unit_.releaseResource(payload.ins_info->ins.ins_id);
         }
 
         int address_byte = payload.ins_info->dst_start_address_byte +
-                           payload.batch_info->batch_num * payload.ins_info->batch_max_data_size_byte;
-        int size_byte = payload.batch_info->batch_data_size_byte;
-        memory_socket_.writeLocal(payload.ins_info->ins, address_byte, size_byte, payload.batch_info->data);
+                           payload.batch_info.batch_num * payload.ins_info->batch_max_data_size_byte;
+        int size_byte = payload.batch_info.batch_data_size_byte;
+        std::vector<uint8_t> data;
+        if (payload.batch_info.data != nullptr) {
+            data = std::move(*payload.batch_info.data);
+        }
+        memory_socket_.writeLocal(payload.ins_info->ins, address_byte, size_byte, std::move(data));
 
         CORE_LOG(fmt::format("{} write end, pc: {}, batch: {}", getName(), payload.ins_info->ins.pc,
-                             payload.batch_info->batch_num));
+                             payload.batch_info.batch_num));
 
-        if (!payload.batch_info->last_batch && !payload.ins_info->use_pipeline) {
+        if (!payload.batch_info.last_batch && !payload.ins_info->use_pipeline) {
             cur_ins_next_batch_.notify();
         }
 
-        if (payload.batch_info->last_batch) {
+        if (payload.batch_info.last_batch) {
             transfer_unit_.finishInstruction();
         }
 
@@ -103,11 +115,14 @@ void LocalTransferDataPath::bindLocalMemoryUnit(MemoryUnit* local_memory_unit) {
 }
 
 GlobalTransferDataPath::GlobalTransferDataPath(const sc_module_name& name, const BaseInfo& base_info,
-                                               TransferUnit& transfer_unit)
-    : BaseModule(name, base_info), transfer_unit_(transfer_unit) {
+                                               TransferUnit& transfer_unit, TransmitSocket& transmit_socket)
+    : BaseModule(name, base_info), transfer_unit_(transfer_unit), transmit_socket_(transmit_socket) {
     SC_THREAD(processIssue)
+    setThreadStackSize();
     SC_THREAD(processReadStage)
+    setThreadStackSize();
     SC_THREAD(processWriteStage)
+    setThreadStackSize();
 }
 
 void GlobalTransferDataPath::processIssue() {
@@ -119,8 +134,12 @@ void GlobalTransferDataPath::processIssue() {
         if (payload.ins_info->type == +TransferType::send) {
             transmit_socket_.sendHandshake(payload.ins_info->ins, payload.ins_info->dst_id,
                                            payload.ins_info->transfer_id_tag);
+        } else if (payload.ins_info->type == +TransferType::multicast) {
+            transmit_socket_.multicastHandshake(payload.ins_info->ins, payload.ins_info->multicast_dst_id_list,
+                                                payload.ins_info->transfer_id_tag);
         } else if (payload.ins_info->type == +TransferType::receive) {
-            transmit_socket_.receiveHandshake(payload.ins_info->src_id, payload.ins_info->transfer_id_tag);
+            transmit_socket_.receiveHandshake(payload.ins_info->ins, payload.ins_info->src_id,
+                                              payload.ins_info->transfer_id_tag);
         }
 
         GlobalTransferStagePayload stage_payload{.ins_info = payload.ins_info};
@@ -139,12 +158,17 @@ void GlobalTransferDataPath::processReadStage() {
 
         int address_byte = payload.ins_info->src_start_address_byte;
         int size_byte = payload.ins_info->data_size_byte;
+        std::vector<uint8_t> data;
         if (auto type = payload.ins_info->type; type == +TransferType::receive) {
-            transmit_socket_.receiveData(payload.ins_info->ins, payload.ins_info->src_id);
+            data = transmit_socket_.receiveData(payload.ins_info->ins, payload.ins_info->src_id,
+                                                payload.ins_info->transfer_id_tag);
         } else if (type == +TransferType::global_load) {
-            transmit_socket_.loadGlobal(payload.ins_info->ins, address_byte, size_byte);
+            data = transmit_socket_.loadGlobal(payload.ins_info->ins, address_byte, size_byte);
         } else {
-            memory_socket_.readLocal(payload.ins_info->ins, address_byte, size_byte);
+            data = memory_socket_.readLocal(payload.ins_info->ins, address_byte, size_byte);
+        }
+        if (data_mode_ == +DataMode::real_data) {
+            payload.data = std::make_shared<std::vector<uint8_t>>(std::move(data));
         }
 
         waitAndStartNextStage(payload, write_stage_socket_);
@@ -164,13 +188,21 @@ void GlobalTransferDataPath::processWriteStage() {
 
         int address_byte = payload.ins_info->dst_start_address_byte;
         int size_byte = payload.ins_info->data_size_byte;
+        std::vector<uint8_t> data;
+        if (payload.data != nullptr) {
+            data = std::move(*payload.data);
+        }
         if (auto type = payload.ins_info->type; type == +TransferType::send) {
             transmit_socket_.sendData(payload.ins_info->ins, payload.ins_info->dst_id,
-                                      payload.ins_info->transfer_id_tag, address_byte, size_byte);
+                                      payload.ins_info->transfer_id_tag, address_byte, size_byte, std::move(data));
+        } else if (type == +TransferType::multicast) {
+            transmit_socket_.multicastData(payload.ins_info->ins, payload.ins_info->multicast_dst_id_list,
+                                           payload.ins_info->transfer_id_tag, address_byte, size_byte,
+                                           std::move(data));
         } else if (type == +TransferType::global_store) {
-            transmit_socket_.storeGlobal(payload.ins_info->ins, address_byte, size_byte, {});
+            transmit_socket_.storeGlobal(payload.ins_info->ins, address_byte, size_byte, std::move(data));
         } else {
-            memory_socket_.writeLocal(payload.ins_info->ins, address_byte, size_byte, {});
+            memory_socket_.writeLocal(payload.ins_info->ins, address_byte, size_byte, std::move(data));
         }
 
         CORE_LOG(fmt::format("{} write end, pc: {}", getName(), payload.ins_info->ins.pc));
@@ -185,18 +217,20 @@ void GlobalTransferDataPath::bindLocalMemoryUnit(MemoryUnit* local_memory_unit)
     memory_socket_.bindLocalMemoryUnit(local_memory_unit);
 }
 
-void GlobalTransferDataPath::bindSwitchAndGlobalMemory(Switch* switch_, int global_memory_switch_id) {
-    transmit_socket_.bindSwitchAndGlobalMemory(switch_, core_id_, global_memory_switch_id);
-}
-
 TransferUnit::TransferUnit(const sc_module_name& name, const TransferUnitConfig& config, const BaseInfo& base_info,
                            Clock* clk, int global_memory_switch_id)
     : ExecuteUnit(name, base_info, clk, ExecuteUnitType::transfer)
     , config_(config)
     , intra_core_bus_("IntraCoreBus", base_info, *this, config_.pipeline)
-    , inter_core_bus_("InterCoreBus", base_info, *this)
     , global_memory_switch_id_(global_memory_switch_id) {
     SC_THREAD(processIssue)
+    setThreadStackSize();
+
+    for (int i = 0; i < config_.inter_core_bus_cnt; i++) {
+        auto data_path_name = fmt::format("InterCoreBus_{}", i);
+        inter_core_bus_list_.emplace_back(
+            std::make_shared<GlobalTransferDataPath>(data_path_name.c_str(), base_info, *this, transmit_socket_));
+    }
 
     for (auto& local_dedicated_data_path_cfg : config_.local_dedicated_data_path_list) {
         auto data_path_name = fmt::format("LocalDedicatedDataPath_{}", local_dedicated_data_path_cfg.id);
@@ -218,7 +252,7 @@ void TransferUnit::processIssue() {
             waitAndStartNextStage(local_trans_payload, intra_core_bus_.exec_socket_);
         } else if (data_path_payload.type == +DataPathType::inter_core_bus) {
             auto global_trans_payload = decodeGlobalTransferInfo(*payload);
-            waitAndStartNextStage(global_trans_payload, inter_core_bus_.exec_socket_);
+            waitAndStartNextStage(global_trans_payload, selectInterCoreBus().exec_socket_);
         } else if (data_path_payload.type == +DataPathType::local_dedicated_data_path) {
             auto local_trans_payload = decodeLocalTransferInfo(*payload);
             auto data_path_ptr = local_dedicated_data_path_map_[data_path_payload.local_dedicated_data_path_id];
@@ -230,12 +264,26 @@ void TransferUnit::processIssue() {
 }
 
 void TransferUnit::bindSwitch(Switch* switch_) {
-    inter_core_bus_.bindSwitchAndGlobalMemory(switch_, global_memory_switch_id_);
+    transmit_socket_.bindSwitchAndGlobalMemory(switch_, core_id_, global_memory_switch_id_);
+}
+
+int TransferUnit::getPendingTransferCount() const {
+    return transmit_socket_.getPendingTransferCount();
+}
+
+void TransferUnit::resetTiming() {
+    if (getPendingTransferCount() > 0) {
+        throw std::runtime_error{fmt::format("{}: reset timing with {} pending transfers", getFullName(),
+                                             getPendingTransferCount())};
+    }
+    next_inter_core_bus_ = 0;
 }
 
 void TransferUnit::bindLocalMemoryUnit(MemoryUnit* local_memory_unit) {
     intra_core_bus_.bindLocalMemoryUnit(local_memory_unit);
-    inter_core_bus_.bindLocalMemoryUnit(local_memory_unit);
+    for (auto& data_path_ptr : inter_core_bus_list_) {
+        data_path_ptr->bindLocalMemoryUnit(local_memory_unit);
+    }
     for (auto& [id, data_path_ptr] : local_dedicated_data_path_map_) {
         data_path_ptr->bindLocalMemoryUnit(local_memory_unit);
     }
@@ -265,6 +313,12 @@ LocalTransferDataPathPayload TransferUnit::decodeLocalTransferInfo(const Transfe
 }
 
 GlobalTransferDataPathPayload TransferUnit::decodeGlobalTransferInfo(const TransferInsPayload& payload) {
+    std::vector<int> multicast_dst_id_list;
+    if (payload.type == +TransferType::multicast) {
+        for (int i = 0; i < payload.dst_cnt; i++) {
+            multicast_dst_id_list.push_back(payload.dst_id + i);
+        }
+    }
     return {.ins_info = std::make_shared<GlobalTransferInsInfo>(
                 GlobalTransferInsInfo{.ins = payload.ins,
                                       .type = payload.type,
@@ -273,15 +327,30 @@ GlobalTransferDataPathPayload TransferUnit::decodeGlobalTransferInfo(const Trans
                                       .data_size_byte = payload.size_byte,
                                       .src_id = payload.src_id,
                                       .dst_id = payload.dst_id,
+                                      .multicast_dst_id_list = std::move(multicast_dst_id_list),
                                       .transfer_id_tag = payload.transfer_id_tag})};
 }
 
+GlobalTransferDataPath& TransferUnit::selectInterCoreBus() {
+    // prefer an idle bus, otherwise wait for buses in round-robin order
+    for (int i = 0; i < inter_core_bus_list_.size(); i++) {
+        int bus_id = (next_inter_core_bus_ + i) % static_cast<int>(inter_core_bus_list_.size());
+        if (!inter_core_bus_list_[bus_id]->exec_socket_.busy) {
+            next_inter_core_bus_ = (bus_id + 1) % static_cast<int>(inter_core_bus_list_.size());
+            return *inter_core_bus_list_[bus_id];
+        }
+    }
+    int bus_id = next_inter_core_bus_;
+    next_inter_core_bus_ = (bus_id + 1) % static_cast<int>(inter_core_bus_list_.size());
+    return *inter_core_bus_list_[bus_id];
+}
+
 ResourceAllocatePayload TransferUnit::getDataConflictInfo(const TransferInsPayload& payload) const {
     ResourceAllocatePayload conflict_payload{.ins_id = payload.ins.ins_id,
                                              .unit_type = ExecuteUnitType::transfer,
                                              .data_path_payload = payload.data_path_payload};
     if (payload.type == +TransferType::local_trans || payload.type == +TransferType::send ||
-        payload.type == +TransferType::global_store) {
+        payload.type == +TransferType::multicast || payload.type == +TransferType::global_store) {
         conflict_payload.addReadMemoryId(as_.getLocalMemoryId(payload.src_address_byte));
     }
     if (payload.type == +TransferType::local_trans || payload.type == +TransferType::receive ||
@@ -292,7 +361,7 @@ ResourceAllocatePayload TransferUnit::getDataConflictInfo(const TransferInsPaylo
 }
 
 ResourceAllocatePayload TransferUnit::getDataConflictInfo(const std::shared_ptr<ExecuteInsPayload>& payload) {
-    return getDataConflictInfo(*std::dynamic_pointer_cast<TransferInsPayload>(payload));
+    return getDataConflictInfo(*castInsPayload<TransferInsPayload>(payload));
 }
 
 }  // namespace cimsim
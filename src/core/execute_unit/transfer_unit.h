@@ -26,7 +26,7 @@ struct LocalTransferBatchInfo {
     int batch_num{0};
     int batch_data_size_byte{0};
     bool last_batch{false};
-    std::vector<unsigned char> data{};
+    std::shared_ptr<std::vector<uint8_t>> data{nullptr};  // only in real data mode
 };
 
 struct LocalTransferDataPathPayload {
@@ -37,7 +37,7 @@ struct LocalTransferDataPathPayload {
 
 struct LocalTransferStagePayload {
     std::shared_ptr<LocalTransferInsInfo> ins_info;
-    std::shared_ptr<LocalTransferBatchInfo> batch_info;
+    LocalTransferBatchInfo batch_info{};
 };
 
 struct GlobalTransferInsInfo {
@@ -50,6 +50,7 @@ struct GlobalTransferInsInfo {
 
     int src_id{0};
     int dst_id{0};
+    std::vector<int> multicast_dst_id_list{};
     int transfer_id_tag{0};
 };
 
@@ -59,6 +60,7 @@ struct GlobalTransferDataPathPayload {
 
 struct GlobalTransferStagePayload {
     std::shared_ptr<GlobalTransferInsInfo> ins_info;
+    std::shared_ptr<std::vector<uint8_t>> data{nullptr};  // only in real data mode
 };
 
 using LocalTransferStageSocket = SubmoduleSocket<LocalTransferStagePayload>;
@@ -97,14 +99,14 @@ class GlobalTransferDataPath : public BaseModule {
 public:
     SC_HAS_PROCESS(GlobalTransferDataPath);
 
-    GlobalTransferDataPath(const sc_module_name& name, const BaseInfo& base_info, TransferUnit& transfer_unit);
+    GlobalTransferDataPath(const sc_module_name& name, const BaseInfo& base_info, TransferUnit& transfer_unit,
+                           TransmitSocket& transmit_socket);
 
     [[noreturn]] void processIssue();
     [[noreturn]] void processReadStage();
     [[noreturn]] void processWriteStage();
 
     void bindLocalMemoryUnit(MemoryUnit* local_memory_unit);
-    void bindSwitchAndGlobalMemory(Switch* switch_, int global_memory_switch_id);
 
 public:
     SubmoduleSocket<GlobalTransferDataPathPayload> exec_socket_;
@@ -116,7 +118,7 @@ private:
     GlobalTransferStageSocket write_stage_socket_;
 
     MemorySocket memory_socket_;
-    TransmitSocket transmit_socket_;
+    TransmitSocket& transmit_socket_;
 };
 
 class TransferUnit : public ExecuteUnit {
@@ -133,6 +135,9 @@ public:
     [[noreturn]] void processIssue();
 
     void bindSwitch(Switch* switch_);
+    [[nodiscard]] int getPendingTransferCount() const;
+    // select inter core buses from the first one again, as in a new run
+    void resetTiming();
     void bindLocalMemoryUnit(MemoryUnit* local_memory_unit) override;
 
     ResourceAllocatePayload getDataConflictInfo(const TransferInsPayload& payload) const;
@@ -142,13 +147,19 @@ private:
     LocalTransferDataPathPayload decodeLocalTransferInfo(const TransferInsPayload& payload) const;
     static GlobalTransferDataPathPayload decodeGlobalTransferInfo(const TransferInsPayload& payload);
 
+    GlobalTransferDataPath& selectInterCoreBus();
+
 private:
     const TransferUnitConfig& config_;
 
     LocalTransferDataPath intra_core_bus_;
-    GlobalTransferDataPath inter_core_bus_;
     std::unordered_map<unsigned int, std::shared_ptr<LocalTransferDataPath>> local_dedicated_data_path_map_{};
 
+    // inter core buses share one socket, so send and recv insts on different buses are matched by tag
+    TransmitSocket transmit_socket_;
+    std::vector<std::shared_ptr<GlobalTransferDataPath>> inter_core_bus_list_{};
+    int next_inter_core_bus_{0};
+
     const int global_memory_switch_id_;
 };
 
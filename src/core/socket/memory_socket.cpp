@@ -9,23 +9,15 @@
 
 namespace cimsim {
 
-MemorySocket::~MemorySocket() {
-    delete finish_read_;
-    delete finish_write_;
-}
-
 void MemorySocket::bindLocalMemoryUnit(cimsim::MemoryUnit *local_memory_unit) {
     local_memory_unit_ = local_memory_unit;
-    finish_read_ = new sc_event{};
-    finish_write_ = new sc_event{};
 }
 
 std::vector<uint8_t> MemorySocket::readLocal(const cimsim::InstructionPayload &ins, int address_byte, int size_byte) {
     auto payload = std::make_shared<MemoryAccessPayload>(MemoryAccessPayload{.ins = ins,
                                                                              .access_type = MemoryAccessType::read,
                                                                              .address_byte = address_byte,
-                                                                             .size_byte = size_byte,
-                                                                             .finish_access = *finish_read_});
+                                                                             .size_byte = size_byte});
     local_memory_unit_->access(payload);
     return std::move(payload->data);
 }
@@ -36,8 +28,7 @@ void MemorySocket::writeLocal(const cimsim::InstructionPayload &ins, int address
                                                                              .access_type = MemoryAccessType::write,
                                                                              .address_byte = address_byte,
                                                                              .size_byte = size_byte,
-                                                                             .data = std::move(data),
-                                                                             .finish_access = *finish_write_});
+                                                                             .data = std::move(data)});
     local_memory_unit_->access(payload);
 }
 
@@ -17,8 +17,6 @@ class MemorySocket {
 public:
     MemorySocket() = default;
 
-    ~MemorySocket();
-
     void bindLocalMemoryUnit(MemoryUnit* local_memory_unit);
 
     std::vector<uint8_t> readLocal(const InstructionPayload& ins, int address_byte, int size_byte);
@@ -29,9 +27,6 @@ public:
 
 private:
     MemoryUnit* local_memory_unit_{nullptr};
-
-    sc_event* finish_read_{nullptr};
-    sc_event* finish_write_{nullptr};
 };
 
 }  // namespace cimsim
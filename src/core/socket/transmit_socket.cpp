@@ -4,6 +4,9 @@
 
 #include "transmit_socket.h"
 
+#include <algorithm>
+
+#include "address_space/address_space.h"
 #include "fmt/format.h"
 #include "memory/payload.h"
 #include "network/switch.h"
@@ -22,88 +25,119 @@ void TransmitSocket::bindSwitchAndGlobalMemory(Switch* _switch, int core_id, int
 
 std::vector<uint8_t> TransmitSocket::loadGlobal(const InstructionPayload& ins, int address_byte, int size_byte) {
     LOG(fmt::format("core id: {}, load global data start, pc: {}", core_id_, ins.pc));
-    auto global_payload =
-        std::make_shared<MemoryAccessPayload>(MemoryAccessPayload{.ins = ins,
-                                                                  .access_type = MemoryAccessType::read,
-                                                                  .address_byte = address_byte,
-                                                                  .size_byte = size_byte,
-                                                                  .finish_access = finish_load_});
-    auto network_payload = std::make_shared<NetworkPayload>(NetworkPayload{.ins = ins,
-                                                                           .src_id = core_id_,
-                                                                           .dst_id = global_memory_switch_id_,
-                                                                           .finish_network_trans = &finish_load_trans_,
-                                                                           .request_data_size_byte = 1,
-                                                                           .request_payload = global_payload,
-                                                                           .response_data_size_byte = size_byte,
-                                                                           .response_payload = nullptr});
-    switch_->transportHandler(network_payload);
-    wait(*network_payload->finish_network_trans);
-
+    auto network_payload_list = transportGlobal(ins, MemoryAccessType::read, address_byte, size_byte, {});
     LOG(fmt::format("core id: {}, load global data end, pc: {}", core_id_, ins.pc));
-    return std::move(global_payload->data);
+
+    if (network_payload_list.size() == 1) {
+        return std::move(network_payload_list[0]->getRequestPayload<MemoryAccessPayload>()->data);
+    }
+    std::vector<uint8_t> data;
+    for (auto& network_payload : network_payload_list) {
+        auto& segment_data = network_payload->getRequestPayload<MemoryAccessPayload>()->data;
+        data.insert(data.end(), segment_data.begin(), segment_data.end());
+    }
+    return std::move(data);
 }
 
 void TransmitSocket::storeGlobal(const InstructionPayload& ins, int address_byte, int size_byte,
                                  std::vector<uint8_t> data) {
     LOG(fmt::format("core id: {}, store global data start, pc: {}", core_id_, ins.pc));
-    auto global_payload =
-        std::make_shared<MemoryAccessPayload>(MemoryAccessPayload{.ins = ins,
-                                                                  .access_type = MemoryAccessType::write,
-                                                                  .address_byte = address_byte,
-                                                                  .size_byte = size_byte,
-                                                                  .data = std::move(data),
-                                                                  .finish_access = finish_store_});
-    auto network_payload = std::make_shared<NetworkPayload>(NetworkPayload{.ins = ins,
-                                                                           .src_id = core_id_,
-                                                                           .dst_id = global_memory_switch_id_,
-                                                                           .finish_network_trans = &finish_store_trans_,
-                                                                           .request_data_size_byte = size_byte,
-                                                                           .request_payload = global_payload,
-                                                                           .response_data_size_byte = 1,
-                                                                           .response_payload = nullptr});
-    switch_->transportHandler(network_payload);
-    wait(*network_payload->finish_network_trans);
+    transportGlobal(ins, MemoryAccessType::write, address_byte, size_byte, std::move(data));
     LOG(fmt::format("core id: {}, store global data end, pc: {}", core_id_, ins.pc));
 }
 
+std::vector<std::shared_ptr<NetworkPayload>> TransmitSocket::transportGlobal(const InstructionPayload& ins,
+                                                                             MemoryAccessType access_type,
+                                                                             int address_byte, int size_byte,
+                                                                             std::vector<uint8_t> data) {
+    const auto& as = AddressSapce::getInstance();
+    const int block_byte = as.getGlobalMemoryInterleaveBlockByte();
+    const int end_address_byte = address_byte + size_byte;
+    const bool is_read = access_type == +MemoryAccessType::read;
+    // one event for the segments of this access only, loads and stores of other data paths are in flight meanwhile
+    sc_event finish_network_trans;
+
+    // split access into segments at interleave block boundaries where the global memory controller changes
+    std::vector<std::shared_ptr<NetworkPayload>> network_payload_list;
+    for (int segment_address_byte = address_byte; segment_address_byte < end_address_byte;) {
+        int dst_id = as.getGlobalMemorySwitchId(segment_address_byte);
+        int segment_end_address_byte = (segment_address_byte / block_byte + 1) * block_byte;
+        while (segment_end_address_byte < end_address_byte &&
+               as.getGlobalMemorySwitchId(segment_end_address_byte) == dst_id) {
+            segment_end_address_byte += block_byte;
+        }
+        segment_end_address_byte = std::min(segment_end_address_byte, end_address_byte);
+        int segment_size_byte = segment_end_address_byte - segment_address_byte;
+
+        std::vector<uint8_t> segment_data;
+        if (segment_size_byte == size_byte) {
+            segment_data = std::move(data);
+        } else if (!data.empty()) {
+            int offset = segment_address_byte - address_byte;
+            segment_data.assign(data.begin() + offset, data.begin() + offset + segment_size_byte);
+        }
+
+        auto global_payload =
+            std::make_shared<MemoryAccessPayload>(MemoryAccessPayload{.ins = ins,
+                                                                      .access_type = access_type,
+                                                                      .address_byte = segment_address_byte,
+                                                                      .size_byte = segment_size_byte,
+                                                                      .data = std::move(segment_data)});
+        auto network_payload = std::make_shared<NetworkPayload>(
+            NetworkPayload{.ins = ins,
+                           .src_id = core_id_,
+                           .dst_id = dst_id,
+                           .finish_network_trans = &finish_network_trans,
+                           .request_data_size_byte = is_read ? 1 : segment_size_byte,
+                           .request_payload = global_payload,
+                           .response_data_size_byte = is_read ? segment_size_byte : 1,
+                           .response_payload = nullptr});
+        switch_->transportHandler(network_payload);
+        network_payload_list.emplace_back(std::move(network_payload));
+
+        segment_address_byte = segment_end_address_byte;
+    }
+
+    int unfinished_cnt = static_cast<int>(network_payload_list.size());
+    while (unfinished_cnt > 0) {
+        wait(finish_network_trans);
+        unfinished_cnt = static_cast<int>(std::count_if(
+            network_payload_list.begin(), network_payload_list.end(),
+            [](const std::shared_ptr<NetworkPayload>& payload) { return !payload->network_trans_finished; }));
+    }
+    for (auto& network_payload : network_payload_list) {
+        network_payload->finish_network_trans = nullptr;
+    }
+    return std::move(network_payload_list);
+}
+
 void TransmitSocket::sendHandshake(const InstructionPayload& ins, int dst_id, int transfer_id_tag) {
-    expected_receiver_core_id_ = dst_id;
-    expected_transfer_id_tag_ = transfer_id_tag;
     LOG(fmt::format("core id: {}, send handshake start, dst_id: {}, transfer_id_tag: {}", core_id_, dst_id,
                     transfer_id_tag));
-
-    auto request = std::make_shared<DataTransferInfo>(DataTransferInfo{.sender_id = core_id_,
-                                                                       .receiver_id = dst_id,
-                                                                       .is_sender = true,
-                                                                       .status = DataTransferStatus::sender_ready,
-                                                                       .id_tag = transfer_id_tag,
-                                                                       .data_size_byte = 0});
-    auto network_payload = std::make_shared<NetworkPayload>(NetworkPayload{.ins = ins,
-                                                                           .src_id = core_id_,
-                                                                           .dst_id = dst_id,
-                                                                           .request_data_size_byte = 1,
-                                                                           .request_payload = request,
-                                                                           .response_data_size_byte = 1,
-                                                                           .response_payload = nullptr});
-    switch_->sendHandler(network_payload);
-    wait(sender_wait_receiver_ready_);
-
+    auto state = postSendHandshake(ins, dst_id, transfer_id_tag);
+    waitState(state, &DataTransferState::remote_ready);
     LOG(fmt::format("core id: {}, send handshake end, dst_id: {}, transfer_id_tag: {}", core_id_, dst_id,
                     transfer_id_tag));
-    expected_receiver_core_id_ = -1;
-    expected_transfer_id_tag_ = -1;
 }
 
 void TransmitSocket::sendData(const InstructionPayload& ins, int dst_id, int transfer_id_tag, int dst_address_byte,
-                              int data_size_byte) {
+                              int data_size_byte, std::vector<uint8_t> data) {
     LOG(fmt::format("core id: {}, send data start, dst_id: {}, transfer_id_tag: {}", core_id_, dst_id,
                     transfer_id_tag));
+    DataTransferKey key{dst_id, transfer_id_tag};
+    auto state = findPostedState(send_transfer_map_, key, ins.ins_id);
+    eraseState(send_transfer_map_, key, state);
+
     auto resuest = std::make_shared<DataTransferInfo>(DataTransferInfo{.sender_id = core_id_,
                                                                        .receiver_id = dst_id,
                                                                        .is_sender = true,
                                                                        .status = DataTransferStatus::send_data,
                                                                        .id_tag = transfer_id_tag,
+                                                                       .seq = state->seq,
                                                                        .data_size_byte = data_size_byte});
+    if (!data.empty()) {
+        resuest->data = std::make_shared<std::vector<uint8_t>>(std::move(data));
+    }
     auto network_payload = std::make_shared<NetworkPayload>(NetworkPayload{.ins = ins,
                                                                            .src_id = core_id_,
                                                                            .dst_id = dst_id,
@@ -115,26 +149,80 @@ void TransmitSocket::sendData(const InstructionPayload& ins, int dst_id, int tra
     LOG(fmt::format("core id: {}, send data end, dst_id: {}, transfer_id_tag: {}", core_id_, dst_id, transfer_id_tag));
 }
 
-void TransmitSocket::receiveHandshake(int src_id, int transfer_id_tag) {
-    expected_sender_core_id_ = src_id;
-    LOG(fmt::format("core id: {}, receive handshake start, src_id: {}, transfer_id_tag: {}", core_id_, src_id,
-                    transfer_id_tag));
+void TransmitSocket::multicastHandshake(const InstructionPayload& ins, const std::vector<int>& dst_id_list,
+                                        int transfer_id_tag) {
+    LOG(fmt::format("core id: {}, multicast handshake start, dst cnt: {}, transfer_id_tag: {}", core_id_,
+                    dst_id_list.size(), transfer_id_tag));
+    std::vector<std::shared_ptr<DataTransferState>> state_list;
+    for (int dst_id : dst_id_list) {
+        state_list.emplace_back(postSendHandshake(ins, dst_id, transfer_id_tag));
+    }
+    for (auto& state : state_list) {
+        waitState(state, &DataTransferState::remote_ready);
+    }
+    LOG(fmt::format("core id: {}, multicast handshake end, dst cnt: {}, transfer_id_tag: {}", core_id_,
+                    dst_id_list.size(), transfer_id_tag));
+}
 
-    if (auto found = receiver_waiting_sender_map.find(src_id);
-        found == receiver_waiting_sender_map.end() || found->second != transfer_id_tag) {
-        wait(receiver_wait_sender_ready_);
+void TransmitSocket::multicastData(const InstructionPayload& ins, const std::vector<int>& dst_id_list,
+                                   int transfer_id_tag, int dst_address_byte, int data_size_byte,
+                                   std::vector<uint8_t> data) {
+    if (dst_id_list.empty()) {
+        return;
+    }
+    LOG(fmt::format("core id: {}, multicast data start, dst cnt: {}, transfer_id_tag: {}", core_id_,
+                    dst_id_list.size(), transfer_id_tag));
+    std::vector<int> seq_list;
+    for (int dst_id : dst_id_list) {
+        DataTransferKey key{dst_id, transfer_id_tag};
+        auto state = findPostedState(send_transfer_map_, key, ins.ins_id);
+        eraseState(send_transfer_map_, key, state);
+        seq_list.push_back(state->seq);
     }
 
-    expected_sender_core_id_ = -1;
+    auto request = std::make_shared<DataTransferInfo>(DataTransferInfo{.sender_id = core_id_,
+                                                                       .receiver_id = dst_id_list.front(),
+                                                                       .is_sender = true,
+                                                                       .status = DataTransferStatus::send_data,
+                                                                       .id_tag = transfer_id_tag,
+                                                                       .seq = seq_list.front(),
+                                                                       .data_size_byte = data_size_byte,
+                                                                       .multicast_seq_list = std::move(seq_list)});
+    if (!data.empty()) {
+        request->data = std::make_shared<std::vector<uint8_t>>(std::move(data));
+    }
+    auto network_payload = std::make_shared<NetworkPayload>(NetworkPayload{.ins = ins,
+                                                                           .src_id = core_id_,
+                                                                           .dst_id = dst_id_list.front(),
+                                                                           .multicast_dst_id_list = dst_id_list,
+                                                                           .request_data_size_byte = data_size_byte,
+                                                                           .request_payload = request,
+                                                                           .response_data_size_byte = 0,
+                                                                           .response_payload = nullptr});
+    switch_->multicastHandler(network_payload);
+    LOG(fmt::format("core id: {}, multicast data end, dst cnt: {}, transfer_id_tag: {}", core_id_,
+                    dst_id_list.size(), transfer_id_tag));
+}
+
+void TransmitSocket::receiveHandshake(const InstructionPayload& ins, int src_id, int transfer_id_tag) {
+    LOG(fmt::format("core id: {}, receive handshake start, src_id: {}, transfer_id_tag: {}", core_id_, src_id,
+                    transfer_id_tag));
+
+    auto state = postState(receive_transfer_map_, receive_seq_map_, {src_id, transfer_id_tag}, ins.ins_id);
+    waitState(state, &DataTransferState::remote_ready);
 }
 
-void TransmitSocket::receiveData(const InstructionPayload& ins, int src_id) {
+std::vector<uint8_t> TransmitSocket::receiveData(const InstructionPayload& ins, int src_id, int transfer_id_tag) {
+    DataTransferKey key{src_id, transfer_id_tag};
+    auto state = findPostedState(receive_transfer_map_, key, ins.ins_id);
+
     auto data_transfer_response =
         std::make_shared<DataTransferInfo>(DataTransferInfo{.sender_id = src_id,
                                                             .receiver_id = core_id_,
                                                             .is_sender = false,
                                                             .status = DataTransferStatus::receiver_ready,
-                                                            .id_tag = receiver_waiting_sender_map[src_id],
+                                                            .id_tag = transfer_id_tag,
+                                                            .seq = state->seq,
                                                             .data_size_byte = 0});
     auto network_payload = std::make_shared<NetworkPayload>(NetworkPayload{.ins = ins,
                                                                            .src_id = core_id_,
@@ -143,53 +231,168 @@ void TransmitSocket::receiveData(const InstructionPayload& ins, int src_id) {
                                                                            .request_payload = data_transfer_response,
                                                                            .response_data_size_byte = 0,
                                                                            .response_payload = nullptr});
-    int transfer_id_tag = receiver_waiting_sender_map[src_id];
-    receiver_waiting_sender_map[src_id] = -1;
     switch_->sendHandler(network_payload);
     LOG(fmt::format("core id: {}, receive handshake end, src_id: {}, transfer_id_tag: {}", core_id_, src_id,
                     transfer_id_tag));
 
     LOG(fmt::format("core id: {}, receive data start, src_id: {}, transfer_id_tag: {}", core_id_, src_id,
-                    receiver_waiting_sender_map[src_id]));
-    wait(receiver_wait_data_ready_);
+                    transfer_id_tag));
+    waitState(state, &DataTransferState::data_ready);
+    eraseState(receive_transfer_map_, key, state);
     LOG(fmt::format("core id: {}, receive data end, src_id: {}, transfer_id_tag: {}", core_id_, src_id,
                     transfer_id_tag));
+
+    if (state->data == nullptr) {
+        return {};
+    }
+    if (state->data.use_count() == 1) {
+        // unicast data is owned only by this receiver, multicast data is shared by all receivers
+        return std::move(*state->data);
+    }
+    return *state->data;
+}
+
+int TransmitSocket::getPendingTransferCount() const {
+    int cnt = 0;
+    for (const auto* transfer_map : {&send_transfer_map_, &receive_transfer_map_}) {
+        for (const auto& [key, state_queue] : *transfer_map) {
+            cnt += static_cast<int>(state_queue.size());
+        }
+    }
+    return cnt;
 }
 
 void TransmitSocket::switchReceiveHandler(const std::shared_ptr<NetworkPayload>& payload) {
     auto data_transfer_payload = payload->getRequestPayload<DataTransferInfo>();
     auto remote_is_sender = data_transfer_payload->is_sender;
+    auto status = data_transfer_payload->status;
 
-    LOG(fmt::format("core id: {}, receive network message from {}, remote is {}, status: {}, sender_core_id: {}, "
-                    "expected_sender_core_id: {}",
-                    core_id_, payload->src_id, (remote_is_sender ? "sender" : "receiver"),
-                    data_transfer_payload->status._to_string(), data_transfer_payload->sender_id,
-                    expected_sender_core_id_));
+    LOG(fmt::format("core id: {}, receive network message from {}, remote is {}, status: {}, transfer_id_tag: {}",
+                    core_id_, payload->src_id, (remote_is_sender ? "sender" : "receiver"), status._to_string(),
+                    data_transfer_payload->id_tag));
 
+    std::shared_ptr<DataTransferState> state;
     if (remote_is_sender) {
         // remote core execute send inst to this core
-        auto status = data_transfer_payload->status;
-        auto sender_core_id = data_transfer_payload->sender_id;
+        DataTransferKey key{data_transfer_payload->sender_id, data_transfer_payload->id_tag};
         if (status == +DataTransferStatus::sender_ready) {
-            // remote core send handshake
-            receiver_waiting_sender_map[sender_core_id] = data_transfer_payload->id_tag;
-            if (sender_core_id == expected_sender_core_id_) {
-                // this core already execute recv and is waiting for remote core
-                receiver_wait_sender_ready_.notify(SC_ZERO_TIME);
-            }
+            // the recv inst may not be executed yet, then the state waits for it
+            state = findOrCreateState(receive_transfer_map_, key, data_transfer_payload->seq);
+            state->remote_ready = true;
         } else if (status == +DataTransferStatus::send_data) {
-            receiver_wait_data_ready_.notify(SC_ZERO_TIME);
+            // data of sends with the same key may arrive out of order when they run on different data paths
+            int seq = data_transfer_payload->seq;
+            if (const auto& dst_id_list = payload->multicast_dst_id_list; !dst_id_list.empty()) {
+                auto index = std::find(dst_id_list.begin(), dst_id_list.end(), core_id_) - dst_id_list.begin();
+                seq = data_transfer_payload->multicast_seq_list[index];
+            }
+            state = findOrCreateState(receive_transfer_map_, key, seq);
+            state->data_ready = true;
+            if (payload->multicast_dst_id_list.empty()) {
+                state->data = std::move(data_transfer_payload->data);
+            } else {
+                state->data = data_transfer_payload->data;
+            }
         }
     } else {
-        // remote core recv this core
-        auto receiver_core_id = data_transfer_payload->receiver_id;
-        if (receiver_core_id == expected_receiver_core_id_ &&
-            data_transfer_payload->id_tag == expected_transfer_id_tag_ &&
-            data_transfer_payload->status == +DataTransferStatus::receiver_ready) {
-            sender_wait_receiver_ready_.notify(SC_ZERO_TIME);
-        } else {
-            std::cerr << fmt::format("TransferUnit: send-recv not match") << std::endl;
+        // remote core recv this core, this core must have sent handshake before
+        DataTransferKey key{data_transfer_payload->receiver_id, data_transfer_payload->id_tag};
+        auto found = send_transfer_map_.find(key);
+        if (status != +DataTransferStatus::receiver_ready || found == send_transfer_map_.end()) {
+            std::cerr << fmt::format("TransferUnit: send-recv not match, core id: {}, receiver id: {}, "
+                                     "transfer_id_tag: {}",
+                                     core_id_, key.first, key.second)
+                      << std::endl;
+            return;
         }
+        state = findOrCreateState(send_transfer_map_, key, data_transfer_payload->seq);
+        state->remote_ready = true;
+    }
+
+    if (state != nullptr) {
+        state->state_changed.notify(SC_ZERO_TIME);
+    }
+}
+
+std::shared_ptr<TransmitSocket::DataTransferState> TransmitSocket::postSendHandshake(const InstructionPayload& ins,
+                                                                                     int dst_id,
+                                                                                     int transfer_id_tag) {
+    auto state = postState(send_transfer_map_, send_seq_map_, {dst_id, transfer_id_tag}, ins.ins_id);
+
+    auto request = std::make_shared<DataTransferInfo>(DataTransferInfo{.sender_id = core_id_,
+                                                                       .receiver_id = dst_id,
+                                                                       .is_sender = true,
+                                                                       .status = DataTransferStatus::sender_ready,
+                                                                       .id_tag = transfer_id_tag,
+                                                                       .seq = state->seq,
+                                                                       .data_size_byte = 0});
+    auto network_payload = std::make_shared<NetworkPayload>(NetworkPayload{.ins = ins,
+                                                                           .src_id = core_id_,
+                                                                           .dst_id = dst_id,
+                                                                           .request_data_size_byte = 1,
+                                                                           .request_payload = request,
+                                                                           .response_data_size_byte = 1,
+                                                                           .response_payload = nullptr});
+    switch_->sendHandler(network_payload);
+    return state;
+}
+
+std::shared_ptr<TransmitSocket::DataTransferState> TransmitSocket::postState(DataTransferQueueMap& map,
+                                                                             std::map<DataTransferKey, int>& seq_map,
+                                                                             const DataTransferKey& key, int ins_id) {
+    auto state = findOrCreateState(map, key, seq_map[key]++);
+    state->ins_id = ins_id;
+    state->local_posted = true;
+    return state;
+}
+
+std::shared_ptr<TransmitSocket::DataTransferState> TransmitSocket::findOrCreateState(DataTransferQueueMap& map,
+                                                                                     const DataTransferKey& key,
+                                                                                     int seq) {
+    auto& queue = map[key];
+    for (auto& state : queue) {
+        if (state->seq == seq) {
+            return state;
+        }
+    }
+    auto& state = queue.emplace_back(std::make_shared<DataTransferState>());
+    state->seq = seq;
+    return state;
+}
+
+std::shared_ptr<TransmitSocket::DataTransferState> TransmitSocket::findPostedState(DataTransferQueueMap& map,
+                                                                                   const DataTransferKey& key,
+                                                                                   int ins_id) {
+    if (auto found = map.find(key); found != map.end()) {
+        for (auto& state : found->second) {
+            if (state->local_posted && state->ins_id == ins_id) {
+                return state;
+            }
+        }
+    }
+    throw std::runtime_error{fmt::format("TransmitSocket: no posted transfer of inst {}, remote core id: {}, "
+                                         "transfer_id_tag: {}",
+                                         ins_id, key.first, key.second)};
+}
+
+void TransmitSocket::eraseState(DataTransferQueueMap& map, const DataTransferKey& key,
+                                const std::shared_ptr<DataTransferState>& state) {
+    auto found = map.find(key);
+    if (found == map.end()) {
+        return;
+    }
+    auto& queue = found->second;
+    if (auto it = std::find(queue.begin(), queue.end(), state); it != queue.end()) {
+        queue.erase(it);
+    }
+    if (queue.empty()) {
+        map.erase(found);
+    }
+}
+
+void TransmitSocket::waitState(const std::shared_ptr<DataTransferState>& state, const bool DataTransferState::*flag) {
+    while (!((*state).*flag)) {
+        wait(state->state_changed);
     }
 }
 
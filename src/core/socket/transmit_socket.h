@@ -3,9 +3,12 @@
 //
 
 #pragma once
-#include <unordered_map>
+#include <deque>
+#include <map>
+#include <memory>
 
 #include "core/payload.h"
+#include "memory/payload.h"
 #include "network/payload.h"
 #include "systemc.h"
 
@@ -24,33 +27,63 @@ public:
     std::vector<uint8_t> loadGlobal(const InstructionPayload& ins, int address_byte, int size_byte);
     void storeGlobal(const InstructionPayload& ins, int address_byte, int size_byte, std::vector<uint8_t> data);
 
+    // send and receive are matched by <remote core id, transfer id tag>, so several transfers can be in flight at the
+    // same time, transfers with the same key are matched in order of their handshake by a sequence number, the data
+    // stage of a transfer finds its state by the instruction id
     void sendHandshake(const InstructionPayload& ins, int dst_id, int transfer_id_tag);
     void sendData(const InstructionPayload& ins, int dst_id, int transfer_id_tag, int dst_address_byte,
-                  int data_size_byte);
-    void receiveHandshake(int src_id, int transfer_id_tag);
-    void receiveData(const InstructionPayload& ins, int src_id);
+                  int data_size_byte, std::vector<uint8_t> data);
+    // multicast is a send to several dst, each dst executes a normal recv
+    void multicastHandshake(const InstructionPayload& ins, const std::vector<int>& dst_id_list, int transfer_id_tag);
+    void multicastData(const InstructionPayload& ins, const std::vector<int>& dst_id_list, int transfer_id_tag,
+                       int dst_address_byte, int data_size_byte, std::vector<uint8_t> data);
+    void receiveHandshake(const InstructionPayload& ins, int src_id, int transfer_id_tag);
+    std::vector<uint8_t> receiveData(const InstructionPayload& ins, int src_id, int transfer_id_tag);
+
+    // send and receive transfers started by either side but not finished yet
+    [[nodiscard]] int getPendingTransferCount() const;
+
+private:
+    std::vector<std::shared_ptr<NetworkPayload>> transportGlobal(const InstructionPayload& ins,
+                                                                 MemoryAccessType access_type, int address_byte,
+                                                                 int size_byte, std::vector<uint8_t> data);
+
+    struct DataTransferState {
+        int seq{0};
+        int ins_id{-1};  // local inst, set when posted
+        bool local_posted{false};
+        bool remote_ready{false};
+        bool data_ready{false};  // only for receiver
+        std::shared_ptr<std::vector<uint8_t>> data{nullptr};
+        sc_event state_changed;
+    };
+    using DataTransferKey = std::pair<int, int>;  // <remote core id, transfer id tag>
+    using DataTransferQueueMap = std::map<DataTransferKey, std::deque<std::shared_ptr<DataTransferState>>>;
+
+    std::shared_ptr<DataTransferState> postSendHandshake(const InstructionPayload& ins, int dst_id,
+                                                         int transfer_id_tag);
+
+    std::shared_ptr<DataTransferState> postState(DataTransferQueueMap& map, std::map<DataTransferKey, int>& seq_map,
+                                                 const DataTransferKey& key, int ins_id);
+
+    static std::shared_ptr<DataTransferState> findOrCreateState(DataTransferQueueMap& map, const DataTransferKey& key,
+                                                                int seq);
+    static std::shared_ptr<DataTransferState> findPostedState(DataTransferQueueMap& map, const DataTransferKey& key,
+                                                              int ins_id);
+    static void eraseState(DataTransferQueueMap& map, const DataTransferKey& key,
+                           const std::shared_ptr<DataTransferState>& state);
+    static void waitState(const std::shared_ptr<DataTransferState>& state, const bool DataTransferState::*flag);
 
 private:
     Switch* switch_{nullptr};
     int core_id_{0};
     int global_memory_switch_id_{-1};
 
-    // load and store global memory
-    sc_event finish_load_;
-    sc_event finish_store_;
-    sc_event finish_load_trans_;
-    sc_event finish_store_trans_;
-
     // send and receive
-    int expected_receiver_core_id_{-1};  // -1 for not ready, same below
-    int expected_sender_core_id_{-1};    // execute recv and recv sender_core_id's send inst
-    int expected_transfer_id_tag_{-1};
-
-    sc_event sender_wait_receiver_ready_;
-    sc_event receiver_wait_sender_ready_;
-    sc_event receiver_wait_data_ready_;
-
-    std::unordered_map<int, int> receiver_waiting_sender_map;  // <core_id_, transfer_id_tag>
+    DataTransferQueueMap send_transfer_map_;
+    DataTransferQueueMap receive_transfer_map_;
+    std::map<DataTransferKey, int> send_seq_map_;  // count of transfers posted with the key
+    std::map<DataTransferKey, int> receive_seq_map_;
 };
 
 }  // namespace cimsim
@@ -0,0 +1,89 @@
+#include "functional_chip.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "fmt/format.h"
+
+namespace cimsim {
+
+FunctionalChip::FunctionalChip(const Config& config, const std::vector<std::vector<InstV2>>& core_ins_list)
+    : global_memory_(config.chip_config.global_memory_config.global_memory_unit_config, true) {
+    for (int core_id = 0; core_id < config.chip_config.core_cnt; core_id++) {
+        core_list_.emplace_back(std::make_shared<FunctionalCore>(config.chip_config.core_config, core_id,
+                                                                 core_ins_list[core_id], global_memory_, network_));
+    }
+}
+
+bool FunctionalChip::run(const RegionTriggerConfig* stop_trigger) {
+    auto is_stopped = [stop_trigger](const std::shared_ptr<FunctionalCore>& core) {
+        return core->isFinished() || (stop_trigger != nullptr && core->matchTrigger(*stop_trigger));
+    };
+
+    while (true) {
+        bool progress = false;
+        for (auto& core : core_list_) {
+            if (!is_stopped(core)) {
+                progress = (core->run(stop_trigger) > 0) || progress;
+            }
+        }
+        if (std::all_of(core_list_.begin(), core_list_.end(), is_stopped)) {
+            return true;
+        }
+        if (!progress) {
+            for (int core_id = 0; core_id < core_list_.size(); core_id++) {
+                if (!is_stopped(core_list_[core_id])) {
+                    std::cerr << fmt::format("Core {} blocked at ins index {}", core_id,
+                                             core_list_[core_id]->getInsIndex())
+                              << std::endl;
+                }
+            }
+            std::cerr << "Functional simulation deadlock, receive instructions never match any send" << std::endl;
+            return false;
+        }
+    }
+}
+
+void FunctionalChip::report(std::ostream& os) const {
+    os << "Functional Simulation:\n";
+    os << fmt::format("  - {:<20}{}\n", "executed ins count:", getExecutedInsCount());
+    for (int core_id = 0; core_id < core_list_.size(); core_id++) {
+        os << fmt::format("    - core {:<13}{}{}\n", core_id, core_list_[core_id]->getExecutedInsCount(),
+                          core_list_[core_id]->isFinished() ? "" : " (blocked)");
+    }
+    os << fmt::format("  - {:<20}{}\n", "pending messages:", network_.getPendingMessageCount());
+}
+
+long long FunctionalChip::getExecutedInsCount() const {
+    long long cnt = 0;
+    for (const auto& core : core_list_) {
+        cnt += core->getExecutedInsCount();
+    }
+    return cnt;
+}
+
+int FunctionalChip::getPendingMessageCount() const {
+    return network_.getPendingMessageCount();
+}
+
+void FunctionalChip::loadArchState(const ChipArchState& state) {
+    for (int core_id = 0; core_id < core_list_.size() && core_id < state.core_state_list.size(); core_id++) {
+        core_list_[core_id]->loadArchState(state.core_state_list[core_id]);
+    }
+    global_memory_.setDataList(state.global_memory_data_list);
+}
+
+void FunctionalChip::saveArchState(ChipArchState& state) const {
+    state.core_state_list.resize(core_list_.size());
+    for (int core_id = 0; core_id < core_list_.size(); core_id++) {
+        core_list_[core_id]->saveArchState(state.core_state_list[core_id]);
+    }
+    state.global_memory_data_list = global_memory_.getDataList();
+}
+
+bool FunctionalChip::checkRegValues(int core_id, const std::array<int, GENERAL_REG_NUM>& general_reg_expected_values,
+                                    const std::array<int, SPECIAL_REG_NUM>& special_reg_expected_values) const {
+    return core_list_[core_id]->checkRegValues(general_reg_expected_values, special_reg_expected_values);
+}
+
+}  // namespace cimsim
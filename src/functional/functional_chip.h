@@ -0,0 +1,41 @@
+#pragma once
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "config/config.h"
+#include "functional_core.h"
+#include "functional_memory.h"
+
+namespace cimsim {
+
+class FunctionalChip {
+    /* Functional instruction set simulation of the whole chip, used by functional sim mode.
+     * Cores are run in turn until each one finishes or is blocked by a receive, data of send instructions are buffered
+     * in network, so results only depend on program order of every core and the order of send/receive pairs.
+     */
+public:
+    FunctionalChip(const Config& config, const std::vector<std::vector<InstV2>>& core_ins_list);
+
+    // run every core to the end, or until its next instruction matches stop trigger,
+    // return false if cores are deadlocked by receive instructions that never match
+    bool run(const RegionTriggerConfig* stop_trigger = nullptr);
+
+    void report(std::ostream& os) const;
+
+    [[nodiscard]] long long getExecutedInsCount() const;
+    [[nodiscard]] int getPendingMessageCount() const;
+
+    void loadArchState(const ChipArchState& state);
+    void saveArchState(ChipArchState& state) const;
+
+    bool checkRegValues(int core_id, const std::array<int, GENERAL_REG_NUM>& general_reg_expected_values,
+                        const std::array<int, SPECIAL_REG_NUM>& special_reg_expected_values) const;
+
+private:
+    FunctionalMemory global_memory_;
+    FunctionalNetwork network_;
+    std::vector<std::shared_ptr<FunctionalCore>> core_list_;
+};
+
+}  // namespace cimsim
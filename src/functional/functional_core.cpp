@@ -0,0 +1,476 @@
+#include "functional_core.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+#include "core/execute_unit/cim_control_unit.h"
+#include "core/execute_unit/functional_kernel.h"
+#include "core/execute_unit/scalar_unit.h"
+#include "core/reg_unit/reg_unit.h"
+#include "fmt/format.h"
+#include "util/bit_kernel.h"
+#include "util/util.h"
+
+namespace cimsim {
+
+void FunctionalNetwork::send(int src_id, int dst_id, int transfer_id_tag, std::vector<uint8_t> data) {
+    message_queue_map_[{src_id, dst_id, transfer_id_tag}].emplace(std::move(data));
+}
+
+bool FunctionalNetwork::receive(int src_id, int dst_id, int transfer_id_tag, std::vector<uint8_t>& data) {
+    auto found = message_queue_map_.find({src_id, dst_id, transfer_id_tag});
+    if (found == message_queue_map_.end() || found->second.empty()) {
+        return false;
+    }
+    data = std::move(found->second.front());
+    found->second.pop();
+    return true;
+}
+
+int FunctionalNetwork::getPendingMessageCount() const {
+    int cnt = 0;
+    for (const auto& [key, message_queue] : message_queue_map_) {
+        cnt += static_cast<int>(message_queue.size());
+    }
+    return cnt;
+}
+
+FunctionalCore::FunctionalCore(const CoreConfig& config, int core_id, std::vector<InstV2> ins_list,
+                               FunctionalMemory& global_memory, FunctionalNetwork& network)
+    : config_(config)
+    , cim_config_(config.cim_unit_config)
+    , macro_size_(config.cim_unit_config.macro_size)
+    , core_id_(core_id)
+    , ins_list_(std::move(ins_list))
+    , cim_compute_engine_(config.cim_unit_config)
+    , local_memory_(config.local_memory_unit_config, false)
+    , global_memory_(global_memory)
+    , network_(network) {
+    for (const auto& [special, general] : config_.register_unit_config.special_register_binding) {
+        special_bind_map_.emplace(special, general);
+    }
+
+    local_memory_.mountCimUnit(cim_config_.name_as_memory, &cim_compute_engine_);
+    int group_cnt = cim_config_.macro_total_cnt / cim_config_.macro_group_size;
+    group_activation_mask_list_.resize(group_cnt);
+    group_activation_macro_cnt_list_.assign(group_cnt, cim_config_.macro_group_size);
+    group_result_list_.resize(group_cnt);
+
+    for (const auto& ins_config : config_.simd_unit_config.instruction_list) {
+        simd_ins_config_map_.emplace((ins_config.input_cnt << SIMD_INSTRUCTION_OPCODE_BIT_LENGTH) | ins_config.opcode,
+                                     &ins_config);
+    }
+}
+
+long long FunctionalCore::run(const RegionTriggerConfig* stop_trigger) {
+    long long executed_ins_cnt = 0;
+    while (ins_index_ < ins_list_.size() && (stop_trigger == nullptr || !matchTrigger(*stop_trigger))) {
+        int pc_increment = execute(ins_list_[ins_index_]);
+        if (pc_increment == 0) {
+            break;
+        }
+        ins_index_ += pc_increment;
+        executed_ins_cnt++;
+        executed_ins_cnt_++;
+    }
+    return executed_ins_cnt;
+}
+
+bool FunctionalCore::isFinished() const {
+    return ins_index_ >= ins_list_.size();
+}
+
+bool FunctionalCore::matchTrigger(const RegionTriggerConfig& trigger) const {
+    return !isFinished() && trigger.match(ins_index_, ins_list_[ins_index_].inst_group_tag, executed_ins_cnt_);
+}
+
+int FunctionalCore::getInsIndex() const {
+    return ins_index_;
+}
+
+long long FunctionalCore::getExecutedInsCount() const {
+    return executed_ins_cnt_;
+}
+
+bool FunctionalCore::checkRegValues(const std::array<int, GENERAL_REG_NUM>& general_reg_expected_values,
+                                    const std::array<int, SPECIAL_REG_NUM>& special_reg_expected_values) const {
+    for (int i = 0; i < GENERAL_REG_NUM; i++) {
+        if (general_regs_[i] != general_reg_expected_values[i]) {
+            std::cout << fmt::format("index: {}, actual: {}, expected: {}", i, general_regs_[i],
+                                     general_reg_expected_values[i])
+                      << std::endl;
+            return false;
+        }
+    }
+
+    for (int i = 0; i < SPECIAL_REG_NUM; i++) {
+        if (special_regs_[i] != special_reg_expected_values[i]) {
+            std::cout << fmt::format("index: {}, actual: {}, expected: {}", i, special_regs_[i],
+                                     special_reg_expected_values[i])
+                      << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+void FunctionalCore::loadArchState(const CoreArchState& state) {
+    ins_index_ = state.ins_index;
+    general_regs_ = state.general_regs;
+    special_regs_ = state.special_regs;
+
+    for (int group_id = 0; group_id < group_activation_mask_list_.size(); group_id++) {
+        if (group_id < state.group_activation_mask_list.size()) {
+            group_activation_mask_list_[group_id] = state.group_activation_mask_list[group_id];
+            group_activation_macro_cnt_list_[group_id] = getActivationMacroCount(group_activation_mask_list_[group_id]);
+        }
+        if (group_id < state.group_result_list.size()) {
+            group_result_list_[group_id] = state.group_result_list[group_id];
+        }
+    }
+
+    local_memory_.setDataList(state.memory_data_list);
+}
+
+void FunctionalCore::saveArchState(CoreArchState& state) const {
+    state.ins_index = ins_index_;
+    state.general_regs = general_regs_;
+    state.special_regs = special_regs_;
+    state.group_activation_mask_list = group_activation_mask_list_;
+    state.group_result_list = group_result_list_;
+    state.memory_data_list = local_memory_.getDataList();
+}
+
+int FunctionalCore::execute(const InstV2& ins) {
+    switch (ins.getOpcodeEnum()) {
+        case OPCODE::CIM_MVM: executeCimMVMIns(ins); break;
+        case OPCODE::CIM_CFG: executeCimConfigIns(ins); break;
+        case OPCODE::CIM_OUT: executeCimOutputIns(ins); break;
+        case OPCODE::VEC_OP: executeSIMDIns(ins); break;
+        case OPCODE::REDUCE: executeReduceIns(ins); break;
+        case OPCODE::SC_RR:
+        case OPCODE::SC_RI:
+        case OPCODE::SC_LD:
+        case OPCODE::SC_ST:
+        case OPCODE::SC_LDG:
+        case OPCODE::SC_STG:
+        case OPCODE::G_LI:
+        case OPCODE::S_LI:
+        case OPCODE::GS_MOV:
+        case OPCODE::SG_MOV: executeScalarIns(ins); break;
+        case OPCODE::MEM_CPY:
+        case OPCODE::SEND:
+        case OPCODE::SEND_MC:
+        case OPCODE::RECV: return executeTransferIns(ins) ? 1 : 0;
+        default: return executeControlIns(ins);
+    }
+    return 1;
+}
+
+void FunctionalCore::executeScalarIns(const InstV2& ins) {
+    auto op = ins.getOpcodeEnum();
+    if (op == +OPCODE::SC_RR) {
+        writeRegister(ins.rd,
+                      ScalarUnit::calculate(ScalarOperator::_from_integral(ins.funct), readRegister(ins.rs, false),
+                                            readRegister(ins.rt, false)),
+                      false);
+    } else if (op == +OPCODE::SC_RI) {
+        writeRegister(
+            ins.rd,
+            ScalarUnit::calculate(ScalarOperator::_from_integral(ins.funct), readRegister(ins.rs, false), ins.imm),
+            false);
+    } else if (op == +OPCODE::SC_LD || op == +OPCODE::SC_LDG) {
+        auto data = readLocal(readRegister(ins.rs, false) + ins.imm, WORD_BYTE_SIZE);
+        writeRegister(ins.rd, BytesToInt(data, true), false);
+    } else if (op == +OPCODE::SC_ST || op == +OPCODE::SC_STG) {
+        writeLocal(readRegister(ins.rs, false) + ins.imm, IntToBytes(readRegister(ins.rt, false), true));
+    } else if (op == +OPCODE::G_LI || op == +OPCODE::S_LI) {
+        writeRegister(ins.rd, ins.imm, op == +OPCODE::S_LI);
+    } else if (op == +OPCODE::GS_MOV || op == +OPCODE::SG_MOV) {
+        writeRegister(ins.rd, readRegister(ins.rs, op == +OPCODE::SG_MOV), op == +OPCODE::GS_MOV);
+    }
+}
+
+void FunctionalCore::executeCimMVMIns(const InstV2& ins) {
+    int input_addr_byte = readRegister(ins.rs, false);
+    int input_len = readRegister(ins.rt, false);
+    int row = readRegister(ins.re, false);
+    int input_bit_width = readRegister(SpecialRegId::cim_input_bit_width, true);
+    int activation_group_num = readRegister(SpecialRegId::activation_group_num, true);
+    int group_input_step_byte = readRegister(SpecialRegId::group_input_step, true);
+    if (input_bit_width <= 0) {
+        return;
+    }
+
+    if (cim_config_.bit_sparse && ins.SP_B) {
+        throw std::runtime_error{
+            fmt::format("Core {}: real data mode does not decode bit sparse weights, ins index: {}", core_id_,
+                        ins_index_)};
+    }
+
+    bool value_sparse = cim_config_.value_sparse && ins.SP_V;
+    std::vector<unsigned char> value_sparse_mask;
+    if (value_sparse) {
+        int max_activation_macro_cnt =
+            *std::max_element(group_activation_macro_cnt_list_.begin(), group_activation_macro_cnt_list_.end());
+        value_sparse_mask =
+            readLocal(readRegister(SpecialRegId::value_sparse_mask_addr, true),
+                      cim_config_.value_sparse_config.mask_bit_width * input_len * max_activation_macro_cnt /
+                          BYTE_TO_BIT);
+    }
+
+    // groups are spread across workers, then collected in group order
+    int size_byte = input_bit_width * input_len / BYTE_TO_BIT;
+    int group_cnt = std::min(activation_group_num, static_cast<int>(group_result_list_.size()));
+    std::vector<std::future<std::vector<long long>>> computing_result_list;
+    computing_result_list.reserve(group_cnt);
+    for (int group_id = 0; group_id < group_cnt; group_id++) {
+        auto inputs = MacroGroupInputs::fromReadData(
+            readLocal(input_addr_byte + group_input_step_byte * group_id, size_byte), input_bit_width, input_len,
+            group_activation_macro_cnt_list_[group_id], macro_size_.compartment_cnt_per_macro,
+            value_sparse ? &value_sparse_mask : nullptr);
+        computing_result_list.emplace_back(cim_compute_engine_.computeGroupAsync(
+            group_id, row, std::move(inputs), group_activation_mask_list_[group_id]));
+    }
+    for (int group_id = 0; group_id < group_cnt; group_id++) {
+        group_result_list_[group_id] = computing_result_list[group_id].get();
+    }
+}
+
+void FunctionalCore::executeCimConfigIns(const InstV2& ins) {
+    int group_id = readRegister(ins.rs, false);
+    int mask_size_byte =
+        IntDivCeil(1 * macro_size_.element_cnt_per_compartment * cim_config_.macro_group_size, BYTE_TO_BIT);
+    auto mask_byte_data = readLocal(readRegister(ins.rt, false), mask_size_byte);
+    int activation_macro_cnt = getActivationMacroCount(mask_byte_data);
+
+    for (int id = 0; id < group_activation_mask_list_.size(); id++) {
+        if (ins.GRP_B || id == group_id) {
+            group_activation_mask_list_[id] = mask_byte_data;
+            group_activation_macro_cnt_list_[id] = activation_macro_cnt;
+        }
+    }
+}
+
+void FunctionalCore::executeCimOutputIns(const InstV2& ins) {
+    CimControlInsPayload p;
+    p.op = ins.OSUM_MOV ? CimControlOperator::output_sum_move
+           : ins.OSUM   ? CimControlOperator::output_sum
+                        : CimControlOperator::only_output;
+    p.activation_group_num = readRegister(SpecialRegId::activation_group_num, true);
+    p.output_addr_byte = readRegister(ins.rd, false);
+    p.output_cnt_per_group = readRegister(ins.rs, false);
+    p.output_bit_width = readRegister(SpecialRegId::cim_output_bit_width, true);
+    p.output_mask_addr_byte = readRegister(ins.rt, false);
+
+    std::vector<unsigned char> sum_mask;
+    int valid_output_cnt_per_group = p.output_cnt_per_group;
+    if (p.op == +CimControlOperator::output_sum) {
+        sum_mask = readLocal(p.output_mask_addr_byte, IntDivCeil(p.output_cnt_per_group, BYTE_TO_BIT));
+        valid_output_cnt_per_group -= countMaskBits(sum_mask, 0, p.output_cnt_per_group);
+    }
+
+    int size_byte = IntDivCeil(p.output_bit_width * valid_output_cnt_per_group * p.activation_group_num, BYTE_TO_BIT);
+    writeLocal(p.output_addr_byte,
+               CimControlUnit::packOutputData(p, size_byte, sum_mask,
+                                              [this](int group_id) -> const std::vector<long long>& {
+                                                  static const std::vector<long long> empty_result{};
+                                                  return group_id < group_result_list_.size()
+                                                             ? group_result_list_[group_id]
+                                                             : empty_result;
+                                              }));
+}
+
+void FunctionalCore::executeSIMDIns(const InstV2& ins) {
+    auto input_cnt = static_cast<unsigned int>(((ins.opcode >> 2) & 0b11) + 1);
+    auto found = simd_ins_config_map_.find((input_cnt << SIMD_INSTRUCTION_OPCODE_BIT_LENGTH) |
+                                           static_cast<unsigned int>(ins.funct));
+    if (found == simd_ins_config_map_.end()) {
+        std::cerr << fmt::format("Core {}, no match inst, Invalid SIMD instruction: {}", core_id_, ins.toString())
+                  << std::endl;
+        return;
+    }
+    const auto& ins_cfg = *found->second;
+
+    const std::array<int, 4> input_address_list{
+        readRegister(ins.rs, false), input_cnt < 2 ? 0 : readRegister(ins.rt, false),
+        input_cnt < 3 ? 0 : readRegister(SpecialRegId::simd_input_3_address, true),
+        input_cnt < 4 ? 0 : readRegister(SpecialRegId::simd_input_4_address, true)};
+    const std::array<int, 4> input_bit_width_list{readRegister(SpecialRegId::vector_input_1_bit_width, true),
+                                                  readRegister(SpecialRegId::vector_input_2_bit_width, true),
+                                                  readRegister(SpecialRegId::vector_input_3_bit_width, true),
+                                                  readRegister(SpecialRegId::vector_input_4_bit_width, true)};
+    int output_bit_width = readRegister(SpecialRegId::vector_output_bit_width, true);
+    int len = readRegister(ins.re, false);
+
+    bool has_vector_input = false;
+    for (unsigned int i = 0; i < input_cnt; i++) {
+        has_vector_input = has_vector_input || ins_cfg.inputs_type[i] == +SIMDInputType::vector;
+    }
+    int vector_total_len = has_vector_input ? len : 1;
+
+    std::vector<std::vector<uint8_t>> input_data_list(input_cnt);
+    std::vector<KernelOperand> inputs;
+    for (unsigned int i = 0; i < input_cnt; i++) {
+        bool scalar = ins_cfg.inputs_type[i] == +SIMDInputType::scalar;
+        int size_byte = input_bit_width_list[i] * (scalar ? 1 : vector_total_len) / BYTE_TO_BIT;
+        input_data_list[i] = readLocal(input_address_list[i], size_byte);
+        inputs.emplace_back(
+            KernelOperand{.data = input_data_list[i].data(), .bit_width = input_bit_width_list[i], .scalar = scalar});
+    }
+
+    std::vector<uint8_t> output_data(vector_total_len * output_bit_width / BYTE_TO_BIT, 0);
+    if (runSIMDKernel(ins_cfg.opcode, inputs, output_data.data(), output_bit_width, vector_total_len)) {
+        writeLocal(readRegister(ins.rd, false), output_data);
+    }
+}
+
+void FunctionalCore::executeReduceIns(const InstV2& ins) {
+    int input_bit_width = readRegister(SpecialRegId::vector_input_1_bit_width, true);
+    int output_bit_width = readRegister(SpecialRegId::vector_output_bit_width, true);
+    int length = readRegister(ins.rt, false);
+
+    const auto& functor_list = config_.reduce_unit_config.functor_list;
+    auto found = std::find_if(functor_list.begin(), functor_list.end(), [&](const ReduceFunctorConfig& func_cfg) {
+        return func_cfg.funct == ins.funct && func_cfg.input_bit_width == input_bit_width &&
+               func_cfg.output_bit_width == output_bit_width;
+    });
+    if (found == functor_list.end()) {
+        std::cerr << fmt::format("Core {}, no match functor, Invalid Reduce instruction: {}", core_id_,
+                                 ins.toString())
+                  << std::endl;
+        return;
+    }
+
+    auto input_data = readLocal(readRegister(ins.rs, false), input_bit_width * length / BYTE_TO_BIT);
+    int output_cnt = IntDivCeil(length, found->reduce_input_cnt);
+    std::vector<uint8_t> output_data(IntDivCeil(output_bit_width * output_cnt, BYTE_TO_BIT), 0);
+    for (int i = 0; i < output_cnt; i++) {
+        int batch_len = std::min(found->reduce_input_cnt, length - i * found->reduce_input_cnt);
+        const auto* batch_data = input_data.data() + i * found->reduce_input_cnt * input_bit_width / BYTE_TO_BIT;
+        if (!runReduceKernel(found->funct, KernelOperand{.data = batch_data, .bit_width = input_bit_width}, batch_len,
+                             output_data.data(), output_bit_width, i)) {
+            return;
+        }
+    }
+    output_data.resize(output_bit_width * output_cnt / BYTE_TO_BIT);
+    writeLocal(readRegister(ins.rd, false), output_data);
+}
+
+bool FunctionalCore::executeTransferIns(const InstV2& ins) {
+    const auto& as = AddressSapce::getInstance();
+    auto op = ins.getOpcodeEnum();
+    if (op == +OPCODE::MEM_CPY) {
+        int src_address_byte = readRegister(ins.rs, false) + ((ins.opcode & 0b000010) != 0 ? ins.imm : 0);
+        int dst_address_byte = readRegister(ins.rd, false) + ((ins.opcode & 0b000001) != 0 ? ins.imm : 0);
+        int size_byte = readRegister(ins.rt, false);
+
+        std::vector<uint8_t> data;
+        if (as.isAddressGlobal(src_address_byte)) {
+            global_memory_.read(src_address_byte, size_byte, data);
+        } else {
+            data = readLocal(src_address_byte, size_byte);
+        }
+        if (as.isAddressGlobal(dst_address_byte)) {
+            global_memory_.write(dst_address_byte, data);
+        } else {
+            writeLocal(dst_address_byte, data);
+        }
+    } else if (op == +OPCODE::SEND || op == +OPCODE::SEND_MC) {
+        int dst_id = readRegister(ins.rt, false);
+        int dst_cnt = 1;
+        if (op == +OPCODE::SEND_MC) {
+            // rt holds destination core range: (dst_cnt << 16) | first dst_id
+            dst_cnt = (dst_id >> 16) & 0xffff;
+            dst_id = dst_id & 0xffff;
+        }
+        auto data = readLocal(readRegister(ins.rs, false), readRegister(ins.re, false));
+        int transfer_id_tag = readRegister(ins.rf, false);
+        for (int i = 0; i < dst_cnt; i++) {
+            network_.send(core_id_, dst_id + i, transfer_id_tag, data);
+        }
+    } else if (op == +OPCODE::RECV) {
+        std::vector<uint8_t> data;
+        if (!network_.receive(readRegister(ins.rs, false), core_id_, readRegister(ins.rf, false), data)) {
+            return false;
+        }
+        data.resize(readRegister(ins.re, false), 0);
+        writeLocal(readRegister(ins.rd, false), data);
+    }
+    return true;
+}
+
+int FunctionalCore::executeControlIns(const InstV2& ins) const {
+    auto op = ins.getOpcodeEnum();
+    if (op == +OPCODE::JMP) {
+        return ins.imm;
+    }
+
+    int src_value1 = readRegister(ins.rs, false);
+    int src_value2 = readRegister(ins.rt, false);
+    bool branch = false;
+    switch (op) {
+        case OPCODE::BEQ: branch = (src_value1 == src_value2); break;
+        case OPCODE::BNE: branch = (src_value1 != src_value2); break;
+        case OPCODE::BGT: branch = (src_value1 > src_value2); break;
+        case OPCODE::BLT: branch = (src_value1 < src_value2); break;
+        default: break;
+    }
+    return branch ? ins.imm : 1;
+}
+
+int FunctionalCore::getActivationMacroCount(const std::vector<unsigned char>& mask) const {
+    if (mask.empty()) {
+        return cim_config_.macro_group_size;
+    }
+
+    int activation_macro_cnt = 0;
+    for (int macro_id = 0; macro_id < cim_config_.macro_group_size; macro_id++) {
+        int start_index = macro_id * macro_size_.element_cnt_per_compartment;
+        if (countMaskBits(mask, start_index, macro_size_.element_cnt_per_compartment) > 0) {
+            activation_macro_cnt++;
+        }
+    }
+    return activation_macro_cnt;
+}
+
+int FunctionalCore::readRegister(int id, bool special) const {
+    if (!special) {
+        return general_regs_[id];
+    }
+
+    if (auto found = special_bind_map_.find(id); found != special_bind_map_.end()) {
+        return general_regs_[found->second];
+    }
+    return special_regs_[id];
+}
+
+void FunctionalCore::writeRegister(int id, int value, bool special) {
+    if (!special) {
+        general_regs_[id] = value;
+    } else if (auto found = special_bind_map_.find(id); found != special_bind_map_.end()) {
+        general_regs_[found->second] = value;
+    } else {
+        special_regs_[id] = value;
+    }
+}
+
+std::vector<uint8_t> FunctionalCore::readLocal(int address_byte, int size_byte) const {
+    std::vector<uint8_t> data;
+    if (!local_memory_.read(address_byte, size_byte, data)) {
+        std::cerr << fmt::format("Core {}, ins index {}, invalid local memory read", core_id_, ins_index_)
+                  << std::endl;
+        data.assign(std::max(size_byte, 0), 0);
+    }
+    return data;
+}
+
+void FunctionalCore::writeLocal(int address_byte, const std::vector<uint8_t>& data) {
+    if (!local_memory_.write(address_byte, data)) {
+        std::cerr << fmt::format("Core {}, ins index {}, invalid local memory write", core_id_, ins_index_)
+                  << std::endl;
+    }
+}
+
+}  // namespace cimsim
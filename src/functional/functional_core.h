@@ -0,0 +1,103 @@
+#pragma once
+#include <array>
+#include <map>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "config/config.h"
+#include "config/constant.h"
+#include "core/arch_state.h"
+#include "core/cim_unit/cim_compute_engine.h"
+#include "functional_memory.h"
+#include "isa/inst_v2.h"
+
+namespace cimsim {
+
+class FunctionalNetwork {
+    // data sent between cores, matched by (src core, dst core, transfer id tag) in send order
+public:
+    void send(int src_id, int dst_id, int transfer_id_tag, std::vector<uint8_t> data);
+    // false if matched data has not been sent yet
+    bool receive(int src_id, int dst_id, int transfer_id_tag, std::vector<uint8_t>& data);
+
+    [[nodiscard]] int getPendingMessageCount() const;
+
+private:
+    std::map<std::tuple<int, int, int>, std::queue<std::vector<uint8_t>>> message_queue_map_;
+};
+
+class FunctionalCore {
+    /* Functional instruction set simulation of one core, without timing and energy.
+     * Instructions are decoded and executed in program order, the same as the timed core with all data conflicts
+     * resolved, registers follow RegUnit, cim/simd/reduce use the same functional kernels as real data mode.
+     */
+public:
+    FunctionalCore(const CoreConfig& config, int core_id, std::vector<InstV2> ins_list, FunctionalMemory& global_memory,
+                   FunctionalNetwork& network);
+
+    // execute until all instructions finish, a receive is blocked or the next instruction matches stop trigger,
+    // return count of executed instructions
+    long long run(const RegionTriggerConfig* stop_trigger = nullptr);
+
+    [[nodiscard]] bool isFinished() const;
+    [[nodiscard]] bool matchTrigger(const RegionTriggerConfig& trigger) const;
+    [[nodiscard]] int getInsIndex() const;
+    [[nodiscard]] long long getExecutedInsCount() const;
+
+    bool checkRegValues(const std::array<int, GENERAL_REG_NUM>& general_reg_expected_values,
+                        const std::array<int, SPECIAL_REG_NUM>& special_reg_expected_values) const;
+
+    void loadArchState(const CoreArchState& state);
+    void saveArchState(CoreArchState& state) const;
+
+private:
+    // return pc increment, 0 means the instruction is blocked and not executed
+    int execute(const InstV2& ins);
+
+    void executeScalarIns(const InstV2& ins);
+    void executeCimMVMIns(const InstV2& ins);
+    void executeCimConfigIns(const InstV2& ins);
+    void executeCimOutputIns(const InstV2& ins);
+    void executeSIMDIns(const InstV2& ins);
+    void executeReduceIns(const InstV2& ins);
+    bool executeTransferIns(const InstV2& ins);
+    int executeControlIns(const InstV2& ins) const;
+
+    [[nodiscard]] int getActivationMacroCount(const std::vector<unsigned char>& mask) const;
+
+    [[nodiscard]] int readRegister(int id, bool special) const;
+    void writeRegister(int id, int value, bool special);
+
+    [[nodiscard]] std::vector<uint8_t> readLocal(int address_byte, int size_byte) const;
+    void writeLocal(int address_byte, const std::vector<uint8_t>& data);
+
+private:
+    const CoreConfig& config_;
+    const CimUnitConfig& cim_config_;
+    const CimMacroSizeConfig& macro_size_;
+    const int core_id_;
+
+    std::vector<InstV2> ins_list_;
+    int ins_index_{0};
+    long long executed_ins_cnt_{0};
+
+    std::array<int, GENERAL_REG_NUM> general_regs_{};
+    std::array<int, SPECIAL_REG_NUM> special_regs_{};
+    std::unordered_map<int, int> special_bind_map_{};
+
+    CimComputeEngine cim_compute_engine_;
+    FunctionalMemory local_memory_;
+    FunctionalMemory& global_memory_;
+    FunctionalNetwork& network_;
+
+    // cim unit state of every macro group
+    std::vector<std::vector<unsigned char>> group_activation_mask_list_;
+    std::vector<int> group_activation_macro_cnt_list_;
+    std::vector<std::vector<long long>> group_result_list_;
+
+    std::unordered_map<unsigned int, const SIMDInstructionConfig*> simd_ins_config_map_;
+};
+
+}  // namespace cimsim
@@ -0,0 +1,130 @@
+#include "functional_memory.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#include "fmt/format.h"
+#include "util/util.h"
+
+namespace cimsim {
+
+namespace {
+
+std::pair<bool, const std::string&> getMemoryImage(const MemoryConfig& mem_cfg) {
+    if (mem_cfg.type == +MemoryType::ram) {
+        return {mem_cfg.ram_config.has_image, mem_cfg.ram_config.image_file};
+    }
+    if (mem_cfg.type == +MemoryType::dram) {
+        return {mem_cfg.dram_config.has_image, mem_cfg.dram_config.image_file};
+    }
+    return {mem_cfg.reg_buffer_config.has_image, mem_cfg.reg_buffer_config.image_file};
+}
+
+}  // namespace
+
+FunctionalMemory::FunctionalMemory(const MemoryUnitConfig& config, bool is_global)
+    : as_(AddressSapce::getInstance()), is_global_(is_global) {
+    memory_list_.resize(as_.getMemoryCount(is_global_));
+    for (const auto& mem_cfg : config.memory_list) {
+        const auto& [has_image, image_file] = getMemoryImage(mem_cfg);
+        for (int duplicate_id = 0; duplicate_id < mem_cfg.duplicate_cnt; duplicate_id++) {
+            std::string mem_name = getDuplicateMemoryName(mem_cfg.getMemoryName(), duplicate_id);
+            auto& memory = memory_list_[as_.getMemoryId(mem_name)];
+            memory.as_offset = as_.getMemoryAddressSpaceOffset(mem_name);
+            memory.size_byte = mem_cfg.getByteSize();
+            memory.data.assign(memory.size_byte, 0);
+            if (has_image) {
+                std::ifstream ifs;
+                ifs.open(image_file, std::ios::in | std::ios::binary);
+                ifs.read(reinterpret_cast<char*>(memory.data.data()), memory.size_byte);
+                ifs.close();
+            }
+        }
+    }
+}
+
+void FunctionalMemory::mountCimUnit(const std::string& name, CimComputeEngine* compute_engine) {
+    auto& memory = memory_list_[as_.getMemoryId(name)];
+    memory.as_offset = as_.getMemoryAddressSpaceOffset(name);
+    memory.compute_engine = compute_engine;
+}
+
+bool FunctionalMemory::read(int address_byte, int size_byte, std::vector<uint8_t>& data) const {
+    int mem_id = getMemoryIdByAddress(address_byte, size_byte);
+    if (mem_id == -1) {
+        return false;
+    }
+
+    const auto& memory = memory_list_[mem_id];
+    int offset_byte = address_byte - memory.as_offset;
+    if (memory.compute_engine != nullptr) {
+        memory.compute_engine->read(offset_byte, size_byte, data);
+    } else {
+        data.assign(memory.data.begin() + offset_byte, memory.data.begin() + offset_byte + size_byte);
+    }
+    return true;
+}
+
+bool FunctionalMemory::write(int address_byte, const std::vector<uint8_t>& data) {
+    int mem_id = getMemoryIdByAddress(address_byte, static_cast<int>(data.size()));
+    if (mem_id == -1) {
+        return false;
+    }
+
+    auto& memory = memory_list_[mem_id];
+    int offset_byte = address_byte - memory.as_offset;
+    if (memory.compute_engine != nullptr) {
+        memory.compute_engine->write(offset_byte, data);
+    } else {
+        std::copy(data.begin(), data.end(), memory.data.begin() + offset_byte);
+    }
+    return true;
+}
+
+std::vector<std::vector<uint8_t>> FunctionalMemory::getDataList() const {
+    std::vector<std::vector<uint8_t>> data_list(memory_list_.size());
+    for (int mem_id = 0; mem_id < memory_list_.size(); mem_id++) {
+        const auto& memory = memory_list_[mem_id];
+        if (memory.compute_engine != nullptr) {
+            memory.compute_engine->read(0, memory.compute_engine->getByteSize(), data_list[mem_id]);
+        } else {
+            data_list[mem_id] = memory.data;
+        }
+    }
+    return data_list;
+}
+
+void FunctionalMemory::setDataList(const std::vector<std::vector<uint8_t>>& data_list) {
+    for (int mem_id = 0; mem_id < memory_list_.size() && mem_id < data_list.size(); mem_id++) {
+        auto& memory = memory_list_[mem_id];
+        const auto& data = data_list[mem_id];
+        if (memory.compute_engine != nullptr) {
+            if (data.size() == memory.compute_engine->getByteSize()) {
+                memory.compute_engine->write(0, data);
+            }
+        } else {
+            std::copy_n(data.begin(), std::min(data.size(), memory.data.size()), memory.data.begin());
+        }
+    }
+}
+
+int FunctionalMemory::getMemoryIdByAddress(int address_byte, int size_byte) const {
+    int mem_id = is_global_ ? as_.getGlobalMemoryId(address_byte) : as_.getLocalMemoryId(address_byte);
+    if (mem_id < 0 || mem_id >= memory_list_.size()) {
+        return -1;
+    }
+
+    const auto& memory = memory_list_[mem_id];
+    int offset_byte = address_byte - memory.as_offset;
+    int memory_size_byte = memory.compute_engine != nullptr ? memory.compute_engine->getByteSize() : memory.size_byte;
+    if (offset_byte < 0 || offset_byte + size_byte > memory_size_byte) {
+        std::cerr << fmt::format("Invalid functional memory access: address {} overflow, size: {}, memory size: {}",
+                                 address_byte, size_byte, memory_size_byte)
+                  << std::endl;
+        return -1;
+    }
+    return mem_id;
+}
+
+}  // namespace cimsim
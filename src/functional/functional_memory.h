@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "address_space/address_space.h"
+#include "config/config.h"
+#include "core/cim_unit/cim_compute_engine.h"
+
+namespace cimsim {
+
+class FunctionalMemory {
+    /* Data of all memories in one memory unit for functional simulation, accessed by address in the address space.
+     * Memories are plain byte arrays initialized with their image files, the cim unit is mounted with its compute
+     * engine, so weights written through memory are seen by cim computing.
+     */
+public:
+    FunctionalMemory(const MemoryUnitConfig& config, bool is_global);
+
+    void mountCimUnit(const std::string& name, CimComputeEngine* compute_engine);
+
+    bool read(int address_byte, int size_byte, std::vector<uint8_t>& data) const;
+    bool write(int address_byte, const std::vector<uint8_t>& data);
+
+    // data of every memory by memory id, as architectural state
+    [[nodiscard]] std::vector<std::vector<uint8_t>> getDataList() const;
+    void setDataList(const std::vector<std::vector<uint8_t>>& data_list);
+
+private:
+    struct MemoryData {
+        int as_offset{0};
+        int size_byte{0};
+        std::vector<uint8_t> data{};
+        CimComputeEngine* compute_engine{nullptr};
+    };
+
+    // -1 if address does not match any memory or access overflows
+    [[nodiscard]] int getMemoryIdByAddress(int address_byte, int size_byte) const;
+
+private:
+    const AddressSapce& as_;
+    bool is_global_;
+    std::vector<MemoryData> memory_list_;
+};
+
+}  // namespace cimsim
@@ -39,6 +39,9 @@ namespace cimsim {
 #define INST_V2_TO_JSON_STR_WRITE_FLAGS(...) CIM_PASTE(INST_V2_TO_JSON_STR_WRITE_FLAG, DELIMITER_SPACE, __VA_ARGS__)
 
 OPCODE_CLASS InstV2::getOpcodeClass() const {
+    if (opcode == OPCODE::SEND_MC) {
+        return OPCODE_CLASS::TRANS;
+    }
     if ((opcode & OPCODE_MASK::INST_CLASS_2BIT) != OPCODE_CLASS::TRANS) {
         return OPCODE_CLASS::_from_integral(opcode & OPCODE_MASK::INST_CLASS_2BIT);
     }
@@ -52,6 +55,9 @@ OPCODE InstV2::getOpcodeEnum() const {
     if ((opcode & OPCODE_MASK::TRANS_TYPE_4BIT) == OPCODE::MEM_CPY) {
         return OPCODE::MEM_CPY;
     }
+    if (opcode == OPCODE::SEND_MC) {
+        return OPCODE::SEND_MC;
+    }
     if ((opcode & OPCODE_MASK::TRANS_TYPE_5BIT) == OPCODE::SEND) {
         return OPCODE::SEND;
     }
@@ -113,6 +119,10 @@ std::string InstV2::toString() const {
             break;
         }
         case OPCODE::SEND: ss << fmt::format("${} to [${}]${}, size: ${}, trans-id: ${}", rs, rt, rd, re, rf); break;
+        case OPCODE::SEND_MC: {
+            ss << fmt::format("${} to [${}]${}, size: ${}, trans-id: ${}, multicast", rs, rt, rd, re, rf);
+            break;
+        }
         case OPCODE::RECV: ss << fmt::format("[${}]${} to ${}, size: ${}, trans-id: ${}", rs, rt, rd, re, rf); break;
         case OPCODE::BEQ:
         case OPCODE::BNE:
@@ -22,7 +22,10 @@ BETTER_ENUM(OPCODE, int,  // NOLINT(*-explicit-constructor)
             MEM_CPY = 0b110000, SEND = 0b110100, RECV = 0b110110,
 
             BEQ = 0b111000, BNE = 0b111001, BGT = 0b111010, BLT = 0b111011, JMP = 0b111100, WAIT = 0b111101,
-            BARRIER = 0b111110)
+            BARRIER = 0b111110,
+
+            // multicast send takes the last free opcode, which is in control class space but is a transfer
+            SEND_MC = 0b111111)
 
 BETTER_ENUM(OPCODE_MASK, int,  // NOLINT(*-explicit-constructor)
             INST_CLASS_2BIT = 0b110000, INST_CLASS_3BIT = 0b111000,
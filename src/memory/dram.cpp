@@ -0,0 +1,240 @@
+#include "dram.h"
+
+#include <algorithm>
+
+#include "fmt/format.h"
+#include "util/util.h"
+
+namespace cimsim {
+
+DRAM::DRAM(const sc_module_name &name, const std::string &mem_name, const DRAMConfig &config,
+           const BaseInfo &base_info)
+    : MemoryHardware(name, base_info)
+    , config_(config)
+    , mem_name_(mem_name)
+    , bank_state_list_(config.channel_cnt * config.rank_cnt * config.bank_cnt)
+    , channel_bus_free_cycle_list_(config.channel_cnt, 0)
+    , next_refresh_cycle_(config.tREFI_cycle) {
+    if (data_mode_ == +DataMode::real_data) {
+        initialData();
+    }
+
+    energy_counter_.setStaticPowerMW(config_.static_power_mW);
+    energy_counter_.addSubEnergyCounter("activate", &activate_energy_counter_);
+    energy_counter_.addSubEnergyCounter("read", &read_energy_counter_);
+    energy_counter_.addSubEnergyCounter("write", &write_energy_counter_);
+    energy_counter_.addSubEnergyCounter("refresh", &refresh_energy_counter_);
+    activate_energy_counter_.addDynamicPowerParam(config_.activate_dynamic_power_mW);
+    read_energy_counter_.addDynamicPowerParam(config_.read_dynamic_power_mW);
+    write_energy_counter_.addDynamicPowerParam(config_.write_dynamic_power_mW);
+    refresh_energy_counter_.addDynamicPowerParam(config_.refresh_dynamic_power_mW);
+}
+
+sc_time DRAM::accessAndGetDelay(MemoryAccessPayload &payload) {
+    return accessListAndGetDelay({&payload})[0];
+}
+
+bool DRAM::schedulesAccessList() const {
+    return true;
+}
+
+std::vector<sc_time> DRAM::accessListAndGetDelay(const std::vector<MemoryAccessPayload *> &payload_list) {
+    const auto now_cycle = static_cast<int64_t>(sc_time_stamp().to_seconds() * 1e9 / period_ns_);
+    refreshUntil(now_cycle);
+
+    // bursts in arrival order of their accesses, so FR-FCFS falls back to the oldest access
+    std::vector<Burst> pending_bursts;
+    std::vector<ProfilerTag> profiler_tag_list;
+    std::vector<std::string> profiler_operator_list;
+    profiler_operator_list.reserve(payload_list.size());
+    for (int payload_index = 0; payload_index < payload_list.size(); payload_index++) {
+        const auto &payload = *payload_list[payload_index];
+        const bool is_read = payload.access_type == +MemoryAccessType::read;
+        profiler_operator_list.emplace_back(mem_name_ + (is_read ? "_read" : "_write"));
+        profiler_tag_list.push_back({.core_id = core_id_,
+                                     .ins_id = payload.ins.ins_id,
+                                     .inst_opcode = payload.ins.inst_opcode,
+                                     .inst_group_tag = payload.ins.inst_group_tag,
+                                     .inst_profiler_operator = profiler_operator_list.back()});
+        if (!checkAccess(payload)) {
+            continue;
+        }
+        int start_address_byte = payload.address_byte / config_.width_byte * config_.width_byte;
+        for (int address = start_address_byte; address < payload.address_byte + payload.size_byte;
+             address += config_.width_byte) {
+            auto burst = decodeAddress(address);
+            burst.payload_index = payload_index;
+            pending_bursts.push_back(burst);
+        }
+    }
+
+    std::vector<int64_t> finish_cycle_list(payload_list.size(), now_cycle);
+    while (!pending_bursts.empty()) {
+        int index = selectNextBurst(pending_bursts);
+        auto burst = pending_bursts[index];
+        pending_bursts.erase(pending_bursts.begin() + index);
+
+        const auto &payload = *payload_list[burst.payload_index];
+        const auto &profiler_tag = profiler_tag_list[burst.payload_index];
+        auto &bank = getBankState(burst);
+        // a refresh due before the burst issues delays it and closes its row
+        int64_t cmd_cycle = std::max(now_cycle, bank.ready_cycle);
+        while (refreshUntil(cmd_cycle)) {
+            cmd_cycle = std::max(now_cycle, bank.ready_cycle);
+        }
+        if (bank.open_row != burst.row) {
+            if (bank.open_row != -1) {
+                // row conflict, precharge first
+                cmd_cycle = std::max(cmd_cycle, bank.activate_cycle + config_.tRAS_cycle) + config_.tRP_cycle;
+            }
+            bank.activate_cycle = cmd_cycle;
+            bank.open_row = burst.row;
+            activate_energy_counter_.addDynamicEnergyPJ(config_.tRCD_cycle * period_ns_,
+                                                        config_.activate_dynamic_power_mW, 1, profiler_tag);
+            cmd_cycle += config_.tRCD_cycle;
+        }
+
+        auto &bus_free_cycle = channel_bus_free_cycle_list_[burst.channel];
+        int64_t data_cycle = std::max(cmd_cycle + config_.tCL_cycle, bus_free_cycle);
+        bus_free_cycle = data_cycle + config_.tBL_cycle;
+        bank.ready_cycle = cmd_cycle + config_.tBL_cycle;
+        if (config_.page_policy == +DRAMPagePolicy::closed_page) {
+            bank.ready_cycle =
+                std::max(bus_free_cycle, bank.activate_cycle + config_.tRAS_cycle) + config_.tRP_cycle;
+            bank.open_row = -1;
+        }
+        auto &finish_cycle = finish_cycle_list[burst.payload_index];
+        finish_cycle = std::max(finish_cycle, bus_free_cycle);
+
+        if (payload.access_type == +MemoryAccessType::read) {
+            read_energy_counter_.addDynamicEnergyPJ(config_.tBL_cycle * period_ns_, config_.read_dynamic_power_mW, 1,
+                                                    profiler_tag);
+        } else {
+            write_energy_counter_.addDynamicEnergyPJ(config_.tBL_cycle * period_ns_, config_.write_dynamic_power_mW, 1,
+                                                     profiler_tag);
+        }
+    }
+
+    std::vector<sc_time> delay_list;
+    for (int payload_index = 0; payload_index < payload_list.size(); payload_index++) {
+        if (checkAccess(*payload_list[payload_index])) {
+            accessData(*payload_list[payload_index]);
+        }
+        delay_list.emplace_back(static_cast<double>(finish_cycle_list[payload_index] - now_cycle) * period_ns_, SC_NS);
+    }
+    return delay_list;
+}
+
+sc_time DRAM::getNextIssueTime() const {
+    auto bank = std::min_element(bank_state_list_.begin(), bank_state_list_.end(),
+                                 [](const BankState &a, const BankState &b) { return a.ready_cycle < b.ready_cycle; });
+    return {static_cast<double>(bank->ready_cycle) * period_ns_, SC_NS};
+}
+
+void DRAM::resetTiming(const sc_time &start_time) {
+    const auto start_cycle = static_cast<int64_t>(start_time.to_seconds() * 1e9 / period_ns_);
+    bank_state_list_.assign(bank_state_list_.size(), BankState{});
+    channel_bus_free_cycle_list_.assign(channel_bus_free_cycle_list_.size(), 0);
+    next_refresh_cycle_ = start_cycle + config_.tREFI_cycle;
+}
+
+int DRAM::getMemoryDataWidthByte(MemoryAccessType access_type) const {
+    return config_.width_byte;
+}
+
+int DRAM::getMemorySizeByte() const {
+    return config_.size_byte;
+}
+
+std::vector<uint8_t> DRAM::getData() const {
+    return data_;
+}
+
+void DRAM::setData(const std::vector<uint8_t> &data) {
+    if (data_mode_ == +DataMode::real_data) {
+        std::copy_n(data.begin(), std::min(data.size(), data_.size()), data_.begin());
+    }
+}
+
+void DRAM::initialData() {
+    data_ = std::vector<uint8_t>(config_.size_byte, 0);
+    if (config_.has_image) {
+        std::ifstream ifs;
+        ifs.open(config_.image_file, std::ios::in | std::ios::binary);
+        ifs.read(reinterpret_cast<char *>(data_.data()), config_.size_byte);
+        ifs.close();
+    }
+}
+
+bool DRAM::checkAccess(const MemoryAccessPayload &payload) const {
+    if (payload.address_byte < 0 || payload.address_byte + payload.size_byte > config_.size_byte) {
+        std::cerr << fmt::format("Core id: {}, Invalid memory access with ins NO.'{}': address {} overflow, size: {}, "
+                                 "config size: {}",
+                                 core_id_, payload.ins.pc, payload.address_byte, payload.size_byte, config_.size_byte)
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void DRAM::accessData(MemoryAccessPayload &payload) {
+    if (data_mode_ != +DataMode::real_data) {
+        return;
+    }
+    if (payload.access_type == +MemoryAccessType::read) {
+        payload.data.resize(payload.size_byte);
+        std::copy_n(data_.begin() + payload.address_byte, payload.size_byte, payload.data.begin());
+    } else {
+        std::copy(payload.data.begin(), payload.data.end(), data_.begin() + payload.address_byte);
+    }
+}
+
+DRAM::Burst DRAM::decodeAddress(int address_byte) const {
+    int index = address_byte / config_.row_size_byte;
+    int channel = index % config_.channel_cnt;
+    index /= config_.channel_cnt;
+    int bank = index % config_.bank_cnt;
+    index /= config_.bank_cnt;
+    int rank = index % config_.rank_cnt;
+    int row = index / config_.rank_cnt;
+    return {.channel = channel, .rank = rank, .bank = bank, .row = row};
+}
+
+DRAM::BankState &DRAM::getBankState(const Burst &burst) {
+    return bank_state_list_[(burst.channel * config_.rank_cnt + burst.rank) * config_.bank_cnt + burst.bank];
+}
+
+bool DRAM::refreshUntil(int64_t cycle) {
+    if (config_.tREFI_cycle <= 0 || next_refresh_cycle_ > cycle) {
+        return false;
+    }
+    // all-bank refresh, every rank of every channel is refreshed at the same time
+    while (next_refresh_cycle_ <= cycle) {
+        for (auto &bank : bank_state_list_) {
+            int64_t refresh_start_cycle = std::max(next_refresh_cycle_, bank.ready_cycle);
+            if (bank.open_row != -1) {
+                refresh_start_cycle =
+                    std::max(refresh_start_cycle, bank.activate_cycle + config_.tRAS_cycle) + config_.tRP_cycle;
+                bank.open_row = -1;
+            }
+            bank.ready_cycle = refresh_start_cycle + config_.tRFC_cycle;
+        }
+        refresh_energy_counter_.addDynamicEnergyPJ(config_.tRFC_cycle * period_ns_, config_.refresh_dynamic_power_mW,
+                                                   config_.channel_cnt * config_.rank_cnt);
+        next_refresh_cycle_ += config_.tREFI_cycle;
+    }
+    return true;
+}
+
+int DRAM::selectNextBurst(const std::vector<Burst> &pending_bursts) {
+    // FR-FCFS: first ready (row hit) burst in scheduler window, otherwise the oldest one
+    int window = std::min(config_.scheduler_window, static_cast<int>(pending_bursts.size()));
+    for (int i = 0; i < window; i++) {
+        if (getBankState(pending_bursts[i]).open_row == pending_bursts[i].row) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+}  // namespace cimsim
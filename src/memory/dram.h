@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "config/config.h"
+#include "memory_hardware.h"
+
+namespace cimsim {
+
+class DRAM : public MemoryHardware {
+public:
+    SC_HAS_PROCESS(DRAM);
+
+    DRAM(const sc_module_name& name, const std::string& mem_name, const DRAMConfig& config,
+         const BaseInfo& base_info);
+
+    sc_time accessAndGetDelay(MemoryAccessPayload& payload) override;
+
+    [[nodiscard]] bool schedulesAccessList() const override;
+    // bursts of all accesses are scheduled together by FR-FCFS
+    std::vector<sc_time> accessListAndGetDelay(const std::vector<MemoryAccessPayload*>& payload_list) override;
+    // when the first bank is ready for a command again
+    [[nodiscard]] sc_time getNextIssueTime() const override;
+
+    void resetTiming(const sc_time& start_time) override;
+
+    int getMemoryDataWidthByte(MemoryAccessType access_type) const override;
+    int getMemorySizeByte() const override;
+
+    std::vector<uint8_t> getData() const override;
+    void setData(const std::vector<uint8_t>& data) override;
+
+private:
+    struct BankState {
+        int open_row{-1};
+        int64_t ready_cycle{0};     // earliest cycle to issue next command
+        int64_t activate_cycle{0};  // cycle of last ACT, for tRAS
+    };
+
+    struct Burst {
+        int channel;
+        int rank;
+        int bank;
+        int row;
+        int payload_index{0};
+    };
+
+    void initialData();
+
+    Burst decodeAddress(int address_byte) const;
+    BankState& getBankState(const Burst& burst);
+
+    [[nodiscard]] bool checkAccess(const MemoryAccessPayload& payload) const;
+    void accessData(MemoryAccessPayload& payload);
+
+    // false if no refresh is due until cycle
+    bool refreshUntil(int64_t cycle);
+    int selectNextBurst(const std::vector<Burst>& pending_bursts);
+
+private:
+    const DRAMConfig& config_;
+    const std::string& mem_name_;
+
+    std::vector<uint8_t> data_;
+
+    std::vector<BankState> bank_state_list_;
+    std::vector<int64_t> channel_bus_free_cycle_list_;
+    int64_t next_refresh_cycle_;
+
+    EnergyCounter activate_energy_counter_;
+    EnergyCounter read_energy_counter_;
+    EnergyCounter write_energy_counter_;
+    EnergyCounter refresh_energy_counter_;
+};
+
+}  // namespace cimsim
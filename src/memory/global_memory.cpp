@@ -4,24 +4,157 @@
 
 #include "global_memory.h"
 
+#include <algorithm>
+#include <stdexcept>
+
+#include "fmt/format.h"
+#include "util/log.h"
+
 namespace cimsim {
 
+GlobalMemoryQueue::GlobalMemoryQueue(const sc_module_name& name, const BaseInfo& base_info, MemoryUnit& memory_unit)
+    : BaseModule(name, base_info), memory_unit_(memory_unit) {
+    SC_THREAD(processAccess)
+    setThreadStackSize();
+}
+
+void GlobalMemoryQueue::pushRequest(const std::shared_ptr<NetworkPayload>& payload) {
+    request_queue_.push(payload);
+    request_arrived_.notify();
+}
+
+void GlobalMemoryQueue::setFinishRequestFunc(
+    std::function<void(const std::shared_ptr<NetworkPayload>&)> finish_request_func) {
+    finish_request_func_ = std::move(finish_request_func);
+}
+
+bool GlobalMemoryQueue::isDrained() const {
+    return request_queue_.empty();
+}
+
+void GlobalMemoryQueue::processAccess() {
+    while (true) {
+        while (request_queue_.empty()) {
+            wait(request_arrived_);
+        }
+        auto payload = request_queue_.front();
+        request_queue_.pop();
+
+        auto access_payload = payload->getRequestPayload<MemoryAccessPayload>();
+        CORE_LOG(fmt::format("{} start, src: {}, access type: {}, address: {}, size: {}", getFullName(),
+                             payload->src_id, access_payload->access_type._to_string(), access_payload->address_byte,
+                             access_payload->size_byte));
+
+        // through the port of the memory, so queues and controllers share its bandwidth instead of each one adding
+        // its own
+        memory_unit_.access(access_payload);
+
+        CORE_LOG(fmt::format("{} end, src: {}", getFullName(), payload->src_id));
+        if (finish_request_func_) {
+            finish_request_func_(payload);
+        }
+    }
+}
+
+GlobalMemoryController::GlobalMemoryController(const sc_module_name& name, const GlobalMemoryConfig& config,
+                                               const BaseInfo& base_info, MemoryUnit& memory_unit)
+    : BaseModule(name, base_info), config_(config), switch_("Switch", base_info) {
+    SC_THREAD(processAdmitRequest)
+    setThreadStackSize();
+
+    for (int i = 0; i < config_.queue_cnt; i++) {
+        auto queue =
+            std::make_shared<GlobalMemoryQueue>(fmt::format("Queue_{}", i).c_str(), base_info, memory_unit);
+        queue->setFinishRequestFunc(
+            [this](const std::shared_ptr<NetworkPayload>& payload) { this->finishRequest(payload); });
+        queue_list_.push_back(queue);
+    }
+
+    switch_.setAsyncResponse(true);
+    switch_.registerReceiveHandler(
+        [this](const std::shared_ptr<NetworkPayload>& payload) { this->receiveRequest(payload); });
+}
+
+void GlobalMemoryController::bindNetwork(Network* network) {
+    switch_.bindNetwork(network);
+}
+
+void GlobalMemoryController::resetTiming() {
+    if (!input_queue_.empty() || outstanding_request_cnt_ != 0 ||
+        !std::all_of(queue_list_.begin(), queue_list_.end(),
+                     [](const std::shared_ptr<GlobalMemoryQueue>& queue) { return queue->isDrained(); })) {
+        throw std::runtime_error{fmt::format("{}: reset timing with requests in flight", getFullName())};
+    }
+}
+
+void GlobalMemoryController::processAdmitRequest() {
+    while (true) {
+        while (input_queue_.empty()) {
+            wait(request_received_);
+        }
+        while (outstanding_request_cnt_ >= config_.max_outstanding_request_cnt) {
+            wait(request_finished_);
+        }
+
+        auto payload = input_queue_.front();
+        input_queue_.pop();
+        outstanding_request_cnt_++;
+
+        int queue_id = getQueueId(payload->getRequestPayload<MemoryAccessPayload>()->address_byte);
+        queue_list_[queue_id]->pushRequest(payload);
+    }
+}
+
+void GlobalMemoryController::receiveRequest(const std::shared_ptr<NetworkPayload>& payload) {
+    input_queue_.push(payload);
+    request_received_.notify();
+}
+
+void GlobalMemoryController::finishRequest(const std::shared_ptr<NetworkPayload>& payload) {
+    outstanding_request_cnt_--;
+    request_finished_.notify();
+    switch_.responseHandler(payload);
+}
+
+int GlobalMemoryController::getQueueId(int address_byte) const {
+    return (address_byte / config_.queue_interleave_byte) % config_.queue_cnt;
+}
+
 GlobalMemory::GlobalMemory(const sc_module_name& name, const GlobalMemoryConfig& config, const SimConfig& sim_config)
     : BaseModule(name, BaseInfo{.sim_config = sim_config})
     , memory_unit_("MemoryUnit", config.global_memory_unit_config, BaseInfo{sim_config, config.global_memory_switch_id},
-                   true)
-    , switch_("Switch", BaseInfo{sim_config, config.global_memory_switch_id}) {
-    switch_.registerReceiveHandler([this](const std::shared_ptr<NetworkPayload>& payload) {
-        memory_unit_.access(payload->getRequestPayload<MemoryAccessPayload>());
-    });
+                   true) {
+    // all controllers share the same memory unit, global address is interleaved across them by their switch id
+    for (int switch_id : config.getControllerSwitchIdList()) {
+        auto controller_name = fmt::format("Controller_{}", -switch_id);
+        controller_list_.push_back(std::make_shared<GlobalMemoryController>(
+            controller_name.c_str(), config, BaseInfo{sim_config, switch_id}, memory_unit_));
+    }
 }
 
 void GlobalMemory::bindNetwork(Network* network) {
-    switch_.bindNetwork(network);
+    for (auto& controller : controller_list_) {
+        controller->bindNetwork(network);
+    }
+}
+
+void GlobalMemory::resetTiming(const sc_time& start_time) {
+    for (auto& controller : controller_list_) {
+        controller->resetTiming();
+    }
+    memory_unit_.resetTiming(start_time);
 }
 
 EnergyCounter* GlobalMemory::getEnergyCounterPtr() {
     return memory_unit_.getEnergyCounterPtr();
 }
 
+std::vector<std::vector<uint8_t>> GlobalMemory::getMemoryDataList() const {
+    return memory_unit_.getMemoryDataList();
+}
+
+void GlobalMemory::setMemoryDataList(const std::vector<std::vector<uint8_t>>& data_list) {
+    memory_unit_.setMemoryDataList(data_list);
+}
+
 }  // namespace cimsim
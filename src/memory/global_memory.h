@@ -3,6 +3,10 @@
 //
 
 #pragma once
+#include <functional>
+#include <queue>
+#include <vector>
+
 #include "base_component/base_module.h"
 #include "config/config.h"
 #include "memory_unit.h"
@@ -11,6 +15,64 @@
 
 namespace cimsim {
 
+class GlobalMemoryQueue : public BaseModule {
+public:
+    SC_HAS_PROCESS(GlobalMemoryQueue);
+
+    GlobalMemoryQueue(const sc_module_name& name, const BaseInfo& base_info, MemoryUnit& memory_unit);
+
+    void pushRequest(const std::shared_ptr<NetworkPayload>& payload);
+    void setFinishRequestFunc(std::function<void(const std::shared_ptr<NetworkPayload>&)> finish_request_func);
+
+    [[nodiscard]] bool isDrained() const;
+
+private:
+    [[noreturn]] void processAccess();
+
+private:
+    MemoryUnit& memory_unit_;
+
+    std::queue<std::shared_ptr<NetworkPayload>> request_queue_;
+    sc_event request_arrived_;
+
+    std::function<void(const std::shared_ptr<NetworkPayload>&)> finish_request_func_;
+};
+
+class GlobalMemoryController : public BaseModule {
+public:
+    SC_HAS_PROCESS(GlobalMemoryController);
+
+    GlobalMemoryController(const sc_module_name& name, const GlobalMemoryConfig& config, const BaseInfo& base_info,
+                           MemoryUnit& memory_unit);
+
+    void bindNetwork(Network* network);
+
+    // controller keeps no timing state besides its queues, which must have drained between runs
+    void resetTiming();
+
+private:
+    [[noreturn]] void processAdmitRequest();
+
+    void receiveRequest(const std::shared_ptr<NetworkPayload>& payload);
+    void finishRequest(const std::shared_ptr<NetworkPayload>& payload);
+
+    [[nodiscard]] int getQueueId(int address_byte) const;
+
+private:
+    const GlobalMemoryConfig& config_;
+
+    Switch switch_;
+
+    // requests received from network, waiting for being admitted by controller
+    std::queue<std::shared_ptr<NetworkPayload>> input_queue_;
+    sc_event request_received_;
+
+    int outstanding_request_cnt_{0};
+    sc_event request_finished_;
+
+    std::vector<std::shared_ptr<GlobalMemoryQueue>> queue_list_;
+};
+
 class GlobalMemory : public BaseModule {
 public:
     GlobalMemory(const sc_module_name& name, const GlobalMemoryConfig& config, const SimConfig& sim_config);
@@ -19,9 +81,15 @@ public:
 
     void bindNetwork(Network* network);
 
+    [[nodiscard]] std::vector<std::vector<uint8_t>> getMemoryDataList() const;
+    void setMemoryDataList(const std::vector<std::vector<uint8_t>>& data_list);
+
+    // restart timing of controllers and memories as if simulation started at start_time
+    void resetTiming(const sc_time& start_time);
+
 private:
     MemoryUnit memory_unit_;
-    Switch switch_;
+    std::vector<std::shared_ptr<GlobalMemoryController>> controller_list_;
 };
 
 }  // namespace cimsim
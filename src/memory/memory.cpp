@@ -4,7 +4,12 @@
 
 #include "memory.h"
 
+#include <algorithm>
+#include <stdexcept>
+
 #include "address_space/address_space.h"
+#include "dram.h"
+#include "fmt/format.h"
 #include "ram.h"
 #include "reg_buffer.h"
 
@@ -15,6 +20,7 @@ Memory::Memory(const sc_module_name& name, const RAMConfig& ram_config, const Ba
     hardware_ = new RAM("ram", getName(), ram_config, base_info);
     as_offset_ = AddressSapce::getInstance().getMemoryAddressSpaceOffset(std::string{name});
     SC_THREAD(process);
+    setThreadStackSize();
 }
 
 Memory::Memory(const sc_module_name& name, const RegBufferConfig& reg_buffer_config, const BaseInfo& base_info)
@@ -22,6 +28,15 @@ Memory::Memory(const sc_module_name& name, const RegBufferConfig& reg_buffer_con
     hardware_ = new RegBuffer("reg_buffer", getName(), reg_buffer_config, base_info);
     as_offset_ = AddressSapce::getInstance().getMemoryAddressSpaceOffset(std::string{name});
     SC_THREAD(process);
+    setThreadStackSize();
+}
+
+Memory::Memory(const sc_module_name& name, const DRAMConfig& dram_config, const BaseInfo& base_info)
+    : BaseModule(name, base_info), is_mount(false) {
+    hardware_ = new DRAM("dram", getName(), dram_config, base_info);
+    as_offset_ = AddressSapce::getInstance().getMemoryAddressSpaceOffset(std::string{name});
+    SC_THREAD(process);
+    setThreadStackSize();
 }
 
 Memory::Memory(const sc_module_name& name, MemoryHardware* memory_hardware, const BaseInfo& base_info)
@@ -29,6 +44,7 @@ Memory::Memory(const sc_module_name& name, MemoryHardware* memory_hardware, cons
     hardware_ = memory_hardware;
     as_offset_ = AddressSapce::getInstance().getMemoryAddressSpaceOffset(hardware_->getMemoryName());
     SC_THREAD(process);
+    setThreadStackSize();
 }
 
 Memory::~Memory() {
@@ -58,6 +74,22 @@ bool Memory::isMount() const {
     return is_mount;
 }
 
+std::vector<uint8_t> Memory::getData() const {
+    return hardware_->getData();
+}
+
+void Memory::setData(const std::vector<uint8_t>& data) {
+    hardware_->setData(data);
+}
+
+void Memory::resetTiming(const sc_time& start_time) {
+    if (!access_queue_.empty()) {
+        throw std::runtime_error{fmt::format("{}: reset timing with {} pending accesses", getFullName(),
+                                             access_queue_.size())};
+    }
+    hardware_->resetTiming(start_time);
+}
+
 EnergyCounter* Memory::getEnergyCounterPtr() {
     return hardware_->getEnergyCounterPtr();
 }
@@ -71,6 +103,10 @@ void Memory::process() {
         while (access_queue_.empty()) {
             wait(start_process_);
         }
+        if (hardware_->schedulesAccessList()) {
+            processAccessList();
+            continue;
+        }
         auto payload_ptr = access_queue_.front();
         access_queue_.pop();
 
@@ -78,7 +114,31 @@ void Memory::process() {
         if (payload_ptr->ins.unit_type != +ExecuteUnitType::scalar) {
             wait(access_delay);
         }
-        payload_ptr->finish_access.notify();
+        payload_ptr->finish_access->notify();
+    }
+}
+
+void Memory::processAccessList() {
+    std::vector<std::shared_ptr<MemoryAccessPayload>> payload_list;
+    std::vector<MemoryAccessPayload*> payload_ptr_list;
+    while (!access_queue_.empty()) {
+        payload_ptr_list.push_back(access_queue_.front().get());
+        payload_list.emplace_back(std::move(access_queue_.front()));
+        access_queue_.pop();
+    }
+
+    auto delay_list = hardware_->accessListAndGetDelay(payload_ptr_list);
+    for (int i = 0; i < payload_list.size(); i++) {
+        if (payload_list[i]->ins.unit_type == +ExecuteUnitType::scalar) {
+            payload_list[i]->finish_access->notify();
+        } else {
+            payload_list[i]->finish_access->notify(delay_list[i]);
+        }
+    }
+    // go on once the hardware could issue again instead of waiting for the slowest access of this round, accesses
+    // arriving meanwhile are scheduled together in the next round, on the bank state this round leaves
+    if (auto next_issue_time = hardware_->getNextIssueTime(); next_issue_time > sc_time_stamp()) {
+        wait(next_issue_time - sc_time_stamp());
     }
 }
 
@@ -18,6 +18,7 @@ public:
 
     Memory(const sc_module_name& name, const RAMConfig& ram_config, const BaseInfo& base_info);
     Memory(const sc_module_name& name, const RegBufferConfig& reg_buffer_config, const BaseInfo& base_info);
+    Memory(const sc_module_name& name, const DRAMConfig& dram_config, const BaseInfo& base_info);
     Memory(const sc_module_name& name, MemoryHardware* memory_hardware, const BaseInfo& base_info);
 
     ~Memory() override;
@@ -29,12 +30,19 @@ public:
     [[nodiscard]] int getMemorySizeByte() const;
     [[nodiscard]] bool isMount() const;
 
+    [[nodiscard]] std::vector<uint8_t> getData() const;
+    void setData(const std::vector<uint8_t>& data);
+
+    // only between runs, when no access is pending
+    void resetTiming(const sc_time& start_time);
+
     EnergyCounter* getEnergyCounterPtr() override;
 
     void setMemoryID(int mem_id);
 
 private:
     [[noreturn]] void process();
+    void processAccessList();
 
 private:
     bool is_mount;  // whether this memory is a mount memory
@@ -15,9 +15,35 @@ public:
 
     virtual sc_time accessAndGetDelay(MemoryAccessPayload& payload) = 0;
 
+    // hardware with its own scheduler takes all pending accesses at once and returns the delay of every one from now
+    [[nodiscard]] virtual bool schedulesAccessList() const {
+        return false;
+    }
+    virtual std::vector<sc_time> accessListAndGetDelay(const std::vector<MemoryAccessPayload*>& payload_list) {
+        std::vector<sc_time> delay_list;
+        sc_time delay = SC_ZERO_TIME;
+        for (auto* payload : payload_list) {
+            delay += accessAndGetDelay(*payload);
+            delay_list.push_back(delay);
+        }
+        return delay_list;
+    }
+    // only for hardware scheduling access lists, earliest time a newly arriving access could issue, accesses arriving
+    // before it are scheduled together
+    [[nodiscard]] virtual sc_time getNextIssueTime() const {
+        return sc_time_stamp();
+    }
+
+    // restart timing state such as open rows and refresh schedule as if simulation started at start_time, data is kept
+    virtual void resetTiming(const sc_time& start_time) {}
+
     [[nodiscard]] virtual int getMemoryDataWidthByte(MemoryAccessType access_type) const = 0;
     [[nodiscard]] virtual int getMemorySizeByte() const = 0;
 
+    // whole data of memory as architectural state, only in real data mode
+    [[nodiscard]] virtual std::vector<uint8_t> getData() const = 0;
+    virtual void setData(const std::vector<uint8_t>& data) = 0;
+
     [[nodiscard]] virtual const std::string& getMemoryName() {
         return getName();
     }
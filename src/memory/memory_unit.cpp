@@ -21,9 +21,14 @@ MemoryUnit::MemoryUnit(const sc_module_name &name, const MemoryUnitConfig &confi
         for (int duplicate_id = 0; duplicate_id < mem_cfg.duplicate_cnt; duplicate_id++) {
             std::string mem_name = getDuplicateMemoryName(mem_cfg.getMemoryName(), duplicate_id);
             int mem_id = as_.getMemoryId(mem_name);
-            auto mem_ptr = mem_cfg.type == +MemoryType::ram
-                               ? std::make_shared<Memory>(mem_name.c_str(), mem_cfg.ram_config, base_info)
-                               : std::make_shared<Memory>(mem_name.c_str(), mem_cfg.reg_buffer_config, base_info);
+            std::shared_ptr<Memory> mem_ptr;
+            if (mem_cfg.type == +MemoryType::ram) {
+                mem_ptr = std::make_shared<Memory>(mem_name.c_str(), mem_cfg.ram_config, base_info);
+            } else if (mem_cfg.type == +MemoryType::dram) {
+                mem_ptr = std::make_shared<Memory>(mem_name.c_str(), mem_cfg.dram_config, base_info);
+            } else {
+                mem_ptr = std::make_shared<Memory>(mem_name.c_str(), mem_cfg.reg_buffer_config, base_info);
+            }
             mem_ptr->setMemoryID(mem_id);
             memory_list_[mem_id] = mem_ptr;
             energy_counter_.addSubEnergyCounter(mem_ptr->getName(), mem_ptr->getEnergyCounterPtr());
@@ -50,8 +55,11 @@ void MemoryUnit::access(const std::shared_ptr<MemoryAccessPayload> &payload) {
         return;
     }
     payload->address_byte -= memory->getAddressSpaceOffset();
+    sc_event finish_access;
+    payload->finish_access = &finish_access;
     memory->access(payload);
-    wait(payload->finish_access);
+    wait(finish_access);
+    payload->finish_access = nullptr;
 }
 
 int MemoryUnit::getMemoryDataWidthById(int memory_id, MemoryAccessType access_type) const {
@@ -62,6 +70,32 @@ int MemoryUnit::getMemorySizeById(int memory_id) const {
     return memory_list_[memory_id]->getMemorySizeByte();
 }
 
+std::vector<std::vector<uint8_t>> MemoryUnit::getMemoryDataList() const {
+    std::vector<std::vector<uint8_t>> data_list(memory_list_.size());
+    for (int mem_id = 0; mem_id < memory_list_.size(); mem_id++) {
+        if (memory_list_[mem_id] != nullptr) {
+            data_list[mem_id] = memory_list_[mem_id]->getData();
+        }
+    }
+    return data_list;
+}
+
+void MemoryUnit::setMemoryDataList(const std::vector<std::vector<uint8_t>> &data_list) {
+    for (int mem_id = 0; mem_id < memory_list_.size() && mem_id < data_list.size(); mem_id++) {
+        if (memory_list_[mem_id] != nullptr && !data_list[mem_id].empty()) {
+            memory_list_[mem_id]->setData(data_list[mem_id]);
+        }
+    }
+}
+
+void MemoryUnit::resetTiming(const sc_time &start_time) {
+    for (auto &memory : memory_list_) {
+        if (memory != nullptr) {
+            memory->resetTiming(start_time);
+        }
+    }
+}
+
 std::shared_ptr<Memory> MemoryUnit::getMemoryByAddress(int address_byte) {
     int mem_id = is_global_ ? as_.getGlobalMemoryId(address_byte) : as_.getLocalMemoryId(address_byte);
     return memory_list_[mem_id];
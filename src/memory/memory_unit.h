@@ -24,6 +24,12 @@ public:
     int getMemoryDataWidthById(int memory_id, MemoryAccessType access_type) const;
     int getMemorySizeById(int memory_id) const;
 
+    // data of every memory by memory id, as architectural state
+    std::vector<std::vector<uint8_t>> getMemoryDataList() const;
+    void setMemoryDataList(const std::vector<std::vector<uint8_t>>& data_list);
+
+    void resetTiming(const sc_time& start_time);
+
 private:
     std::shared_ptr<Memory> getMemoryByAddress(int address_byte);
 
@@ -17,7 +17,8 @@ struct MemoryAccessPayload {
     int address_byte;  // byte
     int size_byte;     // byte
     std::vector<uint8_t> data;
-    sc_event& finish_access;
+    // set by MemoryUnit for the access in flight, so concurrent accesses never share a completion event
+    sc_event* finish_access{nullptr};
 };
 
 }  // namespace cimsim
@@ -18,6 +18,8 @@ RAM::RAM(const sc_module_name &name, const std::string &mem_name, const RAMConfi
     energy_counter_.setStaticPowerMW(config_.static_power_mW);
     energy_counter_.addSubEnergyCounter("read", &read_energy_counter_);
     energy_counter_.addSubEnergyCounter("write", &write_energy_counter_);
+    read_energy_counter_.addDynamicPowerParam(config_.read_dynamic_power_mW);
+    write_energy_counter_.addDynamicPowerParam(config_.write_dynamic_power_mW);
 }
 
 sc_time RAM::accessAndGetDelay(cimsim::MemoryAccessPayload &payload) {
@@ -33,7 +35,7 @@ sc_time RAM::accessAndGetDelay(cimsim::MemoryAccessPayload &payload) {
     double latency;
     if (payload.access_type == +MemoryAccessType::read) {
         latency = process_times * config_.read_latency_cycle * period_ns_;
-        read_energy_counter_.addDynamicEnergyPJ(latency, config_.read_dynamic_power_mW,
+        read_energy_counter_.addDynamicEnergyPJ(latency, config_.read_dynamic_power_mW, 1,
                                                 {.core_id = core_id_,
                                                  .ins_id = payload.ins.ins_id,
                                                  .inst_opcode = payload.ins.inst_opcode,
@@ -46,7 +48,7 @@ sc_time RAM::accessAndGetDelay(cimsim::MemoryAccessPayload &payload) {
         }
     } else {
         latency = process_times * config_.write_latency_cycle * period_ns_;
-        write_energy_counter_.addDynamicEnergyPJ(latency, config_.write_dynamic_power_mW,
+        write_energy_counter_.addDynamicEnergyPJ(latency, config_.write_dynamic_power_mW, 1,
                                                  {.core_id = core_id_,
                                                   .ins_id = payload.ins.ins_id,
                                                   .inst_opcode = payload.ins.inst_opcode,
@@ -79,4 +81,14 @@ int RAM::getMemorySizeByte() const {
     return config_.size_byte;
 }
 
+std::vector<uint8_t> RAM::getData() const {
+    return data_;
+}
+
+void RAM::setData(const std::vector<uint8_t> &data) {
+    if (data_mode_ == +DataMode::real_data) {
+        std::copy_n(data.begin(), std::min(data.size(), data_.size()), data_.begin());
+    }
+}
+
 }  // namespace cimsim
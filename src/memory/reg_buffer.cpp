@@ -19,6 +19,8 @@ RegBuffer::RegBuffer(const sc_module_name &name, const std::string &mem_name, co
     energy_counter_.setStaticPowerMW(config_.static_power_mW);
     energy_counter_.addSubEnergyCounter("read", &read_energy_counter_);
     energy_counter_.addSubEnergyCounter("write", &write_energy_counter_);
+    read_energy_counter_.addDynamicPowerParam(config_.rw_dynamic_power_per_unit_mW);
+    write_energy_counter_.addDynamicPowerParam(config_.rw_dynamic_power_per_unit_mW);
 }
 
 sc_time RegBuffer::accessAndGetDelay(cimsim::MemoryAccessPayload &payload) {
@@ -34,8 +36,7 @@ sc_time RegBuffer::accessAndGetDelay(cimsim::MemoryAccessPayload &payload) {
         int read_data_size_byte =
             (payload.size_byte <= config_.read_max_width_byte) ? payload.size_byte : config_.read_max_width_byte;
         int read_data_unit_cnt = IntDivCeil(read_data_size_byte, config_.rw_min_unit_byte);
-        double read_dynamic_power_mW = config_.rw_dynamic_power_per_unit_mW * read_data_unit_cnt;
-        read_energy_counter_.addDynamicEnergyPJ(period_ns_, read_dynamic_power_mW,
+        read_energy_counter_.addDynamicEnergyPJ(period_ns_, config_.rw_dynamic_power_per_unit_mW, read_data_unit_cnt,
                                                 {.core_id = core_id_,
                                                  .ins_id = payload.ins.ins_id,
                                                  .inst_opcode = payload.ins.inst_opcode,
@@ -52,8 +53,8 @@ sc_time RegBuffer::accessAndGetDelay(cimsim::MemoryAccessPayload &payload) {
         int write_data_size_byte =
             (payload.size_byte <= config_.write_max_width_byte) ? payload.size_byte : config_.write_max_width_byte;
         int write_data_unit_cnt = IntDivCeil(write_data_size_byte, config_.rw_min_unit_byte);
-        double write_dynamic_power_mW = config_.rw_dynamic_power_per_unit_mW * write_data_unit_cnt;
-        write_energy_counter_.addDynamicEnergyPJ(period_ns_, write_dynamic_power_mW,
+        write_energy_counter_.addDynamicEnergyPJ(period_ns_, config_.rw_dynamic_power_per_unit_mW,
+                                                 write_data_unit_cnt,
                                                  {.core_id = core_id_,
                                                   .ins_id = payload.ins.ins_id,
                                                   .inst_opcode = payload.ins.inst_opcode,
@@ -86,4 +87,14 @@ int RegBuffer::getMemorySizeByte() const {
     return config_.size_byte;
 }
 
+std::vector<uint8_t> RegBuffer::getData() const {
+    return data_;
+}
+
+void RegBuffer::setData(const std::vector<uint8_t> &data) {
+    if (data_mode_ == +DataMode::real_data) {
+        std::copy_n(data.begin(), std::min(data.size(), data_.size()), data_.begin());
+    }
+}
+
 }  // namespace cimsim
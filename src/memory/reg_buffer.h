@@ -23,6 +23,9 @@ public:
     int getMemoryDataWidthByte(MemoryAccessType access_type) const override;
     int getMemorySizeByte() const override;
 
+    std::vector<uint8_t> getData() const override;
+    void setData(const std::vector<uint8_t>& data) override;
+
 private:
     void initialData();
 
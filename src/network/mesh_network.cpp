@@ -0,0 +1,249 @@
+#include "mesh_network.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+#include "fmt/format.h"
+
+namespace cimsim {
+
+MeshNetwork::MeshNetwork(const MeshNetworkConfig& config, double period_ns)
+    : config_(config)
+    , period_ns_(period_ns)
+    , node_cnt_(config.x_cnt * config.y_cnt)
+    , link_list_(config.x_cnt * config.y_cnt * port_cnt) {
+    for (const auto& placement : config_.switch_placement) {
+        switch_node_map_[placement.switch_id] = placement.y * config_.x_cnt + placement.x;
+    }
+}
+
+MeshNetwork::TransferResult MeshNetwork::transfer(int src_id, int dst_id, int flit_cnt, double now_ns) {
+    if (flit_cnt <= 0) {
+        return {};
+    }
+
+    auto route = getRoute(getNodeId(src_id), getNodeId(dst_id));
+    const int route_len = static_cast<int>(route.size());
+    const double serialize_ns = flit_cnt * period_ns_;
+
+    // time when head flit starts to cross each link, and the latency before head reaches next link
+    std::vector<double> head_time_ns(route_len);
+    std::vector<double> hop_latency_ns(route_len);
+    double arrive_ns = now_ns;
+    for (int i = 0; i < route_len; i++) {
+        hop_latency_ns[i] = getHopLatencyNs(route[i]);
+        head_time_ns[i] = std::max(arrive_ns, getLink(route[i]).busy_until_ns);
+        arrive_ns = head_time_ns[i] + hop_latency_ns[i];
+    }
+
+    // virtual cut-through buffers the whole packet in a blocked router, so a link is only held while the packet
+    // crosses it. Wormhole keeps a blocked packet spread over upstream links, so a link is held until the tail
+    // leaves it.
+    std::vector<double> release_time_ns(route_len);
+    for (int i = route_len - 1; i >= 0; i--) {
+        release_time_ns[i] = head_time_ns[i] + serialize_ns;
+        if (config_.flow_control == +NetworkFlowControl::wormhole && i < route_len - 1) {
+            release_time_ns[i] = std::max(release_time_ns[i], release_time_ns[i + 1] - hop_latency_ns[i]);
+        }
+    }
+
+    int hop_cnt = 0;
+    for (int i = 0; i < route_len; i++) {
+        auto& link = getLink(route[i]);
+        link.busy_until_ns = release_time_ns[i];
+        link.busy_time_ns += serialize_ns;
+        link.flit_cnt += flit_cnt;
+        if (auto port = route[i] % port_cnt; port != inject && port != eject) {
+            hop_cnt++;
+        }
+    }
+
+    return {.latency_ns = head_time_ns[route_len - 1] + serialize_ns - now_ns, .hop_cnt = hop_cnt};
+}
+
+MeshNetwork::MulticastResult MeshNetwork::multicast(int src_id, const std::vector<int>& dst_id_list, int flit_cnt,
+                                                    double now_ns) {
+    MulticastResult result{.latency_ns_list = std::vector<double>(dst_id_list.size(), 0.0)};
+    if (flit_cnt <= 0) {
+        return result;
+    }
+
+    // routes from the same src share their prefix, and a link shared by several routes carries the packet only once.
+    // Blocked branches do not hold upstream links, as in virtual cut-through.
+    const double serialize_ns = flit_cnt * period_ns_;
+    const int src_node_id = getNodeId(src_id);
+    std::unordered_map<int, double> tree_head_time_ns;  // <link_id, head time>
+    for (int i = 0; i < dst_id_list.size(); i++) {
+        double arrive_ns = now_ns, head_time_ns = now_ns;
+        for (int link_id : getRoute(src_node_id, getNodeId(dst_id_list[i]))) {
+            auto [found, inserted] = tree_head_time_ns.try_emplace(link_id, 0.0);
+            if (inserted) {
+                found->second = std::max(arrive_ns, link_list_[link_id].busy_until_ns);
+            }
+            head_time_ns = found->second;
+            arrive_ns = head_time_ns + getHopLatencyNs(link_id);
+        }
+        result.latency_ns_list[i] = head_time_ns + serialize_ns - now_ns;
+    }
+
+    for (const auto& [link_id, head_time_ns] : tree_head_time_ns) {
+        auto& link = getLink(link_id);
+        link.busy_until_ns = head_time_ns + serialize_ns;
+        link.busy_time_ns += serialize_ns;
+        link.flit_cnt += flit_cnt;
+
+        if (auto port = link_id % port_cnt; port != eject) {
+            result.router_cnt++;
+            if (port != inject) {
+                result.hop_cnt++;
+            }
+        }
+    }
+    return result;
+}
+
+int MeshNetwork::getHopCount(int src_id, int dst_id) const {
+    auto [dx, dy] = getDistance(getNodeId(src_id), getNodeId(dst_id));
+    return std::abs(dx) + std::abs(dy);
+}
+
+void MeshNetwork::resetTiming() {
+    for (auto& link : link_list_) {
+        link.busy_until_ns = 0.0;
+    }
+}
+
+void MeshNetwork::report(std::ostream& os, double running_time_ns) const {
+    if (running_time_ns <= 0.0) {
+        return;
+    }
+
+    std::vector<std::pair<double, int>> utilization_list;
+    double total_utilization = 0.0;
+    int used_link_cnt = 0;
+    for (int link_id = 0; link_id < link_list_.size(); link_id++) {
+        const auto& link = link_list_[link_id];
+        if (link.flit_cnt == 0) {
+            continue;
+        }
+        double utilization = link.busy_time_ns / running_time_ns;
+        utilization_list.emplace_back(utilization, link_id);
+        total_utilization += utilization;
+        used_link_cnt++;
+    }
+    std::sort(utilization_list.begin(), utilization_list.end(), std::greater<>());
+
+    os << "\nNetwork Link Utilization:\n";
+    os << fmt::format("  - {:<20}{}\n", "used links:", used_link_cnt);
+    os << fmt::format("  - {:<20}{:.4f}\n", "average:", used_link_cnt > 0 ? total_utilization / used_link_cnt : 0.0);
+    os << fmt::format("  - {:<20}{:.4f}\n", "max:", utilization_list.empty() ? 0.0 : utilization_list[0].first);
+
+    constexpr int report_link_cnt = 10;
+    for (int i = 0; i < std::min(report_link_cnt, static_cast<int>(utilization_list.size())); i++) {
+        auto [utilization, link_id] = utilization_list[i];
+        os << fmt::format("    {:<24}{:.4f}  {} flits\n", getLinkName(link_id, config_.x_cnt), utilization,
+                          link_list_[link_id].flit_cnt);
+    }
+}
+
+int MeshNetwork::getNodeId(int switch_id) const {
+    if (auto found = switch_node_map_.find(switch_id); found != switch_node_map_.end()) {
+        return found->second;
+    }
+    // core switch ids are node ids unless placed elsewhere
+    if (switch_id >= 0 && switch_id < node_cnt_) {
+        return switch_id;
+    }
+    throw std::runtime_error{fmt::format("Switch {} has no placement in mesh network", switch_id)};
+}
+
+int MeshNetwork::getNeighborNodeId(int node_id, Port port) const {
+    int x = node_id % config_.x_cnt, y = node_id / config_.x_cnt;
+    switch (port) {
+        case east: x = (x + 1) % config_.x_cnt; break;
+        case west: x = (x - 1 + config_.x_cnt) % config_.x_cnt; break;
+        case north: y = (y + 1) % config_.y_cnt; break;
+        case south: y = (y - 1 + config_.y_cnt) % config_.y_cnt; break;
+        default: break;
+    }
+    return y * config_.x_cnt + x;
+}
+
+std::pair<int, int> MeshNetwork::getDistance(int src_node_id, int dst_node_id) const {
+    int dx = dst_node_id % config_.x_cnt - src_node_id % config_.x_cnt;
+    int dy = dst_node_id / config_.x_cnt - src_node_id / config_.x_cnt;
+    if (config_.torus) {
+        // take the shorter way around the ring
+        if (2 * std::abs(dx) > config_.x_cnt) {
+            dx -= (dx > 0 ? 1 : -1) * config_.x_cnt;
+        }
+        if (2 * std::abs(dy) > config_.y_cnt) {
+            dy -= (dy > 0 ? 1 : -1) * config_.y_cnt;
+        }
+    }
+    return {dx, dy};
+}
+
+std::vector<int> MeshNetwork::getRoute(int src_node_id, int dst_node_id) const {
+    std::vector<int> route{src_node_id * port_cnt + inject};
+
+    auto [dx, dy] = getDistance(src_node_id, dst_node_id);
+    int node_id = src_node_id;
+    auto step = [&](Port port) {
+        route.push_back(node_id * port_cnt + port);
+        node_id = getNeighborNodeId(node_id, port);
+    };
+
+    if (config_.routing == +NetworkRouting::xy) {
+        for (; dx != 0; dx += (dx > 0 ? -1 : 1)) {
+            step(dx > 0 ? east : west);
+        }
+        for (; dy != 0; dy += (dy > 0 ? -1 : 1)) {
+            step(dy > 0 ? north : south);
+        }
+    } else {
+        // west-first: all west hops first, then adaptively choose the earliest free productive link
+        for (; dx < 0; dx++) {
+            step(west);
+        }
+        while (dx != 0 || dy != 0) {
+            Port y_port = dy > 0 ? north : south;
+            bool go_x = dx != 0 && (dy == 0 || link_list_[node_id * port_cnt + east].busy_until_ns <=
+                                                   link_list_[node_id * port_cnt + y_port].busy_until_ns);
+            if (go_x) {
+                step(east);
+                dx--;
+            } else {
+                step(y_port);
+                dy += (dy > 0 ? -1 : 1);
+            }
+        }
+    }
+
+    route.push_back(dst_node_id * port_cnt + eject);
+    return route;
+}
+
+double MeshNetwork::getHopLatencyNs(int link_id) const {
+    auto port = link_id % port_cnt;
+    if (port == inject) {
+        return config_.router_latency_cycle * period_ns_;
+    }
+    if (port == eject) {
+        return 0.0;
+    }
+    return (config_.link_latency_cycle + config_.router_latency_cycle) * period_ns_;
+}
+
+MeshNetwork::Link& MeshNetwork::getLink(int link_id) {
+    return link_list_[link_id];
+}
+
+std::string MeshNetwork::getLinkName(int link_id, int x_cnt) {
+    static const char* port_name[port_cnt] = {"east", "west", "north", "south", "inject", "eject"};
+    int node_id = link_id / port_cnt;
+    return fmt::format("({}, {}) {}", node_id % x_cnt, node_id / x_cnt, port_name[link_id % port_cnt]);
+}
+
+}  // namespace cimsim
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+#include "config/config.h"
+
+namespace cimsim {
+
+class MeshNetwork {
+public:
+    struct TransferResult {
+        double latency_ns{0.0};
+        int hop_cnt{0};
+    };
+
+    struct MulticastResult {
+        std::vector<double> latency_ns_list;  // same order as dst_id_list
+        int hop_cnt{0};                       // links of the multicast tree
+        int router_cnt{0};                    // routers of the multicast tree
+    };
+
+public:
+    MeshNetwork(const MeshNetworkConfig& config, double period_ns);
+
+    // route a packet of flit_cnt flits from src to dst at now_ns, and reserve links on its route
+    TransferResult transfer(int src_id, int dst_id, int flit_cnt, double now_ns);
+
+    // packet is replicated at routers where routes to different dst split, so every link of the tree is used once
+    MulticastResult multicast(int src_id, const std::vector<int>& dst_id_list, int flit_cnt, double now_ns);
+
+    [[nodiscard]] int getHopCount(int src_id, int dst_id) const;
+
+    // release link reservations, statistics are kept
+    void resetTiming();
+
+    void report(std::ostream& os, double running_time_ns) const;
+
+private:
+    enum Port { east = 0, west, north, south, inject, eject, port_cnt };
+
+    struct Link {
+        double busy_until_ns{0.0};
+        double busy_time_ns{0.0};
+        int64_t flit_cnt{0};
+    };
+
+    // throw if the switch is neither placed nor a node id
+    [[nodiscard]] int getNodeId(int switch_id) const;
+    [[nodiscard]] int getNeighborNodeId(int node_id, Port port) const;
+    [[nodiscard]] std::pair<int, int> getDistance(int src_node_id, int dst_node_id) const;
+
+    std::vector<int> getRoute(int src_node_id, int dst_node_id) const;
+    [[nodiscard]] double getHopLatencyNs(int link_id) const;
+
+    Link& getLink(int link_id);
+    [[nodiscard]] static std::string getLinkName(int link_id, int x_cnt);
+
+private:
+    const MeshNetworkConfig& config_;
+    const double period_ns_;
+    const int node_cnt_;
+
+    std::unordered_map<int, int> switch_node_map_;
+    std::vector<Link> link_list_;  // index: node_id * port_cnt + port
+};
+
+}  // namespace cimsim
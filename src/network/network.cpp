@@ -4,6 +4,9 @@
 
 #include "network.h"
 
+#include <algorithm>
+#include <stdexcept>
+
 #include "fmt/format.h"
 #include "util/util.h"
 
@@ -11,12 +14,29 @@ namespace cimsim {
 
 Network::Network(std::string name, const NetworkConfig& config, const SimConfig& sim_config)
     : config_(config), sim_config_(sim_config), name_(std::move(name)) {
-    readLatencyEnergyFile(config.network_config_file_path);
+    if (config_.model == +NetworkModel::mesh) {
+        mesh_network_ = std::make_unique<MeshNetwork>(config_.mesh_config, sim_config_.period_ns);
+        energy_counter_.addDynamicPowerParam(config_.mesh_config.link_energy_pJ_per_flit);
+        energy_counter_.addDynamicPowerParam(config_.mesh_config.router_energy_pJ_per_flit);
+    } else if (config_.network_config_file_path.empty()) {
+        setLatencyEnergy(config_.mesh_config);
+    } else {
+        readLatencyEnergyFile(config_.network_config_file_path);
+    }
 }
 
 sc_time Network::transferAndGetDelay(int src_id, int dst_id, int data_size_byte, const ProfilerTag& profiler_tag) {
-    auto per_flit_latency_ns = latency_map_[src_id][dst_id] * sim_config_.period_ns;
-    auto per_flit_energy_pj = energy_map_[src_id][dst_id];
+    if (mesh_network_ != nullptr) {
+        return transferMeshAndGetDelay(src_id, dst_id, data_size_byte, profiler_tag);
+    }
+    return transferTableAndGetDelay(src_id, dst_id, data_size_byte, profiler_tag);
+}
+
+sc_time Network::transferTableAndGetDelay(int src_id, int dst_id, int data_size_byte,
+                                          const ProfilerTag& profiler_tag) {
+    int offset = getMatrixOffset(src_id, dst_id);
+    auto per_flit_latency_ns = latency_matrix_[offset] * sim_config_.period_ns;
+    auto per_flit_energy_pj = energy_matrix_[offset];
     int times = IntDivCeil(data_size_byte, config_.bus_width_byte);
     double latency = times * per_flit_latency_ns;
 
@@ -26,6 +46,79 @@ sc_time Network::transferAndGetDelay(int src_id, int dst_id, int data_size_byte,
     return sc_time{latency, SC_NS};
 }
 
+sc_time Network::transferMeshAndGetDelay(int src_id, int dst_id, int data_size_byte,
+                                         const ProfilerTag& profiler_tag) {
+    // links are reserved at the time the transfer is issued, so contention is resolved in issue order
+    int flit_cnt = IntDivCeil(data_size_byte, config_.bus_width_byte);
+    auto result = mesh_network_->transfer(src_id, dst_id, flit_cnt, sc_time_stamp().to_seconds() * 1e9);
+
+    addMeshEnergy(flit_cnt * result.hop_cnt, flit_cnt * (result.hop_cnt + 1));
+    energy_counter_.addActivityTime(result.latency_ns, profiler_tag);
+
+    return sc_time{result.latency_ns, SC_NS};
+}
+
+std::vector<sc_time> Network::multicastAndGetDelay(int src_id, const std::vector<int>& dst_id_list,
+                                                   int data_size_byte, const ProfilerTag& profiler_tag) {
+    int flit_cnt = IntDivCeil(data_size_byte, config_.bus_width_byte);
+    std::vector<double> latency_ns_list(dst_id_list.size(), 0.0);
+
+    if (mesh_network_ != nullptr) {
+        auto result =
+            mesh_network_->multicast(src_id, dst_id_list, flit_cnt, sc_time_stamp().to_seconds() * 1e9);
+        latency_ns_list = std::move(result.latency_ns_list);
+        addMeshEnergy(flit_cnt * result.hop_cnt, flit_cnt * result.router_cnt);
+    } else {
+        // table has no topology, so the multicast tree is approximated by a spanning tree over src and dst, which is
+        // built by connecting every dst to its nearest node already in the tree, and shared prefixes are charged once
+        double energy_pj = 0.0;
+        std::vector<int> tree_node_list{src_id};
+        std::vector<bool> in_tree(dst_id_list.size(), false);
+        for (int round = 0; round < dst_id_list.size(); round++) {
+            int next = -1;
+            double next_energy_pj = 0.0;
+            for (int i = 0; i < dst_id_list.size(); i++) {
+                if (in_tree[i]) {
+                    continue;
+                }
+                for (int tree_node : tree_node_list) {
+                    double edge_energy_pj = energy_matrix_[getMatrixOffset(tree_node, dst_id_list[i])];
+                    if (next == -1 || edge_energy_pj < next_energy_pj) {
+                        next = i;
+                        next_energy_pj = edge_energy_pj;
+                    }
+                }
+            }
+            in_tree[next] = true;
+            tree_node_list.push_back(dst_id_list[next]);
+            energy_pj += flit_cnt * next_energy_pj;
+        }
+        energy_counter_.addDynamicEnergyPJ(energy_pj);
+
+        for (int i = 0; i < dst_id_list.size(); i++) {
+            int offset = getMatrixOffset(src_id, dst_id_list[i]);
+            latency_ns_list[i] = flit_cnt * latency_matrix_[offset] * sim_config_.period_ns;
+        }
+    }
+
+    double max_latency_ns = latency_ns_list.empty() ? 0.0 : *std::max_element(latency_ns_list.begin(),
+                                                                                latency_ns_list.end());
+    energy_counter_.addActivityTime(max_latency_ns, profiler_tag);
+
+    std::vector<sc_time> delay_list;
+    delay_list.reserve(latency_ns_list.size());
+    for (double latency_ns : latency_ns_list) {
+        delay_list.emplace_back(latency_ns, SC_NS);
+    }
+    return delay_list;
+}
+
+void Network::addMeshEnergy(int link_flit_cnt, int router_flit_cnt) {
+    // per flit energy is a power param over 1 ns, so activity traced on a mesh is re-costed with another config
+    energy_counter_.addDynamicEnergyPJ(1.0, config_.mesh_config.link_energy_pJ_per_flit, link_flit_cnt);
+    energy_counter_.addDynamicEnergyPJ(1.0, config_.mesh_config.router_energy_pJ_per_flit, router_flit_cnt);
+}
+
 Switch* Network::getSwitch(int id) {
     return switch_map_[id];
 }
@@ -37,25 +130,55 @@ void Network::registerSwitch(int id, Switch* switch_ptr) {
 }
 
 void Network::setLatencyEnergy(const nlohmann::json& j) {
-    // set latency
-    auto latency_array = j["latency"];
-    for (const auto& src_array : latency_array.items()) {
-        auto src_key = std::stoi(src_array.key());
-
-        for (const auto& dst : src_array.value().items()) {
-            auto dst_key = std::stoi(dst.key());
-            latency_map_[src_key][dst_key] = dst.value();
+    const auto& latency_array = j["latency"];
+    const auto& energy_array = j["energy"];
+
+    std::vector<int> switch_id_list;
+    for (const auto* array : {&latency_array, &energy_array}) {
+        for (const auto& src_array : array->items()) {
+            switch_id_list.push_back(std::stoi(src_array.key()));
+            for (const auto& dst : src_array.value().items()) {
+                switch_id_list.push_back(std::stoi(dst.key()));
+            }
         }
     }
+    resizeMatrix(switch_id_list);
+
+    auto fill_matrix = [this](const nlohmann::json& array, std::vector<double>& matrix) {
+        for (const auto& src_array : array.items()) {
+            int src_index = getMatrixIndex(std::stoi(src_array.key()));
+            for (const auto& dst : src_array.value().items()) {
+                int dst_index = getMatrixIndex(std::stoi(dst.key()));
+                matrix[src_index * matrix_dim_ + dst_index] = dst.value().get<double>();
+            }
+        }
+    };
+    fill_matrix(latency_array, latency_matrix_);
+    fill_matrix(energy_array, energy_matrix_);
+}
 
-    // set energy
-    auto energy_array = j["energy"];
-    for (const auto& src_array : energy_array.items()) {
-        auto src_key = std::stoi(src_array.key());
+void Network::setLatencyEnergy(const MeshNetworkConfig& mesh_config) {
+    // contention-free table of a mesh/torus: every hop costs one router and one link, plus the injection router
+    std::vector<int> switch_id_list;
+    for (int i = 0; i < mesh_config.x_cnt * mesh_config.y_cnt; i++) {
+        switch_id_list.push_back(i);
+    }
+    for (const auto& placement : mesh_config.switch_placement) {
+        switch_id_list.push_back(placement.switch_id);
+    }
 
-        for (const auto& dst : src_array.value().items()) {
-            auto dst_key = std::stoi(dst.key());
-            energy_map_[src_key][dst_key] = dst.value();
+    resizeMatrix(switch_id_list);
+
+    MeshNetwork mesh_network{mesh_config, sim_config_.period_ns};
+    for (int src_id : switch_id_list) {
+        for (int dst_id : switch_id_list) {
+            int hop_cnt = mesh_network.getHopCount(src_id, dst_id);
+            int offset = getMatrixIndex(src_id) * matrix_dim_ + getMatrixIndex(dst_id);
+            latency_matrix_[offset] =
+                hop_cnt * (mesh_config.router_latency_cycle + mesh_config.link_latency_cycle) +
+                mesh_config.router_latency_cycle;
+            energy_matrix_[offset] = hop_cnt * mesh_config.link_energy_pJ_per_flit +
+                                     (hop_cnt + 1) * mesh_config.router_energy_pJ_per_flit;
         }
     }
 }
@@ -70,4 +193,55 @@ EnergyCounter* Network::getEnergyCounterPtr() {
     return &energy_counter_;
 }
 
+void Network::resizeMatrix(const std::vector<int>& switch_id_list) {
+    matrix_index_list_.clear();
+    matrix_base_switch_id_ = 0;
+    matrix_dim_ = 0;
+    if (!switch_id_list.empty()) {
+        auto [min_id, max_id] = std::minmax_element(switch_id_list.begin(), switch_id_list.end());
+        matrix_base_switch_id_ = *min_id;
+        matrix_index_list_.assign(*max_id - *min_id + 1, -1);
+    }
+    for (int switch_id : switch_id_list) {
+        if (auto& index = matrix_index_list_[switch_id - matrix_base_switch_id_]; index == -1) {
+            index = matrix_dim_++;
+        }
+    }
+    latency_matrix_.assign(static_cast<size_t>(matrix_dim_) * matrix_dim_, -1.0);
+    energy_matrix_.assign(static_cast<size_t>(matrix_dim_) * matrix_dim_, -1.0);
+}
+
+int Network::getMatrixIndex(int switch_id) const {
+    int position = switch_id - matrix_base_switch_id_;
+    if (position < 0 || position >= matrix_index_list_.size()) {
+        return -1;
+    }
+    return matrix_index_list_[position];
+}
+
+int Network::getMatrixOffset(int src_id, int dst_id) const {
+    int src_index = getMatrixIndex(src_id);
+    int dst_index = getMatrixIndex(dst_id);
+    if (src_index != -1 && dst_index != -1) {
+        int offset = src_index * matrix_dim_ + dst_index;
+        if (latency_matrix_[offset] >= 0.0 && energy_matrix_[offset] >= 0.0) {
+            return offset;
+        }
+    }
+    throw std::runtime_error{fmt::format("Network '{}' has no latency and energy from switch {} to switch {}", name_,
+                                         src_id, dst_id)};
+}
+
+void Network::resetTiming() {
+    if (mesh_network_ != nullptr) {
+        mesh_network_->resetTiming();
+    }
+}
+
+void Network::report(std::ostream& os, double running_time_ns) const {
+    if (mesh_network_ != nullptr) {
+        mesh_network_->report(os, running_time_ns);
+    }
+}
+
 }  // namespace cimsim
@@ -4,11 +4,15 @@
 
 #pragma once
 
+#include <memory>
+#include <ostream>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "base_component/energy_counter.h"
 #include "config/config.h"
+#include "mesh_network.h"
 #include "nlohmann/json.hpp"
 #include "util/reporter.h"
 
@@ -21,15 +25,35 @@ public:
     Network(std::string name, const NetworkConfig& config, const SimConfig& sim_config);
 
     sc_time transferAndGetDelay(int src_id, int dst_id, int data_size_byte, const ProfilerTag& profiler_tag);
+    // return delay of every dst, in the same order as dst_id_list
+    std::vector<sc_time> multicastAndGetDelay(int src_id, const std::vector<int>& dst_id_list, int data_size_byte,
+                                              const ProfilerTag& profiler_tag);
 
     Switch* getSwitch(int id);
     void registerSwitch(int id, Switch* switch_ptr);
 
     void readLatencyEnergyFile(const std::string& file_path);
     void setLatencyEnergy(const nlohmann::json& j);
+    void setLatencyEnergy(const MeshNetworkConfig& mesh_config);
 
     EnergyCounter* getEnergyCounterPtr();
 
+    void resetTiming();
+
+    void report(std::ostream& os, double running_time_ns) const;
+
+private:
+    sc_time transferTableAndGetDelay(int src_id, int dst_id, int data_size_byte, const ProfilerTag& profiler_tag);
+    sc_time transferMeshAndGetDelay(int src_id, int dst_id, int data_size_byte, const ProfilerTag& profiler_tag);
+    void addMeshEnergy(int link_flit_cnt, int router_flit_cnt);
+
+    // switch ids of the table are densely indexed in order of first appearance
+    void resizeMatrix(const std::vector<int>& switch_id_list);
+    // -1 if the switch is not in the table
+    [[nodiscard]] int getMatrixIndex(int switch_id) const;
+    // throw if the table has no entry of the pair
+    [[nodiscard]] int getMatrixOffset(int src_id, int dst_id) const;
+
 private:
     const NetworkConfig& config_;
     const SimConfig& sim_config_;
@@ -37,8 +61,15 @@ private:
 
     std::unordered_map<int, Switch*> switch_map_;
 
-    std::unordered_map<int, std::unordered_map<int, double>> latency_map_;  // cycle
-    std::unordered_map<int, std::unordered_map<int, double>> energy_map_;   // pJ
+    // dense per-flit matrices of table model, row is src and column is dst, negative entry means no entry
+    // matrix index of every switch id from matrix_base_switch_id_ on, global memory switch ids are negative
+    std::vector<int> matrix_index_list_;
+    int matrix_base_switch_id_{0};
+    int matrix_dim_{0};
+    std::vector<double> latency_matrix_;  // cycle
+    std::vector<double> energy_matrix_;   // pJ
+
+    std::unique_ptr<MeshNetwork> mesh_network_;
 
     EnergyCounter energy_counter_;
 };
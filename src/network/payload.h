@@ -3,7 +3,9 @@
 //
 
 #pragma once
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "better-enums/enum.h"
 #include "systemc.h"
@@ -14,15 +16,17 @@ BETTER_ENUM(DataTransferStatus, int,  // NOLINT(*-explicit-constructor)
             sender_ready, receiver_ready, send_data)
 
 BETTER_ENUM(NetworkTransferMode, int,  // NOLINT(*-explicit-constructor)
-            transport, only_send)
+            transport, only_send, response, multicast)
 
 struct NetworkPayload {
     InstructionPayload ins{};
 
     int src_id;
     int dst_id;
+    std::vector<int> multicast_dst_id_list{};  // only for multicast mode
 
     sc_event* finish_network_trans{nullptr};
+    bool network_trans_finished{false};
 
     // one payload contains request and its response(optional)
     int request_data_size_byte;
@@ -50,7 +54,10 @@ struct DataTransferInfo {
     DataTransferStatus status;
 
     int id_tag;
+    int seq;  // order of the transfer among the ones with the same <sender, receiver, id tag>
     int data_size_byte;
+    std::shared_ptr<std::vector<uint8_t>> data{nullptr};  // only for send_data in real data mode
+    std::vector<int> multicast_seq_list{};               // seq of each dst, only for multicast send_data
 };
 
 }  // namespace cimsim
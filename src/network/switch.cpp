@@ -4,6 +4,9 @@
 
 #include "switch.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "fmt/format.h"
 #include "util/log.h"
 
@@ -11,6 +14,7 @@ namespace cimsim {
 
 Switch::Switch(const sc_module_name& name, const BaseInfo& base_info) : BaseModule(name, base_info) {
     SC_THREAD(processTransport);
+    setThreadStackSize();
 }
 
 void Switch::processTransport() {
@@ -27,24 +31,50 @@ void Switch::processTransport() {
                              payload->src_id, payload->dst_id, payload->request_data_size_byte,
                              payload->response_data_size_byte));
 
-        ProfilerTag profiler_tag = {.core_id = core_id_,
+        ProfilerTag profiler_tag = {.core_id = (mode == +NetworkTransferMode::response ? payload->src_id : core_id_),
                                     .ins_id = payload->ins.ins_id,
                                     .inst_opcode = payload->ins.inst_opcode,
                                     .inst_group_tag = payload->ins.inst_group_tag,
                                     .inst_profiler_operator = "transport"};
 
-        auto send_delay = network_->transferAndGetDelay(payload->src_id, payload->dst_id,
-                                                        payload->request_data_size_byte, profiler_tag);
-        wait(send_delay);
-
-        auto target_switch = network_->getSwitch(payload->dst_id);
-        target_switch->receiveHandler(payload);
-        if (mode == +NetworkTransferMode::transport) {
-            auto receive_delay = network_->transferAndGetDelay(payload->dst_id, payload->src_id,
-                                                               payload->response_data_size_byte, profiler_tag);
-            wait(receive_delay);
+        if (mode == +NetworkTransferMode::multicast) {
+            const auto& dst_id_list = payload->multicast_dst_id_list;
+            auto delay_list = network_->multicastAndGetDelay(payload->src_id, dst_id_list,
+                                                             payload->request_data_size_byte, profiler_tag);
+
+            // deliver to dst in order of arrival
+            std::vector<int> order(dst_id_list.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return delay_list[a] < delay_list[b]; });
+            sc_time elapsed = SC_ZERO_TIME;
+            for (int i : order) {
+                wait(delay_list[i] - elapsed);
+                elapsed = delay_list[i];
+                network_->getSwitch(dst_id_list[i])->receiveHandler(payload);
+            }
+        } else if (mode == +NetworkTransferMode::response) {
+            auto response_delay = network_->transferAndGetDelay(payload->dst_id, payload->src_id,
+                                                                payload->response_data_size_byte, profiler_tag);
+            wait(response_delay);
+        } else {
+            auto send_delay = network_->transferAndGetDelay(payload->src_id, payload->dst_id,
+                                                            payload->request_data_size_byte, profiler_tag);
+            wait(send_delay);
+
+            auto target_switch = network_->getSwitch(payload->dst_id);
+            target_switch->receiveHandler(payload);
+            if (mode == +NetworkTransferMode::transport) {
+                if (target_switch->isAsyncResponse()) {
+                    // dst will send response by its own switch, finish event is notified there
+                    continue;
+                }
+                auto receive_delay = network_->transferAndGetDelay(payload->dst_id, payload->src_id,
+                                                                   payload->response_data_size_byte, profiler_tag);
+                wait(receive_delay);
+            }
         }
 
+        payload->network_trans_finished = true;
         if (payload->finish_network_trans != nullptr) {
             payload->finish_network_trans->notify(SC_ZERO_TIME);
         }
@@ -61,6 +91,16 @@ void Switch::sendHandler(const std::shared_ptr<NetworkPayload>& payload) {
     trigger_.notify();
 }
 
+void Switch::responseHandler(const std::shared_ptr<NetworkPayload>& payload) {
+    pending_queue_.emplace(payload, NetworkTransferMode::response);
+    trigger_.notify();
+}
+
+void Switch::multicastHandler(const std::shared_ptr<NetworkPayload>& payload) {
+    pending_queue_.emplace(payload, NetworkTransferMode::multicast);
+    trigger_.notify();
+}
+
 void Switch::registerReceiveHandler(
     const std::function<void(const std::shared_ptr<NetworkPayload>&)>& reveive_handler) {
     receive_handler_ = reveive_handler;
@@ -70,6 +110,14 @@ void Switch::receiveHandler(const std::shared_ptr<NetworkPayload>& payload) {
     receive_handler_(payload);
 }
 
+void Switch::setAsyncResponse(bool async_response) {
+    async_response_ = async_response;
+}
+
+bool Switch::isAsyncResponse() const {
+    return async_response_;
+}
+
 void Switch::bindNetwork(Network* network) {
     network_ = network;
     network_->registerSwitch(core_id_, this);
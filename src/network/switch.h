@@ -25,10 +25,18 @@ public:
     // send mode just sends data to dst without demands of response
     void transportHandler(const std::shared_ptr<NetworkPayload>& payload);
     void sendHandler(const std::shared_ptr<NetworkPayload>& payload);
+    // response of a transport request, sent back from dst by its own switch when dst responses asynchronously
+    void responseHandler(const std::shared_ptr<NetworkPayload>& payload);
+    // send to every dst in multicast_dst_id_list, packet is replicated in network
+    void multicastHandler(const std::shared_ptr<NetworkPayload>& payload);
 
     void registerReceiveHandler(const std::function<void(const std::shared_ptr<NetworkPayload>&)>& reveive_handler);
     void receiveHandler(const std::shared_ptr<NetworkPayload>& payload);  // when recv data from network,call this
 
+    // if set, receive handler only accepts transport request, and response is sent later by calling responseHandler
+    void setAsyncResponse(bool async_response);
+    [[nodiscard]] bool isAsyncResponse() const;
+
     void bindNetwork(Network* network);
 
 private:
@@ -36,6 +44,7 @@ private:
 
     std::queue<std::pair<std::shared_ptr<NetworkPayload>, NetworkTransferMode>> pending_queue_;
     std::function<void(const std::shared_ptr<NetworkPayload>&)> receive_handler_;
+    bool async_response_{false};
 
     Network* network_{nullptr};
 };
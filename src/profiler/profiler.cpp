@@ -4,6 +4,7 @@
 
 #include "profiler.h"
 
+#include "base_component/sim_context.h"
 #include "core/core.h"
 
 namespace cimsim {
@@ -40,6 +41,12 @@ void HardwareProfiler::finishRun() {
     }
 }
 
+void HardwareProfiler::reset() {
+    for (auto& [name, timing_statistic] : timing_statistic_map_) {
+        timing_statistic->reset();
+    }
+}
+
 void HardwareProfiler::report(std::ostream& ofs, int level_cnt, double total_latency) {
     for (auto& top_timing_statistic : top_timing_statistic_list_) {
         top_timing_statistic->report(ofs, 0, level_cnt, total_latency);
@@ -47,7 +54,7 @@ void HardwareProfiler::report(std::ostream& ofs, int level_cnt, double total_lat
 }
 
 void to_json(nlohmann::ordered_json& j, const HardwareProfiler& t) {
-    if (Profiler::json_flat) {
+    if (SimContext::current().json_flat) {
         for (auto& [name, timing_statistic] : t.timing_statistic_map_) {
             j[name] = *timing_statistic;
         }
@@ -94,6 +101,12 @@ void InstProfiler::finishRun() {
     }
 }
 
+void InstProfiler::reset() {
+    for (auto& [name, timing_statistic] : timing_statistic_map_) {
+        timing_statistic->reset();
+    }
+}
+
 void InstProfiler::report(std::ostream& ofs, double total_latency) {
     for (auto& top_timing_statistic : top_timing_statistic_list_) {
         top_timing_statistic->report(ofs, 0, total_latency);
@@ -101,7 +114,7 @@ void InstProfiler::report(std::ostream& ofs, double total_latency) {
 }
 
 void to_json(nlohmann::ordered_json& j, const InstProfiler& t) {
-    if (Profiler::json_flat) {
+    if (SimContext::current().json_flat) {
         for (auto& [name, timing_statistic] : t.timing_statistic_map_) {
             j[name] = *timing_statistic;
         }
@@ -163,11 +176,10 @@ std::shared_ptr<InstTimingStatistic> InstProfiler::getInstGroupTimingStatistic(c
     return timing_statistic_map_[std::string{profiler_tag.inst_group_tag}];
 }
 
-bool Profiler::json_flat = false;
-
 Profiler::Profiler(const ProfilerConfig& config) : config_(config), inst_profiler_(config_.inst_profiler_config) {
-    Profiler::json_flat = config_.json_flat;
-    HardwareTimingStatistic::record_time_segments_ = config_.hardware_profiler_config.record_timing_segments;
+    auto& context = SimContext::current();
+    context.json_flat = config_.json_flat;
+    context.record_time_segments = config_.hardware_profiler_config.record_timing_segments;
 }
 
 void Profiler::finishRun() {
@@ -175,6 +187,11 @@ void Profiler::finishRun() {
     inst_profiler_.finishRun();
 }
 
+void Profiler::reset() {
+    hardware_profiler_.reset();
+    inst_profiler_.reset();
+}
+
 void Profiler::report(std::ostream& ofs, double total_latency) {
     if (!config_.profiling) {
         return;
@@ -24,6 +24,7 @@ public:
                            const std::shared_ptr<HardwareTimingStatistic>& parent);
 
     void finishRun();
+    void reset();
 
     void report(std::ostream& ofs, int level_cnt, double total_latency);
 
@@ -42,6 +43,7 @@ public:
 
     void addActivityTime(double latency, const ProfilerTag& profiler_tag);
     void finishRun();
+    void reset();
 
     void report(std::ostream& ofs, double total_latency);
 
@@ -62,14 +64,13 @@ private:
 };
 
 class Profiler {
-public:
-    static bool json_flat;
-
 public:
     explicit Profiler(const ProfilerConfig& config);
 
     void bindHardware(EnergyCounter* chip_energy_counter, std::vector<std::shared_ptr<Core>>& core_list);
     void finishRun();
+    // restart all statistics from now, for the next layer in batch mode
+    void reset();
 
     void report(std::ostream& ofs, double total_latency);
 
@@ -6,6 +6,7 @@
 
 #include <utility>
 
+#include "base_component/sim_context.h"
 #include "fmt/format.h"
 #include "profiler.h"
 #include "util/util.h"
@@ -46,6 +47,13 @@ void TimingStatistic::finishRun() {
     }
 }
 
+void TimingStatistic::reset() {
+    activity_time_ = 0.0;
+    start_time_tag_ = sc_time_stamp();
+    end_time_tag_ = sc_time_stamp();
+    time_segment_list_.clear();
+}
+
 void TimingStatistic::report(std::ostream& ofs, double total_latency) {
     ofs << fmt::format("{:.3f}ns ({:.2f}%)", activity_time_,
                        (total_latency == 0.0 ? 0.0 : (activity_time_ / total_latency) * 100));
@@ -67,10 +75,8 @@ void to_json(nlohmann::ordered_json& j, const TimingStatistic& t) {
     j["time_segment_list"] = t.time_segment_list_;
 }
 
-bool HardwareTimingStatistic::record_time_segments_ = false;
-
 HardwareTimingStatistic::HardwareTimingStatistic(std::string name)
-    : name_(std::move(name)), timing_statistic_(record_time_segments_) {}
+    : name_(std::move(name)), timing_statistic_(SimContext::current().record_time_segments) {}
 
 void HardwareTimingStatistic::addActivityTime(double latency) {
     timing_statistic_.addActivityTime(latency);
@@ -83,6 +89,10 @@ void HardwareTimingStatistic::finishRun() {
     timing_statistic_.finishRun();
 }
 
+void HardwareTimingStatistic::reset() {
+    timing_statistic_.reset();
+}
+
 void HardwareTimingStatistic::addSub(const std::shared_ptr<HardwareTimingStatistic>& sub) {
     sub_list_.emplace_back(sub);
 }
@@ -115,7 +125,7 @@ const std::string& HardwareTimingStatistic::getName() const {
 void to_json(nlohmann::ordered_json& j, const HardwareTimingStatistic& t) {
     j["timing"] = t.timing_statistic_;
 
-    if (!Profiler::json_flat) {
+    if (!SimContext::current().json_flat) {
         for (auto& sub : t.sub_list_) {
             auto leaf_name = splitAndGetLastPart(sub->getName(), ".");
             j["sub"][leaf_name] = *sub;
@@ -143,6 +153,12 @@ void InstTimingStatistic::finishRun() {
     }
 }
 
+void InstTimingStatistic::reset() {
+    for (auto& [_, timing_statistic] : timing_statistic_list_) {
+        timing_statistic->reset();
+    }
+}
+
 void InstTimingStatistic::addSub(const std::shared_ptr<InstTimingStatistic>& sub) {
     sub_list_.emplace_back(sub);
 }
@@ -179,7 +195,7 @@ void to_json(nlohmann::ordered_json& j, const InstTimingStatistic& t) {
         j[inst_op] = *timing_statistic;
     }
 
-    if (!Profiler::json_flat) {
+    if (!SimContext::current().json_flat) {
         for (auto& sub : t.sub_list_) {
             auto leaf_name = splitAndGetLastPart(sub->getName(), ".");
             j["sub"][leaf_name] = *sub;
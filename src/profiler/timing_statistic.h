@@ -26,6 +26,8 @@ public:
 
     void addActivityTime(double latency);
     void finishRun();
+    // restart statistic from now, called after finishRun
+    void reset();
 
     void report(std::ostream& ofs, double total_latency);
     friend void to_json(nlohmann::ordered_json& j, const TimingStatistic& t);
@@ -40,14 +42,12 @@ private:
 };
 
 class HardwareTimingStatistic {
-public:
-    static bool record_time_segments_;
-
 public:
     explicit HardwareTimingStatistic(std::string name);
 
     void addActivityTime(double latency);
     void finishRun();
+    void reset();
 
     void addSub(const std::shared_ptr<HardwareTimingStatistic>& sub);
     void setParent(const std::shared_ptr<HardwareTimingStatistic>& parent);
@@ -72,6 +72,7 @@ public:
 
     void addActivityTime(double latency, const std::string& inst_profiler_operator);
     void finishRun();
+    void reset();
 
     void addSub(const std::shared_ptr<InstTimingStatistic>& sub);
     void setParent(const std::shared_ptr<InstTimingStatistic>& parent);
@@ -0,0 +1,437 @@
+#include "dse_simulator.h"
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <random>
+#include <set>
+
+#include "argparse/argparse.hpp"
+#include "config/config.h"
+#include "constant.h"
+#include "fmt/format.h"
+#include "systemc.h"
+#include "util/reporter.h"
+#include "util/util.h"
+
+namespace cimsim {
+
+bool DSEConfig::checkValid() const {
+    if (layer_inst_files.empty()) {
+        std::cerr << "DSEConfig not valid, 'layer_inst_files' must not be empty" << std::endl;
+        return false;
+    }
+    if (worker_cnt < 1) {
+        std::cerr << "DSEConfig not valid, 'worker_cnt' must be positive" << std::endl;
+        return false;
+    }
+    if (strategy != "grid" && strategy != "random" && strategy != "latin_hypercube") {
+        std::cerr << "DSEConfig not valid, 'strategy' must be 'grid', 'random' or 'latin_hypercube'" << std::endl;
+        return false;
+    }
+    if (strategy != "grid" && sample_cnt < 1) {
+        std::cerr << "DSEConfig not valid, 'sample_cnt' must be positive" << std::endl;
+        return false;
+    }
+    if (parameters.empty()) {
+        std::cerr << "DSEConfig not valid, 'parameters' must not be empty" << std::endl;
+        return false;
+    }
+    for (const auto& parameter : parameters) {
+        if (parameter.path.empty() || parameter.path[0] != '/' || !parameter.values.is_array() ||
+            parameter.values.empty()) {
+            std::cerr << fmt::format("DSEConfig not valid, parameter '{}' needs a json pointer path and values",
+                                     parameter.path)
+                      << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DSEResult::dominates(double other_latency_ms, double other_energy_pJ) const {
+    return latency_ms <= other_latency_ms && energy_pJ <= other_energy_pJ;
+}
+
+namespace {
+
+// value index of every parameter
+using DSEPoint = std::vector<int>;
+
+std::vector<DSEPoint> sampleGrid(const DSEConfig& config) {
+    std::vector<DSEPoint> point_list;
+    DSEPoint point(config.parameters.size(), 0);
+    while (true) {
+        point_list.push_back(point);
+        int i = 0;
+        for (; i < point.size(); i++) {
+            if (++point[i] < config.parameters[i].values.size()) {
+                break;
+            }
+            point[i] = 0;
+        }
+        if (i == point.size()) {
+            return point_list;
+        }
+    }
+}
+
+std::vector<DSEPoint> sampleRandom(const DSEConfig& config, std::mt19937& gen) {
+    std::vector<DSEPoint> point_list(config.sample_cnt, DSEPoint(config.parameters.size()));
+    for (int i = 0; i < config.parameters.size(); i++) {
+        std::uniform_int_distribution<int> dist(0, static_cast<int>(config.parameters[i].values.size()) - 1);
+        for (auto& point : point_list) {
+            point[i] = dist(gen);
+        }
+    }
+    return point_list;
+}
+
+std::vector<DSEPoint> sampleLatinHypercube(const DSEConfig& config, std::mt19937& gen) {
+    // every parameter range is split into sample_cnt strata, each stratum is sampled exactly once
+    int n = config.sample_cnt;
+    std::vector<DSEPoint> point_list(n, DSEPoint(config.parameters.size()));
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    for (int i = 0; i < config.parameters.size(); i++) {
+        std::vector<int> stratum_list(n);
+        std::iota(stratum_list.begin(), stratum_list.end(), 0);
+        std::shuffle(stratum_list.begin(), stratum_list.end(), gen);
+
+        int value_cnt = static_cast<int>(config.parameters[i].values.size());
+        for (int j = 0; j < n; j++) {
+            int value_index = static_cast<int>((stratum_list[j] + dist(gen)) / n * value_cnt);
+            point_list[j][i] = std::min(value_index, value_cnt - 1);
+        }
+    }
+    return point_list;
+}
+
+std::vector<DSEPoint> samplePoints(const DSEConfig& config) {
+    std::vector<DSEPoint> point_list;
+    std::mt19937 gen(config.seed);
+    if (config.strategy == "grid") {
+        point_list = sampleGrid(config);
+    } else if (config.strategy == "random") {
+        point_list = sampleRandom(config, gen);
+    } else {
+        point_list = sampleLatinHypercube(config, gen);
+    }
+
+    // random samples may repeat, keep the first one
+    std::set<DSEPoint> sampled;
+    point_list.erase(std::remove_if(point_list.begin(), point_list.end(),
+                                    [&sampled](const DSEPoint& point) { return !sampled.insert(point).second; }),
+                     point_list.end());
+    return point_list;
+}
+
+std::vector<DSEResult> readResultFile(const std::string& file) {
+    std::vector<DSEResult> result_list;
+    std::ifstream ifs(file);
+    std::string line;
+    while (std::getline(ifs, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        try {
+            result_list.push_back(nlohmann::ordered_json::parse(line).get<DSEResult>());
+        } catch (const nlohmann::json::exception&) {
+            // a line may be cut off if the driver is killed while appending
+            std::cerr << fmt::format("Skip broken line of result file '{}'", file) << std::endl;
+        }
+    }
+    return result_list;
+}
+
+std::vector<DSEResult> getParetoFront(const std::vector<DSEResult>& result_list) {
+    std::vector<DSEResult> pareto_front;
+    for (const auto& result : result_list) {
+        if (result.status != "finished") {
+            continue;
+        }
+        bool dominated = std::any_of(result_list.begin(), result_list.end(), [&result](const DSEResult& other) {
+            return other.status == "finished" && other.dominates(result.latency_ms, result.energy_pJ) &&
+                   (other.latency_ms < result.latency_ms || other.energy_pJ < result.energy_pJ);
+        });
+        if (!dominated) {
+            pareto_front.push_back(result);
+        }
+    }
+    std::sort(pareto_front.begin(), pareto_front.end(),
+              [](const DSEResult& r1, const DSEResult& r2) { return r1.latency_ms < r2.latency_ms; });
+    return pareto_front;
+}
+
+void writeParetoFront(const DSEConfig& config, const std::vector<DSEResult>& result_list) {
+    auto pareto_front = getParetoFront(result_list);
+    auto finished_cnt = std::count_if(result_list.begin(), result_list.end(),
+                                      [](const DSEResult& result) { return result.status == "finished"; });
+    std::cout << fmt::format("Pareto front of {} finished points:", finished_cnt) << std::endl;
+    for (const auto& result : pareto_front) {
+        std::cout << fmt::format("  - latency: {:.4f} ms, energy: {:.2f} pJ, TOPS/W: {:.4f}, point: {}",
+                                 result.latency_ms, result.energy_pJ, result.TOPS_per_W, result.point.dump())
+                  << std::endl;
+    }
+
+    nlohmann::ordered_json pareto_json = pareto_front;
+    std::ofstream ofs(config.pareto_file);
+    ofs << pareto_json.dump(2);
+}
+
+class DSEDriver {
+public:
+    explicit DSEDriver(const DSEConfig& config) : config_(config) {}
+
+    void run() {
+        std::filesystem::create_directories(config_.work_dir);
+        base_config_json_ = readTypeFromJsonFile<nlohmann::ordered_json>(config_.base_config_file);
+        nlohmann::ordered_json study_json{{"base_config", base_config_json_}, {"layers", config_.layer_inst_files}};
+        study_hash_ = std::hash<std::string>{}(study_json.dump());
+        for (const auto& parameter : config_.parameters) {
+            if (!base_config_json_.contains(nlohmann::ordered_json::json_pointer{parameter.path})) {
+                std::cout << fmt::format("Warning: parameter '{}' is not in base config", parameter.path)
+                          << std::endl;
+            }
+        }
+
+        // resume, points in result file are skipped and their results join pruning
+        result_list_ = readResultFile(config_.result_file);
+        std::set<std::string> done_key_set;
+        for (const auto& result : result_list_) {
+            done_key_set.insert(result.key);
+        }
+
+        std::vector<DSEPoint> pending_list;
+        for (auto& point : samplePoints(config_)) {
+            if (done_key_set.count(getPointKey(point)) == 0) {
+                pending_list.push_back(std::move(point));
+            }
+        }
+        std::cout << fmt::format("DSE: {} points to run, {} points resumed from '{}'", pending_list.size(),
+                                 result_list_.size(), config_.result_file)
+                  << std::endl;
+
+        result_ofs_.open(config_.result_file, std::ios::app);
+        auto next_point = pending_list.begin();
+        while (next_point != pending_list.end() || !running_map_.empty()) {
+            while (running_map_.size() < config_.worker_cnt && next_point != pending_list.end()) {
+                startPoint(*next_point++);
+            }
+            if (!running_map_.empty()) {
+                waitLayer();
+            }
+        }
+        result_ofs_.close();
+
+        writeParetoFront(config_, result_list_);
+    }
+
+private:
+    struct RunningPoint {
+        DSEResult result;
+        std::string point_dir;
+        Reporter reporter;
+    };
+
+    // points of another base config or layer list in the same result file are not resumed
+    [[nodiscard]] std::string getPointKey(const DSEPoint& point) const {
+        nlohmann::ordered_json value_list = nlohmann::ordered_json::array();
+        for (int i = 0; i < point.size(); i++) {
+            value_list.push_back(config_.parameters[i].values[point[i]]);
+        }
+        return fmt::format("{:016x}:{}", study_hash_, value_list.dump());
+    }
+
+    void startPoint(const DSEPoint& point) {
+        RunningPoint running{.result = {.key = getPointKey(point)}};
+        auto config_json = base_config_json_;
+        for (int i = 0; i < point.size(); i++) {
+            const auto& parameter = config_.parameters[i];
+            config_json[nlohmann::ordered_json::json_pointer{parameter.path}] = parameter.values[point[i]];
+            running.result.point[parameter.path] = parameter.values[point[i]];
+        }
+
+        bool valid;
+        try {
+            valid = config_json.get<Config>().checkValid();
+        } catch (const nlohmann::json::exception& e) {
+            std::cerr << e.what() << std::endl;
+            valid = false;
+        }
+        if (!valid) {
+            running.result.status = "invalid";
+            finishPoint(running.result);
+            return;
+        }
+
+        running.point_dir =
+            fmt::format("{}/point_{:016x}", config_.work_dir, std::hash<std::string>{}(running.result.key));
+        std::filesystem::create_directories(running.point_dir);
+        std::ofstream ofs(fmt::format("{}/config.json", running.point_dir));
+        ofs << config_json.dump(2);
+        ofs.close();
+
+        startLayer(std::move(running));
+    }
+
+    void startLayer(RunningPoint running) {
+        // every layer runs in its own simulator process, because simulation kernel can only be elaborated once
+        // paths are passed as arguments directly, no shell parses them
+        int layer = running.result.finished_layer_cnt;
+        std::vector<std::string> arg_list{config_.simulator,
+                                          fmt::format("{}/config.json", running.point_dir),
+                                          config_.profiler_config_file,
+                                          config_.layer_inst_files[layer],
+                                          "-j",
+                                          fmt::format("{}/report{}.json", running.point_dir, layer)};
+        std::vector<char*> argv;
+        for (auto& arg : arg_list) {
+            argv.push_back(arg.data());
+        }
+        argv.push_back(nullptr);
+        auto log_file = fmt::format("{}/log{}.txt", running.point_dir, layer);
+
+        pid_t pid = fork();
+        if (pid == 0) {
+            int log_fd = open(log_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (log_fd < 0) {
+                _exit(EXIT_FAILURE);
+            }
+            dup2(log_fd, STDOUT_FILENO);
+            dup2(log_fd, STDERR_FILENO);
+            close(log_fd);
+            execv(argv[0], argv.data());
+            _exit(EXIT_FAILURE);
+        }
+        if (pid < 0) {
+            std::cout << "Fork Error!" << std::endl;
+            running.result.status = "failed";
+            finishPoint(running.result);
+            return;
+        }
+        running_map_.emplace(pid, std::move(running));
+    }
+
+    void waitLayer() {
+        int status;
+        pid_t pid;
+        do {
+            pid = waitpid(-1, &status, 0);
+        } while (pid < 0 && errno == EINTR);
+        if (pid < 0) {
+            // no child is left to wait for, so running points can never finish
+            std::cerr << fmt::format("waitpid failed: {}", std::strerror(errno)) << std::endl;
+            for (auto& [running_pid, running] : running_map_) {
+                running.result.status = "failed";
+                finishPoint(running.result);
+            }
+            running_map_.clear();
+            return;
+        }
+        auto found = running_map_.find(pid);
+        if (found == running_map_.end()) {
+            return;
+        }
+        auto running = std::move(found->second);
+        running_map_.erase(found);
+
+        int layer = running.result.finished_layer_cnt;
+        auto report_json_file = fmt::format("{}/report{}.json", running.point_dir, layer);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != TEST_PASSED || !std::filesystem::exists(report_json_file)) {
+            running.result.status = "failed";
+            finishPoint(running.result);
+            return;
+        }
+
+        running.reporter += readTypeFromJsonFile<Reporter>(report_json_file);
+        running.result.finished_layer_cnt++;
+        setPerformance(running.result, running.reporter);
+
+        if (running.result.finished_layer_cnt == config_.layer_inst_files.size()) {
+            running.result.status = "finished";
+            finishPoint(running.result);
+        } else if (config_.prune && isDominated(running.result)) {
+            // later layers only add latency and energy, so the point can not reach the pareto front
+            running.result.status = "pruned";
+            finishPoint(running.result);
+        } else {
+            startLayer(std::move(running));
+        }
+    }
+
+    void setPerformance(DSEResult& result, const Reporter& reporter) const {
+        result.latency_ms = reporter.getLatencyNs() / 1e6;
+        result.energy_pJ = reporter.getTotalEnergyPJ();
+        result.average_power_mW = reporter.getAveragePowerMW();
+        result.TOPS = result.latency_ms == 0.0 ? 0.0 : config_.OP_count / (result.latency_ms / 1e3) / 1e12;
+        result.TOPS_per_W = result.average_power_mW == 0.0 ? 0.0 : result.TOPS / (result.average_power_mW / 1e3);
+    }
+
+    [[nodiscard]] bool isDominated(const DSEResult& partial_result) const {
+        return std::any_of(result_list_.begin(), result_list_.end(), [&partial_result](const DSEResult& result) {
+            return result.status == "finished" &&
+                   result.dominates(partial_result.latency_ms, partial_result.energy_pJ);
+        });
+    }
+
+    void finishPoint(const DSEResult& result) {
+        std::cout << fmt::format("  point {}: {}, {} layers, latency: {:.4f} ms, energy: {:.2f} pJ", result.key,
+                                 result.status, result.finished_layer_cnt, result.latency_ms, result.energy_pJ)
+                  << std::endl;
+        result_ofs_ << nlohmann::ordered_json(result).dump() << std::endl;
+        result_list_.push_back(result);
+    }
+
+private:
+    const DSEConfig& config_;
+    nlohmann::ordered_json base_config_json_;
+    std::size_t study_hash_{0};  // hash of base config and layer list
+
+    std::vector<DSEResult> result_list_;
+    std::ofstream result_ofs_;
+
+    std::map<pid_t, RunningPoint> running_map_;
+};
+
+}  // namespace
+
+}  // namespace cimsim
+
+int sc_main(int argc, char* argv[]) {
+    argparse::ArgumentParser parser("DSESimulator");
+    parser.add_argument("dse_config").help("design space exploration config file");
+    parser.add_argument("-p", "--pareto")
+        .help("only extract pareto front from result file")
+        .default_value(false)
+        .implicit_value(true);
+
+    try {
+        parser.parse_args(argc, argv);
+    } catch (const std::runtime_error& err) {
+        std::cerr << err.what() << std::endl;
+        std::cerr << parser;
+        return INVALID_USAGE;
+    }
+
+    auto dse_config = cimsim::readTypeFromJsonFile<cimsim::DSEConfig>(parser.get("dse_config"));
+    if (!dse_config.checkValid()) {
+        return INVALID_CONFIG;
+    }
+
+    if (parser.get<bool>("--pareto")) {
+        cimsim::writeParetoFront(dse_config, cimsim::readResultFile(dse_config.result_file));
+    } else {
+        cimsim::DSEDriver driver{dse_config};
+        driver.run();
+    }
+    return TEST_PASSED;
+}
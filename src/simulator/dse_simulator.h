@@ -0,0 +1,72 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+#include "util/macro_scope.h"
+
+namespace cimsim {
+
+// parameter values and points keep raw json, whatever type the config field has
+inline void from_json(const nlohmann::ordered_json& j, nlohmann::ordered_json& t) {
+    t = j;
+}
+
+struct DSEParameterConfig {
+    // json pointer into config, such as "/chip_config/core_config/cim_unit_config/macro_total_cnt"
+    std::string path{};
+    nlohmann::ordered_json values{};  // array of candidate values
+
+    DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT_INTRUSIVE(DSEParameterConfig, path, values)
+};
+
+struct DSEConfig {
+    std::string base_config_file{};
+    std::string profiler_config_file{};
+    // layers of the network run in order, the result of a point is the sum of all layers
+    std::vector<std::string> layer_inst_files{};
+    std::string simulator{"./LayerSimulator"};
+
+    std::string work_dir{"dse"};
+    std::string result_file{"dse/result.jsonl"};  // one json per line, only appended, so exploration can resume
+    std::string pareto_file{"dse/pareto.json"};
+
+    int worker_cnt{1};
+    std::string strategy{"grid"};  // grid, random or latin_hypercube
+    int sample_cnt{16};            // count of points of random and latin_hypercube
+    unsigned int seed{0};
+    double OP_count{0.0};
+
+    // stop a point once its partial result of finished layers is dominated by a finished point
+    bool prune{true};
+
+    std::vector<DSEParameterConfig> parameters{};
+
+    [[nodiscard]] bool checkValid() const;
+
+    DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT_INTRUSIVE(DSEConfig, base_config_file, profiler_config_file,
+                                                             layer_inst_files, simulator, work_dir, result_file,
+                                                             pareto_file, worker_cnt, strategy, sample_cnt, seed,
+                                                             OP_count, prune, parameters)
+};
+
+struct DSEResult {
+    std::string key{};                // hash of base config and layers, and values of all parameters
+    nlohmann::ordered_json point{};   // parameter path -> value
+    std::string status{};             // finished, pruned, invalid or failed
+    int finished_layer_cnt{0};
+    double latency_ms{0.0};
+    double energy_pJ{0.0};
+    double average_power_mW{0.0};
+    double TOPS{0.0};
+    double TOPS_per_W{0.0};
+
+    // lower or equal latency and energy
+    [[nodiscard]] bool dominates(double other_latency_ms, double other_energy_pJ) const;
+
+    DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT_INTRUSIVE(DSEResult, key, point, status, finished_layer_cnt,
+                                                             latency_ms, energy_pJ, average_power_mW, TOPS,
+                                                             TOPS_per_W)
+};
+
+}  // namespace cimsim
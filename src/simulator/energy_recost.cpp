@@ -0,0 +1,94 @@
+#include <fstream>
+#include <iostream>
+
+#include "argparse/argparse.hpp"
+#include "base_component/activity_trace.h"
+#include "chip/chip.h"
+#include "constant.h"
+#include "util/util.h"
+
+namespace cimsim {
+
+struct RecostArguments {
+    std::string config_file;
+    std::string activity_trace_file;
+
+    std::string simulation_report_file;
+    std::string report_json_file;
+
+    bool list_every_core_energy;
+};
+
+RecostArguments parseRecostArguments(int argc, char* argv[]) {
+    argparse::ArgumentParser parser("EnergyRecost");
+    parser.add_argument("config").help("config file differing from the recorded one only in power params");
+    parser.add_argument("trace").help("activity trace file");
+    parser.add_argument("-s", "--sim_report").help("simulation report file").default_value("");
+    parser.add_argument("-j", "--report_json").help("report json file").default_value("");
+    parser.add_argument("-l", "--list_cores")
+        .help("whether to list every core energy")
+        .default_value(false)
+        .implicit_value(true);
+
+    try {
+        parser.parse_args(argc, argv);
+    } catch (const std::runtime_error& err) {
+        std::cerr << err.what() << std::endl;
+        std::cerr << parser;
+        std::exit(INVALID_USAGE);
+    }
+
+    return RecostArguments{.config_file = parser.get("config"),
+                           .activity_trace_file = parser.get("trace"),
+                           .simulation_report_file = parser.get("--sim_report"),
+                           .report_json_file = parser.get("--report_json"),
+                           .list_every_core_energy = parser.get<bool>("--list_cores")};
+}
+
+}  // namespace cimsim
+
+int sc_main(int argc, char* argv[]) {
+    using namespace cimsim;
+    sc_report_handler::set_actions(SC_WARNING, SC_DO_NOTHING);
+
+    auto args = parseRecostArguments(argc, argv);
+
+    auto config = readTypeFromJsonFile<Config>(args.config_file);
+    if (!config.checkValid()) {
+        std::cout << "Invalid config" << std::endl;
+        return INVALID_CONFIG;
+    }
+    AddressSapce::initialize(config.chip_config);
+
+    ActivityTrace activity_trace;
+    if (!activity_trace.readFromFile(args.activity_trace_file)) {
+        return TEST_FAILED;
+    }
+
+    // chip is only elaborated to build energy counters with new power params, no instruction is simulated
+    ProfilerConfig profiler_config;
+    std::vector<std::vector<Instruction>> core_ins_list(config.chip_config.core_cnt);
+    Chip chip{"Chip", config, profiler_config, core_ins_list};
+    if (!chip.replayActivityTrace(activity_trace)) {
+        return TEST_FAILED;
+    }
+
+    std::ofstream ofs;
+    if (!args.simulation_report_file.empty()) {
+        ofs.open(args.simulation_report_file);
+    }
+    std::ostream& os = args.simulation_report_file.empty() ? std::cout : ofs;
+    os << "|*************** Energy Re-cost Report ***************|\n";
+    os << fmt::format("  - {:<20}{}\n", "config file:", args.config_file);
+    os << fmt::format("  - {:<20}{}\n", "activity trace file:", args.activity_trace_file);
+    auto reporter = chip.report(os, args.list_every_core_energy);
+
+    if (!args.report_json_file.empty()) {
+        nlohmann::json report_json = reporter;
+        std::ofstream json_ofs;
+        json_ofs.open(args.report_json_file);
+        json_ofs << report_json;
+        json_ofs.close();
+    }
+    return TEST_PASSED;
+}
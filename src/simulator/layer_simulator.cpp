@@ -4,8 +4,6 @@
 
 #include "layer_simulator.h"
 
-#include <chrono>
-
 #include "argparse/argparse.hpp"
 #include "constant.h"
 #include "fmt/format.h"
@@ -14,10 +12,11 @@
 namespace cimsim {
 
 LayerSimulator::LayerSimulator(std::string config_file, std::string profiler_config_file, std::string instruction_file,
-                               bool check)
+                               bool check, std::vector<std::string> batch_instruction_files)
     : config_file_(std::move(config_file))
     , profiler_config_file_(std::move(profiler_config_file))
     , instruction_file_(std::move(instruction_file))
+    , batch_instruction_files_(std::move(batch_instruction_files))
     // , global_image_file_(std::move(global_image_file))
     // , expected_ins_stat_file_(std::move(expected_ins_stat_file))
     // , expected_reg_file_(std::move(expected_reg_file))
@@ -33,28 +32,17 @@ void LayerSimulator::run() {
         std::cout << "Invalid config" << std::endl;
         return;
     }
-    AddressSapce::initialize(config_.chip_config);
     std::cout << "Load finish" << std::endl;
 
     std::cout << "Reading Instructions" << std::endl;
-    auto core_ins_list = getCoreInstructionList();
+    auto core_ins_list = getCoreInstructionList(instruction_file_);
+    simulation_ = std::make_shared<Simulation>(config_, profiler_config_, std::move(core_ins_list));
+    for (const auto& batch_instruction_file : batch_instruction_files_) {
+        simulation_->addBatchLayer(getCoreInstructionList(batch_instruction_file));
+    }
     std::cout << "Read finish" << std::endl;
 
-    std::cout << "Build Chip" << std::endl;
-    chip_ = std::make_shared<Chip>("Chip", config_, profiler_config_, core_ins_list);
-    std::cout << "Build finish" << std::endl;
-
-    std::cout << "Start Simulation" << std::endl;
-    auto start = std::chrono::high_resolution_clock::now();
-    if (config_.sim_config.sim_mode == +SimMode::run_until_time) {
-        sc_start(config_.sim_config.sim_time_ms, SC_MS);
-    } else {
-        sc_start();
-    }
-    auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> duration = end - start;
-    exec_time_ = duration.count();
-    std::cout << "Simulation Finish" << std::endl;
+    simulation_->run();
 }
 
 void LayerSimulator::report(std::ostream& os, const std::string& report_json_file, bool report_every_core_energy) {
@@ -64,14 +52,19 @@ void LayerSimulator::report(std::ostream& os, const std::string& report_json_fil
     std::string sub_line = "  - {:<20}{}\n";
     os << fmt::format(sub_line, "config file:", config_file_);
     os << fmt::format(sub_line, "instruction file:", instruction_file_);
+    for (const auto& batch_instruction_file : batch_instruction_files_) {
+        os << fmt::format(sub_line, "batch layer file:", batch_instruction_file);
+    }
     os << fmt::format(sub_line, "simulation mode:", config_.sim_config.sim_mode._to_string());
     if (config_.sim_config.sim_mode == +SimMode::run_until_time) {
         os << fmt::format("  - {:<20}{} ms\n", "simulation time:", config_.sim_config.sim_time_ms);
     }
     os << fmt::format(sub_line, "data mode:", config_.sim_config.data_mode._to_string());
 
-    auto reporter = chip_->report(os, report_every_core_energy);
-    reporter.setExecTime(exec_time_);
+    Reporter reporter;
+    if (simulation_ != nullptr) {
+        reporter = simulation_->report(os, report_every_core_energy);
+    }
 
     if (!report_json_file.empty()) {
         nlohmann::json report_json = reporter;
@@ -79,6 +72,19 @@ void LayerSimulator::report(std::ostream& os, const std::string& report_json_fil
         ofs.open(report_json_file);
         ofs << report_json;
         ofs.close();
+
+        // batch mode, reporter of every layer next to the total, such as report_layer0.json for report.json
+        if (simulation_ != nullptr) {
+            auto layer_reporter_list = simulation_->getLayerReporterList();
+            auto stem = report_json_file.substr(0, report_json_file.rfind(".json"));
+            for (int layer_id = 0; layer_id < layer_reporter_list.size(); layer_id++) {
+                nlohmann::json layer_report_json = layer_reporter_list[layer_id];
+                std::ofstream layer_ofs;
+                layer_ofs.open(fmt::format("{}_layer{}.json", stem, layer_id));
+                layer_ofs << layer_report_json;
+                layer_ofs.close();
+            }
+        }
     }
 }
 
@@ -90,8 +96,9 @@ void LayerSimulator::report(std::ostream& os, const std::string& report_json_fil
 //     return check_text_file_same(expected_reg_file_, actual_reg_file_);
 // }
 
-std::vector<std::vector<Instruction>> LayerSimulator::getCoreInstructionList() const {
-    std::ifstream instruction_if(instruction_file_);
+std::vector<std::vector<Instruction>> LayerSimulator::getCoreInstructionList(
+    const std::string& instruction_file) const {
+    std::ifstream instruction_if(instruction_file);
     nlohmann::ordered_json instruction_json = nlohmann::ordered_json::parse(instruction_if);
 
     int core_cnt = config_.chip_config.core_cnt;
@@ -118,6 +125,7 @@ struct CimArguments {
     std::string config_file;
     std::string profiler_config_file;
     std::string instruction_file;
+    std::vector<std::string> batch_instruction_files;
     // std::string global_image_file;
     // std::string expected_ins_stat_file;
     // std::string expected_reg_file;
@@ -136,6 +144,10 @@ CimArguments parseCimArguments(int argc, char* argv[]) {
     parser.add_argument("config").help("config file");
     parser.add_argument("profiler_config").help("profiler config file");
     parser.add_argument("inst").help("instruction file");
+    parser.add_argument("-b", "--batch")
+        .help("instruction file of a following layer run on the same chip, can be repeated")
+        .default_value(std::vector<std::string>{})
+        .append();
     // parser.add_argument("global").help("global image file");
     // parser.add_argument("stat").help("expected ins stat file");
     // parser.add_argument("reg").help("expected reg file");
@@ -168,6 +180,7 @@ CimArguments parseCimArguments(int argc, char* argv[]) {
     return CimArguments{.config_file = parser.get("config"),
                         .profiler_config_file = parser.get("profiler_config"),
                         .instruction_file = parser.get("inst"),
+                        .batch_instruction_files = parser.get<std::vector<std::string>>("--batch"),
                         // .global_image_file = parser.get("global"),
                         // .expected_ins_stat_file = parser.get("stat"),
                         // .expected_reg_file = parser.get("reg"),
@@ -189,7 +202,7 @@ int sc_main(int argc, char* argv[]) {
                                            // args.expected_ins_stat_file,
                                            // args.expected_reg_file,
                                            // args.actual_reg_file,
-                                           args.check};
+                                           args.check, args.batch_instruction_files};
     layer_simulator.run();
 
     if (!args.simulation_report_file.empty()) {
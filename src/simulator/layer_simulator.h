@@ -4,15 +4,18 @@
 
 #pragma once
 #include <string>
+#include <vector>
 
-#include "chip/chip.h"
 #include "config/config.h"
+#include "simulation.h"
 
 namespace cimsim {
 
 class LayerSimulator {
 public:
-    LayerSimulator(std::string config_file, std::string profiler_config_file, std::string instruction_file, bool check);
+    // batch instruction files are simulated in order after instruction file, reusing the same chip
+    LayerSimulator(std::string config_file, std::string profiler_config_file, std::string instruction_file, bool check,
+                   std::vector<std::string> batch_instruction_files = {});
 
     void run();
 
@@ -22,10 +25,11 @@ public:
     // [[nodiscard]] bool checkReg() const;
 
 private:
-    [[nodiscard]] std::vector<std::vector<Instruction>> getCoreInstructionList() const;
+    [[nodiscard]] std::vector<std::vector<Instruction>> getCoreInstructionList(
+        const std::string& instruction_file) const;
 
 private:
-    std::shared_ptr<Chip> chip_;
+    std::shared_ptr<Simulation> simulation_;
 
     Config config_;
     ProfilerConfig profiler_config_;
@@ -33,13 +37,12 @@ private:
     std::string config_file_;
     std::string profiler_config_file_;
     std::string instruction_file_;
+    std::vector<std::string> batch_instruction_files_;
     // std::string global_image_file_;
     // std::string expected_ins_stat_file_;
     // std::string expected_reg_file_;
     // std::string actual_reg_file_;
     bool check_;
-
-    double exec_time_{};
 };
 
 }  // namespace cimsim
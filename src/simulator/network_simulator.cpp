@@ -5,9 +5,13 @@
 #include "network_simulator.h"
 
 #include <chrono>
+#include <memory>
 
+#include "argparse/argparse.hpp"
+#include "config/config.h"
 #include "constant.h"
 #include "systemc.h"
+#include "util/result_cache.h"
 #include "util/util.h"
 
 #if defined(WIN32)
@@ -19,11 +23,27 @@
 
 namespace cimsim {
 
+const std::string LAYER_SIMULATOR_FILE = "./LayerSimulator";
+
 Reporter test_network(const std::string& data_root_dir, const std::string& report_root_dir, const std::string& network,
                       const TestCaseConfig& test_case_config, const std::vector<LayerConfig>& layer_config,
-                      bool& all_tests_passed, double OP_count) {
+                      bool& all_tests_passed, double OP_count, const ResultCache* result_cache, bool force_rerun) {
     auto data_dir = fmt::format("{}/{}/{}", data_root_dir, test_case_config.test_case_name, network);
     auto report_dir = fmt::format("{}/{}", report_root_dir, TEMP_REPORT_DIR_NAME);
+    std::string profiler_config_file = "../config/profiler_config.json";
+
+    // runs writing checkpoint or activity trace, or starting from a checkpoint, always simulate
+    Config config{};
+    ProfilerConfig profiler_config{};
+    if (result_cache != nullptr) {
+        config = readTypeFromJsonFile<Config>(test_case_config.config_file_path);
+        profiler_config = readTypeFromJsonFile<ProfilerConfig>(profiler_config_file);
+        const auto& sim_config = config.sim_config;
+        if (!sim_config.activity_trace_file.empty() || sim_config.checkpoint.isSaveSet() ||
+            !sim_config.checkpoint.restore_file.empty()) {
+            result_cache = nullptr;
+        }
+    }
 
     std::size_t execute_times = layer_config.size();
     Reporter total_reporter;
@@ -40,10 +60,20 @@ Reporter test_network(const std::string& data_root_dir, const std::string& repor
         //     fmt::format("{}/{}/{}", data_dir, layer_config[i].sub_dir_name, EXPECTED_REG_FILE_NAME);
         // auto actual_reg_file = fmt::format("{}/{}", report_dir, ACTUAL_REG_FILE_NAME);
 
+        std::string cache_key;
+        if (result_cache != nullptr) {
+            cache_key = result_cache->getKey(config, profiler_config, code_file);
+            if (!force_rerun && result_cache->load(cache_key, report_json_file)) {
+                std::cout << "Passed (cached)" << std::endl;
+                total_reporter += readTypeFromJsonFile<Reporter>(report_json_file);
+                remove(report_json_file.c_str());
+                continue;
+            }
+        }
+
         // execute and generate json file
-        std::string profiler_config_file = "../config/profiler_config.json";
-        auto cmd = fmt::format("./LayerSimulator {} {} {} -j {} >> ./log.txt 2>&1", test_case_config.config_file_path,
-                               profiler_config_file, code_file, report_json_file);
+        auto cmd = fmt::format("{} {} {} {} -j {} >> ./log.txt 2>&1", LAYER_SIMULATOR_FILE,
+                               test_case_config.config_file_path, profiler_config_file, code_file, report_json_file);
         // std::cout << cmd << std::endl;
         int status = system(cmd.c_str());
         if (status == -1) {
@@ -55,6 +85,9 @@ Reporter test_network(const std::string& data_root_dir, const std::string& repor
         } else {
             if (int result = WEXITSTATUS(status); result == TEST_PASSED) {
                 std::cout << "Passed" << std::endl;
+                if (result_cache != nullptr) {
+                    result_cache->store(cache_key, report_json_file);
+                }
             } else {
                 all_tests_passed = false;
                 if (result == TEST_FAILED) {
@@ -90,17 +123,24 @@ Reporter test_network(const std::string& data_root_dir, const std::string& repor
     return std::move(total_reporter);
 }
 
-void test_wrap(const std::string& test_config_file, bool& all_tests_passed) {
+void test_wrap(const std::string& test_config_file, bool force_rerun, bool& all_tests_passed) {
     auto test_config = readTypeFromJsonFile<TestConfig>(test_config_file);
     std::map<std::string, Reporter> reporters;
 
+    std::unique_ptr<ResultCache> result_cache;
+    if (!test_config.cache_dir.empty()) {
+        result_cache =
+            std::make_unique<ResultCache>(test_config.cache_dir, test_config.cache_max_size_MB, LAYER_SIMULATOR_FILE);
+    }
+
     if (test_config.generate_report) {
         for (int i = 0; i < test_config.test_case_config.size(); i++) {
             if (const auto& test_case = test_config.test_case_config[i]; test_case.test) {
                 std::cout << fmt::format("Testing case {}: {}", i, test_case.test_case_name) << std::endl;
                 auto reporter =
                     test_network(test_config.data_root_dir, test_config.report_root_dir, test_config.network, test_case,
-                                 test_config.layer_config, all_tests_passed, test_config.OP_count);
+                                 test_config.layer_config, all_tests_passed, test_config.OP_count,
+                                 result_cache.get(), force_rerun);
                 reporters.emplace(test_case.test_case_name, std::move(reporter));
                 std::cout << fmt::format("Finish test case {}\n", i) << std::endl;
             }
@@ -148,12 +188,23 @@ void test_wrap(const std::string& test_config_file, bool& all_tests_passed) {
 int sc_main(int argc, char** argv) {
     sc_report_handler::set_actions(SC_WARNING, SC_DO_NOTHING);
 
-    if (argc != 2) {
-        std::cerr << "Usage: ./NetworkSimulator <test_config_file>" << std::endl;
+    argparse::ArgumentParser parser("NetworkSimulator");
+    parser.add_argument("test_config").help("test config file");
+    parser.add_argument("-f", "--force")
+        .help("whether to simulate every layer again instead of using cached results")
+        .default_value(false)
+        .implicit_value(true);
+
+    try {
+        parser.parse_args(argc, argv);
+    } catch (const std::runtime_error& err) {
+        std::cerr << err.what() << std::endl;
+        std::cerr << parser;
         return EXIT_FAILURE;
     }
+
     bool all_tests_passed = true;
-    cimsim::test_wrap(argv[1], all_tests_passed);
+    cimsim::test_wrap(parser.get<std::string>("test_config"), parser.get<bool>("force"), all_tests_passed);
     if (all_tests_passed) {
         std::cout << "All Tests Passed!" << std::endl;
     } else {
@@ -48,9 +48,13 @@ struct TestConfig {
     bool compare = false;
     std::vector<CompareConfig> compare_config;
 
+    // reports of layers simulated before are reused from cache_dir, empty means no cache
+    std::string cache_dir;
+    double cache_max_size_MB = 256.0;
+
     NLOHMANN_DEFINE_TYPE_INTRUSIVE_WITH_DEFAULT(TestConfig, data_root_dir, report_root_dir, network, OP_count,
                                                 generate_report, test_case_config, layer_config, compare,
-                                                compare_config);
+                                                compare_config, cache_dir, cache_max_size_MB);
 };
 
 struct CompareResult {
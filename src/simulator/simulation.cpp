@@ -0,0 +1,230 @@
+#include "simulation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+#include "fmt/format.h"
+
+namespace cimsim {
+
+class Simulation::ContextScope {
+public:
+    explicit ContextScope(Simulation& simulation)
+        : scope_(simulation.context_)
+        , previous_sc_context_(sc_core::sc_curr_simcontext)
+        , previous_default_sc_context_(sc_core::sc_default_global_context) {
+        sc_core::sc_curr_simcontext = simulation.sc_context_.get();
+        sc_core::sc_default_global_context = simulation.sc_context_.get();
+    }
+
+    ~ContextScope() {
+        sc_core::sc_curr_simcontext = previous_sc_context_;
+        sc_core::sc_default_global_context = previous_default_sc_context_;
+    }
+
+    ContextScope(const ContextScope&) = delete;
+    ContextScope& operator=(const ContextScope&) = delete;
+
+private:
+    SimContext::Scope scope_;
+    sc_core::sc_simcontext* previous_sc_context_;
+    sc_core::sc_simcontext* previous_default_sc_context_;
+};
+
+Simulation::Simulation(Config config, ProfilerConfig profiler_config,
+                       std::vector<std::vector<Instruction>> core_ins_list)
+    : config_(std::move(config))
+    , profiler_config_(std::move(profiler_config))
+    , core_ins_list_(std::move(core_ins_list))
+    , sc_context_(std::make_unique<sc_core::sc_simcontext>()) {}
+
+Simulation::~Simulation() {
+    // modules are detached from their own kernel context
+    ContextScope scope{*this};
+    chip_.reset();
+    functional_chip_.reset();
+}
+
+void Simulation::addBatchLayer(std::vector<std::vector<Instruction>> core_ins_list) {
+    batch_layer_list_.emplace_back(std::move(core_ins_list));
+}
+
+bool Simulation::run() {
+    if (!config_.checkValid() || !checkBatchValid()) {
+        std::cout << "Invalid config" << std::endl;
+        return false;
+    }
+
+    ContextScope scope{*this};
+    AddressSapce::initialize(config_.chip_config);
+
+    if (config_.sim_config.sim_mode == +SimMode::functional) {
+        std::cout << "Start Functional Simulation" << std::endl;
+        auto start = std::chrono::high_resolution_clock::now();
+        functional_chip_ = std::make_shared<FunctionalChip>(config_, core_ins_list_);
+        functional_chip_->run();
+        auto end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> duration = end - start;
+        exec_time_ = duration.count();
+        std::cout << "Simulation Finish" << std::endl;
+        return true;
+    }
+
+    return runTiming();
+}
+
+bool Simulation::checkBatchValid() const {
+    if (batch_layer_list_.empty()) {
+        return true;
+    }
+    const auto& sim_config = config_.sim_config;
+    if (sim_config.sim_mode != +SimMode::run_one_round || sim_config.fast_forward.enable ||
+        sim_config.checkpoint.isSaveSet() || !sim_config.checkpoint.restore_file.empty() ||
+        !sim_config.activity_trace_file.empty()) {
+        std::cerr << "Batch mode only supports run_one_round mode without fast forward, checkpoint and activity trace"
+                  << std::endl;
+        return false;
+    }
+    if (std::any_of(batch_layer_list_.begin(), batch_layer_list_.end(), [&](const auto& core_ins_list) {
+            return core_ins_list.size() != core_ins_list_.size();
+        })) {
+        std::cerr << "Every layer of batch mode needs instructions of all cores" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool Simulation::runTiming() {
+    const auto& fast_forward = config_.sim_config.fast_forward;
+    ChipArchState arch_state;
+    if (fast_forward.enable) {
+        std::cout << "Fast Forward to Region Start" << std::endl;
+        functional_chip_ = std::make_shared<FunctionalChip>(config_, core_ins_list_);
+        if (!functional_chip_->run(&fast_forward.region_start)) {
+            return false;
+        }
+        if (functional_chip_->getPendingMessageCount() > 0) {
+            std::cerr << "Region start splits send and receive instructions, which timing simulation can not resume"
+                      << std::endl;
+            return false;
+        }
+        functional_chip_->saveArchState(arch_state);
+        std::cout << "Fast Forward finish" << std::endl;
+    }
+
+    std::cout << "Build Chip" << std::endl;
+    chip_ = std::make_shared<Chip>("Chip", config_, profiler_config_, core_ins_list_);
+    if (fast_forward.enable) {
+        chip_->loadArchState(arch_state);
+        if (fast_forward.region_end.isSet()) {
+            chip_->setRegionEndTrigger(&fast_forward.region_end);
+        }
+    }
+    if (const auto& checkpoint_config = config_.sim_config.checkpoint; !checkpoint_config.restore_file.empty()) {
+        std::cout << "Restore Checkpoint" << std::endl;
+        Checkpoint checkpoint;
+        if (!checkpoint.readFromFile(checkpoint_config.restore_file)) {
+            return false;
+        }
+        chip_->restoreCheckpoint(checkpoint);
+    }
+    if (config_.sim_config.checkpoint.isSaveSet()) {
+        chip_->setCheckpointSave(config_.sim_config.checkpoint);
+    }
+    if (!batch_layer_list_.empty()) {
+        chip_->setBatchLayers(std::move(batch_layer_list_));
+    }
+    ActivityTrace activity_trace;
+    const auto& activity_trace_file = config_.sim_config.activity_trace_file;
+    if (!activity_trace_file.empty()) {
+        chip_->startActivityTrace(activity_trace);
+    }
+    std::cout << "Build finish" << std::endl;
+
+    std::cout << "Start Simulation" << std::endl;
+    auto start = std::chrono::high_resolution_clock::now();
+    if (config_.sim_config.sim_mode == +SimMode::run_until_time) {
+        sc_start(config_.sim_config.sim_time_ms, SC_MS);
+    } else {
+        sc_start();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+    exec_time_ = duration.count();
+    std::cout << "Simulation Finish" << std::endl;
+
+    if (config_.sim_config.checkpoint.isSaveSet() && chip_->isCheckpointSplitTransfer()) {
+        std::cerr << "Checkpoint pause point splits send and receive instructions, which can not be saved" << std::endl;
+        return false;
+    }
+
+    if (!activity_trace_file.empty()) {
+        chip_->finishActivityTrace(activity_trace);
+        if (activity_trace.writeToFile(activity_trace_file)) {
+            std::cout << fmt::format("Save activity trace of {} events to '{}'", activity_trace.event_list.size(),
+                                     activity_trace_file)
+                      << std::endl;
+        }
+    }
+
+    if (fast_forward.enable && fast_forward.region_end.isSet()) {
+        std::cout << "Run Functionally after Region End" << std::endl;
+        chip_->saveArchState(arch_state);
+        functional_chip_->loadArchState(arch_state);
+        functional_chip_->run();
+        std::cout << "Functional Run finish" << std::endl;
+    }
+    return true;
+}
+
+Reporter Simulation::report(std::ostream& os, bool report_every_core_energy) {
+    ContextScope scope{*this};
+
+    // functional mode has no timing and energy, only report executed instructions. With fast forward, timing and
+    // energy only cover the region simulated in detail
+    Reporter reporter;
+    if (chip_ != nullptr) {
+        reporter = chip_->report(os, report_every_core_energy);
+    }
+    if (functional_chip_ != nullptr) {
+        functional_chip_->report(os);
+    }
+    reporter.setExecTime(exec_time_);
+    return std::move(reporter);
+}
+
+std::vector<Reporter> Simulation::getLayerReporterList() const {
+    if (chip_ == nullptr) {
+        return {};
+    }
+    return chip_->getLayerReporterList();
+}
+
+void Simulation::saveArchState(ChipArchState& state) {
+    ContextScope scope{*this};
+
+    // functional chip runs last in functional mode, and after the region end of fast forward
+    const auto& fast_forward = config_.sim_config.fast_forward;
+    if (chip_ != nullptr && !(fast_forward.enable && fast_forward.region_end.isSet())) {
+        chip_->saveArchState(state);
+    } else if (functional_chip_ != nullptr) {
+        functional_chip_->saveArchState(state);
+    }
+}
+
+const Config& Simulation::getConfig() const {
+    return config_;
+}
+
+std::optional<Reporter> simulate(const Config& config, const ProfilerConfig& profiler_config,
+                                 const std::vector<std::vector<Instruction>>& core_ins_list) {
+    Simulation simulation{config, profiler_config, core_ins_list};
+    if (!simulation.run()) {
+        return std::nullopt;
+    }
+    std::stringstream ss;
+    return simulation.report(ss);
+}
+
+}  // namespace cimsim
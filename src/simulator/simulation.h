@@ -0,0 +1,69 @@
+#pragma once
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+#include "base_component/sim_context.h"
+#include "chip/chip.h"
+#include "config/config.h"
+#include "functional/functional_chip.h"
+#include "util/reporter.h"
+
+namespace cimsim {
+
+class Simulation {
+    /* In-process simulation of one layer from in-memory config, profiler config and instructions of every core.
+     * Every Simulation owns its SimContext and SystemC kernel context, which are made current while it runs and
+     * reports, so an embedding program can run many simulations one after another in one process.
+     */
+public:
+    Simulation(Config config, ProfilerConfig profiler_config, std::vector<std::vector<Instruction>> core_ins_list);
+    ~Simulation();
+
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+    // batch mode, run instructions of another layer on the same chip after the previous layers, called before run
+    void addBatchLayer(std::vector<std::vector<Instruction>> core_ins_list);
+
+    // false if config is invalid or the run is aborted
+    bool run();
+
+    // exec time of reporter is wall time of run, in batch mode it is the total of all layers
+    Reporter report(std::ostream& os, bool report_every_core_energy = false);
+    // reporter of every layer in batch mode
+    [[nodiscard]] std::vector<Reporter> getLayerReporterList() const;
+    // registers and memory data after run, of the chip that ran last
+    void saveArchState(ChipArchState& state);
+
+    [[nodiscard]] const Config& getConfig() const;
+
+private:
+    class ContextScope;
+
+    [[nodiscard]] bool checkBatchValid() const;
+    bool runTiming();
+
+private:
+    Config config_;
+    ProfilerConfig profiler_config_;
+    std::vector<std::vector<Instruction>> core_ins_list_;
+    std::vector<std::vector<std::vector<Instruction>>> batch_layer_list_{};
+
+    SimContext context_;
+    std::unique_ptr<sc_core::sc_simcontext> sc_context_;
+
+    // destroyed before contexts
+    std::shared_ptr<Chip> chip_;
+    std::shared_ptr<FunctionalChip> functional_chip_;
+
+    double exec_time_{0.0};
+};
+
+// run one simulation and return its report, the text report is dropped. Empty if config is invalid or the run is
+// aborted
+std::optional<Reporter> simulate(const Config& config, const ProfilerConfig& profiler_config,
+                  const std::vector<std::vector<Instruction>>& core_ins_list);
+
+}  // namespace cimsim
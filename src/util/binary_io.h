@@ -0,0 +1,94 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+namespace cimsim {
+
+// plain binary files of checkpoint and activity trace, trivially copyable values are written as raw bytes
+constexpr uint32_t BINARY_SPARSE_BLOCK_BYTE = 64;
+
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::ofstream& ofs) : ofs_(ofs) {}
+
+    template <class T>
+    void write(const T& value) {
+        ofs_.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <class T>
+    void writeVector(const std::vector<T>& data) {
+        write(static_cast<uint32_t>(data.size()));
+        ofs_.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size() * sizeof(T)));
+    }
+
+    // memory data as [size, segment count, (offset, byte vector)...] with all-zero blocks skipped
+    void writeSparseData(const std::vector<uint8_t>& data) {
+        std::vector<std::pair<uint32_t, uint32_t>> segment_list;
+        for (uint32_t offset = 0; offset < data.size(); offset += BINARY_SPARSE_BLOCK_BYTE) {
+            uint32_t end = std::min(offset + BINARY_SPARSE_BLOCK_BYTE, static_cast<uint32_t>(data.size()));
+            if (std::all_of(data.begin() + offset, data.begin() + end, [](uint8_t byte) { return byte == 0; })) {
+                continue;
+            }
+            if (!segment_list.empty() && segment_list.back().second == offset) {
+                segment_list.back().second = end;
+            } else {
+                segment_list.emplace_back(offset, end);
+            }
+        }
+
+        write(static_cast<uint32_t>(data.size()));
+        write(static_cast<uint32_t>(segment_list.size()));
+        for (const auto& [begin, end] : segment_list) {
+            write(begin);
+            write(end - begin);
+            ofs_.write(reinterpret_cast<const char*>(data.data() + begin), end - begin);
+        }
+    }
+
+private:
+    std::ofstream& ofs_;
+};
+
+class BinaryReader {
+public:
+    explicit BinaryReader(std::ifstream& ifs) : ifs_(ifs) {}
+
+    template <class T>
+    T read() {
+        T value{};
+        ifs_.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return value;
+    }
+
+    template <class T>
+    void readVector(std::vector<T>& data) {
+        data.resize(read<uint32_t>());
+        ifs_.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size() * sizeof(T)));
+    }
+
+    void readSparseData(std::vector<uint8_t>& data) {
+        data.assign(read<uint32_t>(), 0);
+        auto segment_cnt = read<uint32_t>();
+        for (uint32_t i = 0; i < segment_cnt && good(); i++) {
+            auto offset = read<uint32_t>();
+            auto size = read<uint32_t>();
+            if (offset + size > data.size()) {
+                ifs_.setstate(std::ios::failbit);
+                return;
+            }
+            ifs_.read(reinterpret_cast<char*>(data.data() + offset), size);
+        }
+    }
+
+    [[nodiscard]] bool good() const {
+        return ifs_.good();
+    }
+
+private:
+    std::ifstream& ifs_;
+};
+
+}  // namespace cimsim
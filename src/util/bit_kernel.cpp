@@ -0,0 +1,160 @@
+#include "bit_kernel.h"
+
+#include <algorithm>
+
+#include "kernel_isa.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define CIMSIM_X86_BIT_KERNEL_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace cimsim {
+
+namespace {
+
+constexpr int WORD_BIT_WIDTH = 64;
+
+// load bit_cnt (<= 64) bits of mask starting at bit_index, bits out of mask range are 0
+unsigned long long loadMaskWord(const std::vector<unsigned char>& mask_byte_data, int bit_index, int bit_cnt) {
+    int byte_index = bit_index / 8;
+    int shift = bit_index % 8;
+    int byte_cnt = std::min(static_cast<int>(mask_byte_data.size()) - byte_index, (shift + bit_cnt + 7) / 8);
+
+    unsigned long long word = 0;
+    unsigned long long extra = 0;
+    for (int i = 0; i < byte_cnt; i++) {
+        auto byte = static_cast<unsigned long long>(mask_byte_data[byte_index + i]);
+        if (i < 8) {
+            word |= byte << (8 * i);
+        } else {
+            extra = byte;
+        }
+    }
+    word >>= shift;
+    if (shift > 0) {
+        word |= extra << (WORD_BIT_WIDTH - shift);
+    }
+    return bit_cnt >= WORD_BIT_WIDTH ? word : word & ((1ULL << bit_cnt) - 1);
+}
+
+int popcountGeneric(unsigned long long value) {
+    int cnt = 0;
+    for (; value != 0; value &= value - 1) {
+        cnt++;
+    }
+    return cnt;
+}
+
+unsigned long long orReduceBytesGeneric(const unsigned char* data, int cnt) {
+    unsigned char result = 0;
+    for (int i = 0; i < cnt; i++) {
+        result |= data[i];
+    }
+    return result;
+}
+
+// iterate set bits of word with count trailing zeros, so zero words cost nothing
+int compressIndexWordGeneric(int base_index, unsigned long long word, int* dst) {
+    int cnt = 0;
+    for (; word != 0; word &= word - 1) {
+        dst[cnt++] = base_index + __builtin_ctzll(word);
+    }
+    return cnt;
+}
+
+#ifdef CIMSIM_X86_BIT_KERNEL_DISPATCH
+__attribute__((target("popcnt"))) int popcountHardware(unsigned long long value) {
+    return __builtin_popcountll(value);
+}
+
+__attribute__((target("avx2"))) unsigned long long orReduceBytesAVX2(const unsigned char* data, int cnt) {
+    __m256i acc = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 32 <= cnt; i += 32) {
+        acc = _mm256_or_si256(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+    }
+    alignas(32) unsigned char lanes[32];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return orReduceBytesGeneric(lanes, 32) | orReduceBytesGeneric(data + i, cnt - i);
+}
+
+__attribute__((target("avx512f,popcnt"))) int compressIndexWordAVX512(int base_index, unsigned long long word,
+                                                                        int* dst) {
+    const __m512i lane_index = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    int cnt = 0;
+    for (int i = 0; i < WORD_BIT_WIDTH && word != 0; i += 16, word >>= 16) {
+        auto lane_mask = static_cast<__mmask16>(word & 0xFFFF);
+        if (lane_mask != 0) {
+            __m512i index = _mm512_add_epi32(lane_index, _mm512_set1_epi32(base_index + i));
+            _mm512_mask_compressstoreu_epi32(dst + cnt, lane_mask, index);
+            cnt += __builtin_popcount(lane_mask);
+        }
+    }
+    return cnt;
+}
+#endif
+
+struct BitKernelTable {
+    int (*popcount)(unsigned long long){popcountGeneric};
+    unsigned long long (*or_reduce_bytes)(const unsigned char*, int){orReduceBytesGeneric};
+    int (*compress_index_word)(int, unsigned long long, int*){compressIndexWordGeneric};
+};
+
+// popcnt comes with avx2, so generic limit keeps the portable popcount
+BitKernelTable createBitKernelTable(KernelIsa limit) {
+    BitKernelTable table{};
+#ifdef CIMSIM_X86_BIT_KERNEL_DISPATCH
+    if (isKernelIsaAllowed(limit, KernelIsa::avx2) && __builtin_cpu_supports("popcnt")) {
+        table.popcount = popcountHardware;
+    }
+    if (isKernelIsaAllowed(limit, KernelIsa::avx2)) {
+        table.or_reduce_bytes = orReduceBytesAVX2;
+    }
+    if (isKernelIsaAllowed(limit, KernelIsa::avx512) && __builtin_cpu_supports("popcnt")) {
+        table.compress_index_word = compressIndexWordAVX512;
+    }
+#endif
+    return table;
+}
+
+const BitKernelTable& getBitKernelTable() {
+    static const BitKernelTable table_list[] = {createBitKernelTable(KernelIsa::generic),
+                                                createBitKernelTable(KernelIsa::avx2),
+                                                createBitKernelTable(KernelIsa::avx512)};
+    return table_list[getKernelIsaLimit()._to_integral()];
+}
+
+}  // namespace
+
+int popcount(unsigned long long value) {
+    return getBitKernelTable().popcount(value);
+}
+
+int countMaskBits(const std::vector<unsigned char>& mask_byte_data, int start_index, int bit_cnt) {
+    const auto& table = getBitKernelTable();
+    int cnt = 0;
+    for (int i = 0; i < bit_cnt; i += WORD_BIT_WIDTH) {
+        cnt += table.popcount(loadMaskWord(mask_byte_data, start_index + i, std::min(WORD_BIT_WIDTH, bit_cnt - i)));
+    }
+    return cnt;
+}
+
+unsigned long long orReduceBytes(const unsigned char* data, int cnt) {
+    return getBitKernelTable().or_reduce_bytes(data, cnt);
+}
+
+void compressIndexByMask(int cnt, const std::vector<unsigned char>& mask_byte_data, int mask_start_index, int max_cnt,
+                         std::vector<int>& dst) {
+    const auto& table = getBitKernelTable();
+    auto dst_begin = static_cast<int>(dst.size());
+    auto dst_size = dst_begin;
+    dst.resize(dst_begin + cnt);
+    for (int i = 0; i < cnt && dst_size - dst_begin < max_cnt; i += WORD_BIT_WIDTH) {
+        auto word = loadMaskWord(mask_byte_data, mask_start_index + i, std::min(WORD_BIT_WIDTH, cnt - i));
+        dst_size += table.compress_index_word(i, word, dst.data() + dst_size);
+    }
+    dst.resize(std::min(dst_size, dst_begin + max_cnt));
+}
+
+}  // namespace cimsim
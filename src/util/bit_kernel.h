@@ -0,0 +1,21 @@
+#pragma once
+#include <vector>
+
+namespace cimsim {
+
+// Word parallel kernels for masks and bit planes, dispatched at runtime to popcnt/avx2/avx512 when cpu supports them
+// and the limit of util/kernel_isa.h allows
+
+// count of set bits in [start_index, start_index + bit_cnt) of mask
+int countMaskBits(const std::vector<unsigned char>& mask_byte_data, int start_index, int bit_cnt);
+
+// bitwise or of the first cnt bytes, the set bits are the non-zero bit planes of these 8-bit values
+unsigned long long orReduceBytes(const unsigned char* data, int cnt);
+
+int popcount(unsigned long long value);
+
+// append i to dst for each set mask bit (mask_start_index + i), i in [0, cnt), at most max_cnt indexes are appended
+void compressIndexByMask(int cnt, const std::vector<unsigned char>& mask_byte_data, int mask_start_index, int max_cnt,
+                         std::vector<int>& dst);
+
+}  // namespace cimsim
@@ -0,0 +1,38 @@
+#include "kernel_isa.h"
+
+#include <atomic>
+
+namespace cimsim {
+
+namespace {
+
+// read by workers of the thread pool while cim computations are in flight
+std::atomic<int> kernel_isa_limit{KernelIsa::avx512};
+
+}  // namespace
+
+bool isKernelIsaSupported(KernelIsa isa) {
+#if defined(__GNUC__) && defined(__x86_64__)
+    switch (isa) {
+        case KernelIsa::avx2: return __builtin_cpu_supports("avx2");
+        case KernelIsa::avx512: return __builtin_cpu_supports("avx512f");
+        default: return true;
+    }
+#else
+    return isa == +KernelIsa::generic;
+#endif
+}
+
+void setKernelIsaLimit(KernelIsa limit) {
+    kernel_isa_limit.store(limit._to_integral(), std::memory_order_relaxed);
+}
+
+KernelIsa getKernelIsaLimit() {
+    return KernelIsa::_from_integral(kernel_isa_limit.load(std::memory_order_relaxed));
+}
+
+bool isKernelIsaAllowed(KernelIsa limit, KernelIsa isa) {
+    return isa._to_integral() <= limit._to_integral() && isKernelIsaSupported(isa);
+}
+
+}  // namespace cimsim
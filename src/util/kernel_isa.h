@@ -0,0 +1,21 @@
+#pragma once
+#include "better-enums/enum.h"
+
+namespace cimsim {
+
+// instruction sets of the kernels dispatched at runtime, in order of vector width
+BETTER_ENUM(KernelIsa, int,  // NOLINT(*-no-recursion, *-explicit-constructor)
+            generic = 0, avx2 = 1, avx512 = 2)
+
+// whether cpu runs kernels of isa, generic kernels run everywhere
+bool isKernelIsaSupported(KernelIsa isa);
+
+// kernels use the widest isa supported by cpu and not wider than the limit, which is avx512 by default, tests lower
+// the limit to compare the kernels of each isa with the generic ones
+void setKernelIsaLimit(KernelIsa limit);
+KernelIsa getKernelIsaLimit();
+
+// whether kernel tables built for limit may use kernels of isa
+bool isKernelIsaAllowed(KernelIsa limit, KernelIsa isa);
+
+}  // namespace cimsim
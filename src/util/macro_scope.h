@@ -52,18 +52,24 @@ namespace cimsim {
 #define TYPE_TO_JSON_FIELD_ASSIGN(...) NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_TO, __VA_ARGS__))
 
 #define DEFINE_ENUM_FROM_TO_JSON_FUNCTION(EnumType, type1, type2, type_other) \
-    void to_json(nlohmann::ordered_json& j, const EnumType& m) {              \
-        j = m._to_string();                                                   \
-    }                                                                         \
-    void from_json(const nlohmann::ordered_json& j, EnumType& m) {            \
-        const auto str = j.get<std::string>();                                \
-        if (str == #type1) {                                                  \
-            m = EnumType::type1;                                              \
-        } else if (str == #type2) {                                           \
-            m = EnumType::type2;                                              \
-        } else {                                                              \
-            m = EnumType::type_other;                                         \
-        }                                                                     \
+    DEFINE_ENUM_FROM_TO_JSON_FUNCTION_WITH_OTHER(EnumType, type_other, type1, type2)
+
+// every listed value is read from its name, any other name is read as type_other
+#define DEFINE_ENUM_FROM_TO_JSON_FUNCTION_WITH_OTHER(EnumType, type_other, ...) \
+    void to_json(nlohmann::ordered_json& j, const EnumType& m) {                \
+        j = m._to_string();                                                     \
+    }                                                                           \
+    void from_json(const nlohmann::ordered_json& j, EnumType& m) {              \
+        using enum_type = EnumType;                                             \
+        const auto str = j.get<std::string>();                                  \
+        CIM_PASTE(ENUM_FROM_JSON_MATCH_VALUE, DELIMITER_SPACE, __VA_ARGS__)     \
+        m = EnumType::type_other;                                               \
+    }
+
+#define ENUM_FROM_JSON_MATCH_VALUE(value) \
+    if (str == #value) {                  \
+        m = enum_type::value;             \
+        return;                           \
     }
 
 #define JSON_VALUE_ENUM(t, field, key)                 \
@@ -0,0 +1,171 @@
+#include "result_cache.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "fmt/format.h"
+
+namespace cimsim {
+
+namespace {
+
+// bump when the report json changes, so entries of older simulators are never hit
+constexpr uint64_t RESULT_CACHE_VERSION = 1;
+
+// FNV-1a, stable across builds and platforms unlike std::hash
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+uint64_t hashBytes(const char* data, std::size_t size, uint64_t hash) {
+    for (std::size_t i = 0; i < size; i++) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+uint64_t hashString(const std::string& str, uint64_t hash) {
+    // length first, so adjacent fields can not shift into each other
+    uint64_t size = str.size();
+    hash = hashBytes(reinterpret_cast<const char*>(&size), sizeof(size), hash);
+    return hashBytes(str.data(), str.size(), hash);
+}
+
+bool readFileContent(const std::string& file, std::string& content) {
+    std::ifstream ifs(file, std::ios::in | std::ios::binary);
+    if (!ifs.is_open()) {
+        return false;
+    }
+    content.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// image files of memories in config json, wherever the memory config is
+void collectImageFiles(const nlohmann::ordered_json& j, std::vector<std::string>& file_list) {
+    if (j.is_object()) {
+        if (j.value("has_image", false) && j.contains("image_file")) {
+            file_list.push_back(j["image_file"].get<std::string>());
+        }
+        for (const auto& [key, value] : j.items()) {
+            collectImageFiles(value, file_list);
+        }
+    } else if (j.is_array()) {
+        for (const auto& value : j) {
+            collectImageFiles(value, file_list);
+        }
+    }
+}
+
+}  // namespace
+
+ResultCache::ResultCache(std::string cache_dir, double max_size_MB, const std::string& simulator_file)
+    : cache_dir_(std::move(cache_dir)), max_size_byte_(static_cast<uintmax_t>(max_size_MB * 1024 * 1024)) {
+    std::filesystem::create_directories(cache_dir_);
+
+    std::string simulator_content;
+    if (!readFileContent(simulator_file, simulator_content)) {
+        std::cerr << fmt::format("Result cache can not read simulator '{}', cache is disabled", simulator_file)
+                  << std::endl;
+        enabled_ = false;
+        return;
+    }
+    build_id_ = hashString(simulator_content, hashBytes(reinterpret_cast<const char*>(&RESULT_CACHE_VERSION),
+                                                        sizeof(RESULT_CACHE_VERSION), FNV_OFFSET_BASIS));
+}
+
+std::string ResultCache::getKey(const Config& config, const ProfilerConfig& profiler_config,
+                                const std::string& inst_file) const {
+    if (!enabled_) {
+        return "";
+    }
+
+    nlohmann::ordered_json config_json = config;
+    std::vector<std::string> input_file_list{inst_file};
+    collectImageFiles(config_json, input_file_list);
+    if (const auto& network_config = config.chip_config.network_config;
+        network_config.model == +NetworkModel::table && !network_config.network_config_file_path.empty()) {
+        input_file_list.push_back(network_config.network_config_file_path);
+    }
+    if (const auto& restore_file = config.sim_config.checkpoint.restore_file; !restore_file.empty()) {
+        input_file_list.push_back(restore_file);
+    }
+
+    nlohmann::ordered_json profiler_config_json = profiler_config;
+    uint64_t hash = hashString(config_json.dump(), build_id_);
+    hash = hashString(profiler_config_json.dump(), hash);
+    for (const auto& input_file : input_file_list) {
+        std::string content;
+        if (!readFileContent(input_file, content)) {
+            return "";
+        }
+        hash = hashString(content, hash);
+    }
+    return fmt::format("{:016x}", hash);
+}
+
+bool ResultCache::load(const std::string& key, const std::string& report_file) const {
+    auto entry_file = getEntryFile(key);
+    std::error_code ec;
+    if (key.empty() || !std::filesystem::is_regular_file(entry_file, ec)) {
+        return false;
+    }
+    if (!std::filesystem::copy_file(entry_file, report_file, std::filesystem::copy_options::overwrite_existing, ec)) {
+        return false;
+    }
+    // mark as recently used
+    std::filesystem::last_write_time(entry_file, std::filesystem::file_time_type::clock::now(), ec);
+    return true;
+}
+
+void ResultCache::store(const std::string& key, const std::string& report_file) const {
+    if (key.empty()) {
+        return;
+    }
+    // copy then rename, a concurrent reader never sees a partial entry
+    auto entry_file = getEntryFile(key);
+    auto temp_file = fmt::format("{}.tmp", entry_file);
+    std::error_code ec;
+    if (!std::filesystem::copy_file(report_file, temp_file, std::filesystem::copy_options::overwrite_existing, ec)) {
+        return;
+    }
+    std::filesystem::rename(temp_file, entry_file, ec);
+    evict();
+}
+
+std::string ResultCache::getEntryFile(const std::string& key) const {
+    return fmt::format("{}/{}.json", cache_dir_, key);
+}
+
+void ResultCache::evict() const {
+    std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> entry_list;
+    uintmax_t total_size_byte = 0;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(cache_dir_, ec)) {
+        if (!entry.is_regular_file(ec) || entry.path().extension() != ".json") {
+            continue;
+        }
+        total_size_byte += entry.file_size(ec);
+        entry_list.emplace_back(entry.last_write_time(ec), entry.path());
+    }
+    if (total_size_byte <= max_size_byte_) {
+        return;
+    }
+
+    std::sort(entry_list.begin(), entry_list.end());
+    for (const auto& [time, path] : entry_list) {
+        if (total_size_byte <= max_size_byte_) {
+            break;
+        }
+        auto size_byte = std::filesystem::file_size(path, ec);
+        if (std::filesystem::remove(path, ec)) {
+            total_size_byte -= size_byte;
+        }
+    }
+}
+
+}  // namespace cimsim
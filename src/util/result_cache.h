@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include "config/config.h"
+
+namespace cimsim {
+
+class ResultCache {
+    /* Content-addressed cache of layer simulation reports on local disk.
+     * The key hashes the simulator binary as build id, the canonical json of Config and ProfilerConfig, which fills
+     * defaults and fixes field order, the instruction file contents, and the contents of input files referenced by
+     * Config: memory images, network table and checkpoint to restore. The cache is disabled if the simulator binary
+     * can not be read, since results of different builds could not be told apart.
+     * Every entry is one report json file, entries are evicted in least recently used order beyond max size.
+     */
+public:
+    ResultCache(std::string cache_dir, double max_size_MB, const std::string& simulator_file);
+
+    // empty key if the cache is disabled or an input file can not be read
+    [[nodiscard]] std::string getKey(const Config& config, const ProfilerConfig& profiler_config,
+                                     const std::string& inst_file) const;
+
+    // copy cached report of key to report_file, false if missed
+    bool load(const std::string& key, const std::string& report_file) const;
+    void store(const std::string& key, const std::string& report_file) const;
+
+private:
+    [[nodiscard]] std::string getEntryFile(const std::string& key) const;
+    void evict() const;
+
+private:
+    std::string cache_dir_;
+    uintmax_t max_size_byte_;
+    uint64_t build_id_{0};
+    bool enabled_{true};
+};
+
+}  // namespace cimsim
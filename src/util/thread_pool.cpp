@@ -0,0 +1,50 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+namespace cimsim {
+
+ThreadPool::ThreadPool(int worker_cnt) {
+    for (int i = 0; i < worker_cnt; i++) {
+        worker_list_.emplace_back([this]() { runWorker(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stop_ = true;
+    }
+    task_available_.notify_all();
+    for (auto& worker : worker_list_) {
+        worker.join();
+    }
+}
+
+int ThreadPool::getWorkerCount() const {
+    return static_cast<int>(worker_list_.size());
+}
+
+ThreadPool& ThreadPool::getShared() {
+    static ThreadPool pool{std::max(1, static_cast<int>(std::thread::hardware_concurrency()))};
+    return pool;
+}
+
+void ThreadPool::runWorker() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock{mutex_};
+            task_available_.wait(lock, [this]() { return stop_ || !task_queue_.empty(); });
+            // remaining tasks are finished before stop, so no future is left without a value
+            if (task_queue_.empty()) {
+                return;
+            }
+            task = std::move(task_queue_.front());
+            task_queue_.pop();
+        }
+        task();
+    }
+}
+
+}  // namespace cimsim
@@ -0,0 +1,54 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cimsim {
+
+class ThreadPool {
+    /* Fixed workers running submitted tasks in submission order, which takes pure computation of real data mode off
+     * the simulation thread. Tasks must not touch simulation state, the caller syncs through the returned future.
+     */
+public:
+    explicit ThreadPool(int worker_cnt);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    template <class Func>
+    std::future<std::invoke_result_t<Func>> submit(Func&& func) {
+        auto task = std::make_shared<std::packaged_task<std::invoke_result_t<Func>()>>(std::forward<Func>(func));
+        auto future = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            task_queue_.emplace([task]() { (*task)(); });
+        }
+        task_available_.notify_one();
+        return future;
+    }
+
+    [[nodiscard]] int getWorkerCount() const;
+
+    // shared by all simulations of the process, one worker per hardware thread
+    static ThreadPool& getShared();
+
+private:
+    void runWorker();
+
+private:
+    std::vector<std::thread> worker_list_;
+
+    std::mutex mutex_;
+    std::condition_variable task_available_;
+    std::queue<std::function<void()>> task_queue_;
+    bool stop_{false};
+};
+
+}  // namespace cimsim
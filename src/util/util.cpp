@@ -39,6 +39,37 @@ std::vector<unsigned char> IntToBytes(int value, bool little_endian) {
     return std::move(bytes);
 }
 
+unsigned long long getBitField(const std::vector<unsigned char>& data, long long bit_offset, int bit_width) {
+    unsigned long long value = 0;
+    int bit = 0;
+    while (bit < bit_width) {
+        long long byte_index = (bit_offset + bit) / BYTE_TO_BIT;
+        int bit_in_byte = static_cast<int>((bit_offset + bit) % BYTE_TO_BIT);
+        int len = std::min(BYTE_TO_BIT - bit_in_byte, bit_width - bit);
+        if (byte_index < data.size()) {
+            unsigned long long field = (data[byte_index] >> bit_in_byte) & ((1U << len) - 1);
+            value |= field << bit;
+        }
+        bit += len;
+    }
+    return value;
+}
+
+void setBitField(std::vector<unsigned char>& data, long long bit_offset, int bit_width, unsigned long long value) {
+    int bit = 0;
+    while (bit < bit_width) {
+        long long byte_index = (bit_offset + bit) / BYTE_TO_BIT;
+        int bit_in_byte = static_cast<int>((bit_offset + bit) % BYTE_TO_BIT);
+        int len = std::min(BYTE_TO_BIT - bit_in_byte, bit_width - bit);
+        if (byte_index < data.size()) {
+            unsigned int mask = ((1U << len) - 1) << bit_in_byte;
+            unsigned int field = static_cast<unsigned int>((value >> bit) & ((1U << len) - 1)) << bit_in_byte;
+            data[byte_index] = static_cast<unsigned char>((data[byte_index] & ~mask) | field);
+        }
+        bit += len;
+    }
+}
+
 bool check_text_file_same(const std::string& file1, const std::string& file2) {
     if (std::ifstream in1(file1), in2(file2); in1 && in2) {
         std::string line1, line2;
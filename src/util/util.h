@@ -40,6 +40,19 @@ int BytesToInt(const std::vector<unsigned char>& bytes, bool little_endian);
 
 std::vector<unsigned char> IntToBytes(int value, bool little_endian);
 
+// bit field of data, bit 0 is the lowest bit of byte 0, bit_width is at most 64
+unsigned long long getBitField(const std::vector<unsigned char>& data, long long bit_offset, int bit_width);
+void setBitField(std::vector<unsigned char>& data, long long bit_offset, int bit_width, unsigned long long value);
+
+inline long long signExtend(unsigned long long value, int bit_width) {
+    if (bit_width >= 64) {
+        return static_cast<long long>(value);
+    }
+    unsigned long long sign_bit = 1ULL << (bit_width - 1);
+    value &= (sign_bit << 1) - 1;
+    return static_cast<long long>((value ^ sign_bit) - sign_bit);
+}
+
 bool check_text_file_same(const std::string& file1, const std::string& file2);
 
 template <class Type>
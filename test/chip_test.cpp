@@ -9,6 +9,7 @@
 #include "chip/chip.h"
 #include "config/config.h"
 #include "fmt/format.h"
+#include "functional/functional_chip.h"
 #include "systemc.h"
 #include "util/util.h"
 
@@ -50,6 +51,14 @@ int sc_main(int argc, char* argv[]) {
     AddressSapce::initialize(config.chip_config);
 
     auto test_info = readTypeFromJsonFile<ChipTestInfo>(instruction_file);
+    if (config.sim_config.sim_mode == +SimMode::functional) {
+        // no timing and energy in functional mode, only check that every core finishes
+        FunctionalChip functional_chip{config, test_info.code};
+        bool pass = functional_chip.run();
+        std::cout << (pass ? "Test Pass" : "Test Failed") << std::endl;
+        return pass ? TEST_PASSED : TEST_FAILED;
+    }
+
     Chip chip{"Chip", config, profiler_config, test_info.code};
     sc_start();
 
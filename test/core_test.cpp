@@ -9,6 +9,7 @@
 #include "config/config.h"
 #include "core/core.h"
 #include "fmt/format.h"
+#include "functional/functional_chip.h"
 #include "systemc.h"
 #include "util/util.h"
 
@@ -54,6 +55,20 @@ int sc_main(int argc, char* argv[]) {
 
     auto test_info = readTypeFromJsonFile<CoreTestInfo>(instruction_file);
     std::vector<std::vector<Instruction>> chip_code{test_info.code};
+    if (config.sim_config.sim_mode == +SimMode::functional) {
+        // no timing and energy in functional mode, only check registers
+        FunctionalChip functional_chip{config, chip_code};
+        if (functional_chip.run() &&
+            (!test_info.reg_info.check ||
+             functional_chip.checkRegValues(0, test_info.reg_info.general_reg_expected_values,
+                                            test_info.reg_info.special_reg_expected_values))) {
+            std::cout << "Test Pass" << std::endl;
+            return TEST_PASSED;
+        }
+        std::cout << "Test Failed" << std::endl;
+        return TEST_FAILED;
+    }
+
     Chip chip{"Chip", config, profiler_config, chip_code};
     sc_start();
 
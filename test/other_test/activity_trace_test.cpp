@@ -0,0 +1,83 @@
+#include <fstream>
+#include <vector>
+
+#include "../base/test_macro.h"
+#include "address_space/address_space.h"
+#include "base_component/activity_trace.h"
+#include "chip/chip.h"
+#include "config/config.h"
+#include "fmt/format.h"
+#include "simulator/simulation.h"
+#include "systemc.h"
+#include "util/macro_scope.h"
+#include "util/util.h"
+
+namespace cimsim {
+
+struct ActivityTraceTestInfo {
+    std::string comments{};
+    std::vector<std::vector<Instruction>> code{};
+};
+
+DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(ActivityTraceTestInfo, comments, code)
+
+}  // namespace cimsim
+
+using namespace cimsim;
+
+int sc_main(int argc, char* argv[]) {
+    sc_core::sc_report_handler::set_actions(sc_core::SC_WARNING, sc_core::SC_DO_NOTHING);
+
+    std::string exec_file_name{argv[0]};
+    if (argc != 4) {
+        std::cout << fmt::format("Usage: {} [config_file] [instruction_file] [report_file]", exec_file_name)
+                  << std::endl;
+        return INVALID_USAGE;
+    }
+
+    auto* config_file = argv[1];
+    auto* instruction_file = argv[2];
+    auto* report_file = argv[3];
+
+    auto config = readTypeFromJsonFile<Config>(config_file);
+    if (!config.checkValid()) {
+        std::cout << "Config not valid" << std::endl;
+        return INVALID_CONFIG;
+    }
+    auto test_info = readTypeFromJsonFile<ActivityTraceTestInfo>(instruction_file);
+
+    // record the trace of a timing simulation next to the report
+    auto trace_config = config;
+    trace_config.sim_config.activity_trace_file = fmt::format("{}.trace", report_file);
+    ProfilerConfig profiler_config;
+    Simulation simulation{trace_config, profiler_config, test_info.code};
+    if (!simulation.run()) {
+        std::cout << "Test Failed" << std::endl;
+        return TEST_FAILED;
+    }
+    std::ofstream ofs;
+    ofs.open(report_file);
+    auto reporter = simulation.report(ofs);
+
+    // re-cost the trace on a chip elaborated with the same config, as EnergyRecost does
+    ActivityTrace activity_trace;
+    if (!activity_trace.readFromFile(trace_config.sim_config.activity_trace_file)) {
+        std::cout << "Test Failed" << std::endl;
+        return TEST_FAILED;
+    }
+    AddressSapce::initialize(config.chip_config);
+    std::vector<std::vector<Instruction>> core_ins_list(config.chip_config.core_cnt);
+    Chip chip{"Chip", config, profiler_config, core_ins_list};
+    if (!chip.replayActivityTrace(activity_trace)) {
+        std::cout << "Test Failed" << std::endl;
+        return TEST_FAILED;
+    }
+    auto recost_reporter = chip.report(ofs, false);
+    ofs.close();
+
+    // replay adds the recorded energy of every counter in recorded order, so the energy is reproduced exactly
+    bool pass = recost_reporter.getLatencyNs() == reporter.getLatencyNs() &&
+                recost_reporter.getTotalEnergyPJ() == reporter.getTotalEnergyPJ();
+    std::cout << (pass ? "Test Pass" : "Test Failed") << std::endl;
+    return pass ? TEST_PASSED : TEST_FAILED;
+}
@@ -0,0 +1,132 @@
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include "../base/test_macro.h"
+#include "address_space/address_space.h"
+#include "config/config.h"
+#include "fmt/format.h"
+#include "memory/memory_unit.h"
+#include "systemc.h"
+#include "util/macro_scope.h"
+#include "util/util.h"
+
+namespace cimsim {
+
+struct DRAMTestAccess {
+    int port{0};  // accesses of one port are issued one after another, ports issue in parallel
+    double time_ns{0.0};
+    bool write{false};
+    int address_byte{0};  // global address
+    int size_byte{0};
+    double expected_latency_ns{0.0};
+};
+
+struct DRAMTestInfo {
+    std::vector<DRAMTestAccess> access_list{};
+};
+
+DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(DRAMTestAccess, port, time_ns, write, address_byte, size_byte,
+                                               expected_latency_ns)
+DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(DRAMTestInfo, access_list)
+
+class DRAMTestPort : public sc_core::sc_module {
+public:
+    SC_HAS_PROCESS(DRAMTestPort);
+
+    DRAMTestPort(const sc_core::sc_module_name& name, MemoryUnit& memory_unit,
+                 std::vector<DRAMTestAccess*> access_list)
+        : sc_core::sc_module(name), memory_unit_(memory_unit), access_list_(std::move(access_list)) {
+        SC_THREAD(process)
+    }
+
+    [[nodiscard]] const std::vector<double>& getLatencyList() const {
+        return latency_list_;
+    }
+
+private:
+    void process() {
+        for (const auto* access : access_list_) {
+            wait(sc_time{access->time_ns, SC_NS} - sc_time_stamp());
+            auto start_time = sc_time_stamp();
+            auto payload = std::make_shared<MemoryAccessPayload>(
+                MemoryAccessPayload{.ins = {.pc = 1, .ins_id = 1},
+                                    .access_type = access->write ? MemoryAccessType::write : MemoryAccessType::read,
+                                    .address_byte = access->address_byte,
+                                    .size_byte = access->size_byte,
+                                    .data = std::vector<uint8_t>(access->write ? access->size_byte : 0, 0)});
+            memory_unit_.access(payload);
+            latency_list_.push_back((sc_time_stamp() - start_time).to_seconds() * 1e9);
+        }
+    }
+
+private:
+    MemoryUnit& memory_unit_;
+    std::vector<DRAMTestAccess*> access_list_;
+    std::vector<double> latency_list_{};
+};
+
+}  // namespace cimsim
+
+using namespace cimsim;
+
+int sc_main(int argc, char* argv[]) {
+    sc_core::sc_report_handler::set_actions(sc_core::SC_WARNING, sc_core::SC_DO_NOTHING);
+
+    std::string exec_file_name{argv[0]};
+    if (argc != 4) {
+        std::cout << fmt::format("Usage: {} [config_file] [instruction_file] [report_file]", exec_file_name)
+                  << std::endl;
+        return INVALID_USAGE;
+    }
+
+    auto* config_file = argv[1];
+    auto* instruction_file = argv[2];
+    auto* report_file = argv[3];
+
+    auto config = readTypeFromJsonFile<Config>(config_file);
+    if (!config.checkValid()) {
+        std::cout << "Config not valid" << std::endl;
+        return INVALID_CONFIG;
+    }
+    AddressSapce::initialize(config.chip_config);
+
+    // global memory of config is the dram under test
+    const auto& global_memory_config = config.chip_config.global_memory_config;
+    MemoryUnit memory_unit{"GlobalMemoryUnit", global_memory_config.global_memory_unit_config,
+                           BaseInfo{config.sim_config, global_memory_config.global_memory_switch_id}, true};
+
+    auto test_info = readTypeFromJsonFile<DRAMTestInfo>(instruction_file);
+    std::vector<std::vector<DRAMTestAccess*>> port_access_list;
+    for (auto& access : test_info.access_list) {
+        if (access.port >= port_access_list.size()) {
+            port_access_list.resize(access.port + 1);
+        }
+        port_access_list[access.port].push_back(&access);
+    }
+    std::vector<std::shared_ptr<DRAMTestPort>> port_list;
+    for (int port = 0; port < port_access_list.size(); port++) {
+        port_list.push_back(std::make_shared<DRAMTestPort>(fmt::format("Port_{}", port).c_str(), memory_unit,
+                                                           port_access_list[port]));
+    }
+    sc_start();
+
+    std::ofstream ofs;
+    ofs.open(report_file);
+    bool pass = true;
+    for (int port = 0; port < port_list.size(); port++) {
+        const auto& latency_list = port_list[port]->getLatencyList();
+        for (int i = 0; i < port_access_list[port].size(); i++) {
+            const auto& access = *port_access_list[port][i];
+            double latency_ns = i < latency_list.size() ? latency_list[i] : -1.0;
+            ofs << fmt::format("port {}, time: {} ns, address: {}, size: {}, latency: {} ns, expected: {} ns\n", port,
+                               access.time_ns, access.address_byte, access.size_byte, latency_ns,
+                               access.expected_latency_ns);
+            pass = pass && DoubleEqual(latency_ns, access.expected_latency_ns);
+        }
+    }
+    ofs.close();
+
+    std::cout << (pass ? "Test Pass" : "Test Failed") << std::endl;
+    return pass ? TEST_PASSED : TEST_FAILED;
+}
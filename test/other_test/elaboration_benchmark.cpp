@@ -0,0 +1,85 @@
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unistd.h>
+
+#include "address_space/address_space.h"
+#include "chip/chip.h"
+#include "fmt/format.h"
+#include "systemc.h"
+#include "util/util.h"
+
+namespace cimsim {
+
+struct ProcessCount {
+    int thread_cnt{0};
+    int method_cnt{0};
+};
+
+void countProcess(const std::vector<sc_object*>& object_list, ProcessCount& count) {
+    for (const auto* object : object_list) {
+        if (std::strcmp(object->kind(), "sc_thread_process") == 0 ||
+            std::strcmp(object->kind(), "sc_cthread_process") == 0) {
+            count.thread_cnt++;
+        } else if (std::strcmp(object->kind(), "sc_method_process") == 0) {
+            count.method_cnt++;
+        }
+        countProcess(object->get_child_objects(), count);
+    }
+}
+
+// virtual and resident memory of this process in MB
+std::pair<double, double> getMemoryMB() {
+    std::ifstream ifs("/proc/self/statm");
+    long long size_page = 0, resident_page = 0;
+    ifs >> size_page >> resident_page;
+    double page_MB = static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024 * 1024);
+    return {size_page * page_MB, resident_page * page_MB};
+}
+
+}  // namespace cimsim
+
+// elaborate a chip without instructions, thread stacks are allocated at the initialization phase of sc_start, run
+// with configs of different core cnt and thread stack size to get memory and elaboration time versus core cnt
+int sc_main(int argc, char* argv[]) {
+    using namespace cimsim;
+
+    if (argc < 3) {
+        std::cout << "Usage: ElaborationBenchmark <config file> <profiler config file>" << std::endl;
+        return 1;
+    }
+    auto config = readTypeFromJsonFile<Config>(argv[1]);
+    auto profiler_config = readTypeFromJsonFile<ProfilerConfig>(argv[2]);
+    if (!config.checkValid()) {
+        std::cout << "Invalid config" << std::endl;
+        return 1;
+    }
+
+    auto [start_virtual_MB, start_resident_MB] = getMemoryMB();
+    auto start = std::chrono::steady_clock::now();
+
+    AddressSapce::initialize(config.chip_config);
+    std::vector<std::vector<Instruction>> core_ins_list(config.chip_config.core_cnt);
+    Chip chip{"Chip", config, profiler_config, core_ins_list};
+    auto build_end = std::chrono::steady_clock::now();
+    sc_start(SC_ZERO_TIME);
+    auto end = std::chrono::steady_clock::now();
+
+    auto [end_virtual_MB, end_resident_MB] = getMemoryMB();
+    ProcessCount count;
+    countProcess(sc_get_top_level_objects(), count);
+
+    std::cout << fmt::format("core cnt: {}, thread stack size: {} KB", config.chip_config.core_cnt,
+                             config.sim_config.thread_stack_size_KB)
+              << std::endl;
+    std::cout << fmt::format("processes: {} threads, {} methods", count.thread_cnt, count.method_cnt) << std::endl;
+    std::cout << fmt::format("build: {:.3f} s, elaboration and initialization: {:.3f} s",
+                             std::chrono::duration<double>(build_end - start).count(),
+                             std::chrono::duration<double>(end - start).count())
+              << std::endl;
+    std::cout << fmt::format("memory: {:.1f} MB virtual, {:.1f} MB resident", end_virtual_MB - start_virtual_MB,
+                             end_resident_MB - start_resident_MB)
+              << std::endl;
+    return 0;
+}
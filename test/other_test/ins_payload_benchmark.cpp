@@ -0,0 +1,66 @@
+#include <chrono>
+#include <iostream>
+
+#include "core/execute_unit/ins_payload_pool.h"
+#include "fmt/format.h"
+#include "systemc.h"
+
+namespace cimsim {
+
+constexpr int INS_CNT = 1000000;
+// payloads held at the same time by id-ex signal, fsm and execute unit thread
+constexpr int IN_FLIGHT_CNT = 4;
+
+SIMDInsPayload makeSIMDInsPayload(int ins_id) {
+    SIMDInsPayload p;
+    p.ins.ins_id = ins_id;
+    p.ins.unit_type = ExecuteUnitType::simd;
+    p.inputs_address_byte = {ins_id, ins_id + 1, 0, 0};
+    p.output_address_byte = ins_id + 2;
+    p.len = 64;
+    return p;
+}
+
+// decode -> issue through id-ex signal -> execute unit gets typed payload, return ns per instruction
+template <class CreateFunc, class CastFunc>
+double measureDecodeToIssue(CreateFunc create_func, CastFunc cast_func) {
+    std::vector<ExecuteUnitPayload> in_flight(IN_FLIGHT_CNT);
+    long long checksum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < INS_CNT; i++) {
+        std::shared_ptr<ExecuteInsPayload> payload = create_func(makeSIMDInsPayload(i));
+        in_flight[i % IN_FLIGHT_CNT] = ExecuteUnitPayload{.payload = payload};
+        auto simd_payload = cast_func(in_flight[i % IN_FLIGHT_CNT].payload);
+        checksum += simd_payload->output_address_byte;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    if (checksum == 0) {
+        std::cout << "unexpected checksum" << std::endl;
+    }
+    return std::chrono::duration<double, std::nano>(end - start).count() / INS_CNT;
+}
+
+}  // namespace cimsim
+
+int sc_main(int argc, char* argv[]) {
+    using namespace cimsim;
+
+    double make_shared_ns = measureDecodeToIssue(
+        [](const SIMDInsPayload& p) { return std::make_shared<SIMDInsPayload>(p); },
+        [](const std::shared_ptr<ExecuteInsPayload>& p) { return std::dynamic_pointer_cast<SIMDInsPayload>(p); });
+
+    InsPayloadPool pool;
+    double pool_ns = measureDecodeToIssue([&pool](const SIMDInsPayload& p) { return pool.create(p); },
+                                          [](const std::shared_ptr<ExecuteInsPayload>& p) {
+                                              return castInsPayload<SIMDInsPayload>(p);
+                                          });
+
+    std::cout << fmt::format("decode to issue, make_shared + dynamic_pointer_cast: {:.2f} ns/ins", make_shared_ns)
+              << std::endl;
+    std::cout << fmt::format("decode to issue, payload pool + tagged cast: {:.2f} ns/ins, {} slots", pool_ns,
+                             pool.getSlotCount<SIMDInsPayload>())
+              << std::endl;
+    return 0;
+}
@@ -0,0 +1,275 @@
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include "../base/test_macro.h"
+#include "config/config.h"
+#include "core/cim_unit/cim_compute_engine.h"
+#include "core/execute_unit/functional_kernel.h"
+#include "fmt/format.h"
+#include "systemc.h"
+#include "util/bit_kernel.h"
+#include "util/kernel_isa.h"
+#include "util/macro_scope.h"
+#include "util/util.h"
+
+namespace cimsim {
+
+struct KernelTestInfo {
+    unsigned int seed{0};
+    std::vector<int> len_list{};  // element cnt of simd and reduce kernels, bit cnt of bit kernels
+    std::vector<CimMacroSizeConfig> macro_size_list{};
+    std::vector<unsigned long long> max_input_list{};  // large inputs take the 64-bit accumulation of cim
+};
+
+DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(KernelTestInfo, seed, len_list, macro_size_list, max_input_list)
+
+// every kernel isa supported by cpu is compared with plain scalar loops on the same random data
+class KernelTester {
+public:
+    KernelTester(const CimUnitConfig& cim_unit_config, const KernelTestInfo& test_info, std::ofstream& ofs)
+        : cim_unit_config_(cim_unit_config), test_info_(test_info), ofs_(ofs) {}
+
+    bool run(KernelIsa isa) {
+        rng_.seed(test_info_.seed);
+        isa_ = isa;
+        bool pass = true;
+        for (int len : test_info_.len_list) {
+            pass = checkSIMDKernel(len) && pass;
+            pass = checkReduceKernel(len) && pass;
+            pass = checkBitKernel(len) && pass;
+        }
+        for (const auto& macro_size : test_info_.macro_size_list) {
+            pass = checkMultiplyAccumulateKernel(macro_size) && pass;
+        }
+        return pass;
+    }
+
+private:
+    std::vector<uint8_t> randomBytes(int size) {
+        std::vector<uint8_t> data(size);
+        for (auto& byte : data) {
+            byte = static_cast<uint8_t>(rng_());
+        }
+        return data;
+    }
+
+    bool report(bool pass, const std::string& case_name) {
+        if (!pass) {
+            ofs_ << fmt::format("isa {}, {} not match scalar reference\n", isa_._to_string(), case_name);
+        }
+        return pass;
+    }
+
+    bool checkSIMDKernel(int len) {
+        bool pass = true;
+        for (int bit_width : {8, 16, 32}) {
+            for (unsigned int opcode : {0x00U, 0x02U}) {
+                auto a = randomBytes(len * bit_width / BYTE_TO_BIT);
+                auto b = randomBytes(len * bit_width / BYTE_TO_BIT);
+                std::vector<uint8_t> output(a.size(), 0);
+                std::vector<uint8_t> expected(a.size(), 0);
+                std::vector<KernelOperand> inputs{{.data = a.data(), .bit_width = bit_width},
+                                                  {.data = b.data(), .bit_width = bit_width}};
+                runSIMDKernel(opcode, inputs, output.data(), bit_width, len);
+                for (int i = 0; i < len; i++) {
+                    long long x = loadElement(a.data(), bit_width, i);
+                    long long y = loadElement(b.data(), bit_width, i);
+                    storeElement(expected.data(), bit_width, i, opcode == 0x02U ? x * y : x + y);
+                }
+                pass = report(output == expected,
+                              fmt::format("simd opcode {}, bit width {}, len {}", opcode, bit_width, len)) &&
+                       pass;
+            }
+        }
+        return pass;
+    }
+
+    bool checkReduceKernel(int len) {
+        bool pass = true;
+        for (int bit_width : {8, 16, 32}) {
+            for (unsigned int funct : {0U, 1U, 2U}) {
+                auto input = randomBytes(len * bit_width / BYTE_TO_BIT);
+                std::vector<uint8_t> output(sizeof(long long), 0);
+                runReduceKernel(funct, {.data = input.data(), .bit_width = bit_width}, len, output.data(), 64, 0);
+
+                long long expected = len > 0 && funct != 0 ? loadElement(input.data(), bit_width, 0) : 0;
+                for (int i = (funct == 0 ? 0 : 1); i < len; i++) {
+                    long long x = loadElement(input.data(), bit_width, i);
+                    if (funct == 0) {
+                        expected += x;
+                    } else {
+                        expected = funct == 1 ? std::max(expected, x) : std::min(expected, x);
+                    }
+                }
+                pass = report(loadElement(output.data(), 64, 0) == expected,
+                              fmt::format("reduce funct {}, bit width {}, len {}", funct, bit_width, len)) &&
+                       pass;
+            }
+        }
+        return pass;
+    }
+
+    bool checkBitKernel(int len) {
+        bool pass = true;
+        int start_index = static_cast<int>(rng_() % 64);
+        auto mask = randomBytes(IntDivCeil(start_index + len + 1, BYTE_TO_BIT));
+
+        int expected_cnt = 0;
+        for (int i = 0; i < len; i++) {
+            expected_cnt += getMaskBit(mask, start_index + i) != 0 ? 1 : 0;
+        }
+        pass = report(countMaskBits(mask, start_index, len) == expected_cnt,
+                      fmt::format("count mask bits, start {}, len {}", start_index, len)) &&
+               pass;
+
+        auto bytes = randomBytes(len);
+        unsigned long long expected_or = 0;
+        for (auto byte : bytes) {
+            expected_or |= byte;
+        }
+        pass = report(orReduceBytes(bytes.data(), len) == expected_or, fmt::format("or reduce bytes, len {}", len)) &&
+               pass;
+
+        unsigned long long word = rng_();
+        int expected_popcount = 0;
+        for (int b = 0; b < 64; b++) {
+            expected_popcount += static_cast<int>((word >> b) & 1);
+        }
+        pass = report(popcount(word) == expected_popcount, fmt::format("popcount of {:#x}", word)) && pass;
+
+        for (int max_cnt : {len, len / 2}) {
+            std::vector<int> dst{-1};
+            std::vector<int> expected_dst{-1};
+            compressIndexByMask(len, mask, start_index, max_cnt, dst);
+            for (int i = 0; i < len && static_cast<int>(expected_dst.size()) <= max_cnt; i++) {
+                if (getMaskBit(mask, start_index + i) != 0) {
+                    expected_dst.push_back(i);
+                }
+            }
+            pass = report(dst == expected_dst, fmt::format("compress index, start {}, len {}, max cnt {}",
+                                                           start_index, len, max_cnt)) &&
+                   pass;
+        }
+        return pass;
+    }
+
+    bool checkMultiplyAccumulateKernel(const CimMacroSizeConfig& macro_size) {
+        CimUnitConfig config = cim_unit_config_;
+        config.macro_size = macro_size;
+        CimComputeEngine engine{config};
+        auto sram_data = randomBytes(engine.getByteSize());
+        engine.write(0, sram_data);
+
+        bool pass = true;
+        const int group_cnt = config.macro_total_cnt / config.macro_group_size;
+        for (auto max_input : test_info_.max_input_list) {
+            for (int group_id = 0; group_id < group_cnt; group_id++) {
+                for (int row = 0; row < macro_size.row_cnt_per_element; row++) {
+                    std::vector<std::vector<unsigned long long>> macro_values(config.macro_group_size);
+                    for (auto& values : macro_values) {
+                        for (int h = 0; h < macro_size.compartment_cnt_per_macro; h++) {
+                            values.push_back(rng_() % (max_input + 1));
+                        }
+                    }
+                    auto inputs = MacroGroupInputs::fromValues(macro_values);
+                    for (int macro_id = 0; macro_id < config.macro_group_size; macro_id++) {
+                        std::vector<long long> result;
+                        engine.computeMacro(group_id, macro_id, row, inputs.getMacroInputs(macro_id), {}, 0, result);
+                        auto expected = multiplyAccumulateReference(config, sram_data, group_id, macro_id, row,
+                                                                    macro_values[macro_id]);
+                        pass = report(result == expected,
+                                      fmt::format("cim macro size ({}, {}, {}, {}), max input {}, group {}, macro {}, "
+                                                  "row {}",
+                                                  macro_size.compartment_cnt_per_macro,
+                                                  macro_size.element_cnt_per_compartment,
+                                                  macro_size.row_cnt_per_element, macro_size.bit_width_per_row,
+                                                  max_input, group_id, macro_id, row)) &&
+                               pass;
+                    }
+                }
+            }
+        }
+        return pass;
+    }
+
+    // decode weights from sram data following the address space of CimComputeEngine
+    static std::vector<long long> multiplyAccumulateReference(const CimUnitConfig& config,
+                                                              const std::vector<uint8_t>& sram_data, int group_id,
+                                                              int macro_id, int row,
+                                                              const std::vector<unsigned long long>& input_list) {
+        const auto& macro_size = config.macro_size;
+        const int group_cnt = config.macro_total_cnt / config.macro_group_size;
+        const int macro_row_cnt = macro_size.compartment_cnt_per_macro * macro_size.row_cnt_per_element;
+        const int bit_width = macro_size.bit_width_per_row;
+        const long long whole_row_bit_width =
+            static_cast<long long>(bit_width) * macro_size.element_cnt_per_compartment;
+
+        std::vector<long long> result(macro_size.element_cnt_per_compartment, 0);
+        for (int h = 0; h < input_list.size(); h++) {
+            long long macro_row = static_cast<long long>(h) * macro_size.row_cnt_per_element + row;
+            long long rest = config.sram.as_mode == +CimASMode::intragroup ? group_id * macro_row_cnt + macro_row
+                                                                           : macro_row * group_cnt + group_id;
+            long long bit_offset = (rest * config.macro_group_size + macro_id) * whole_row_bit_width;
+            for (int w = 0; w < macro_size.element_cnt_per_compartment; w++) {
+                long long weight = signExtend(getBitField(sram_data, bit_offset + w * bit_width, bit_width), bit_width);
+                result[w] += static_cast<long long>(input_list[h]) * weight;
+            }
+        }
+        return result;
+    }
+
+private:
+    const CimUnitConfig& cim_unit_config_;
+    const KernelTestInfo& test_info_;
+    std::ofstream& ofs_;
+
+    std::mt19937_64 rng_{};
+    KernelIsa isa_{KernelIsa::generic};
+};
+
+}  // namespace cimsim
+
+using namespace cimsim;
+
+int sc_main(int argc, char* argv[]) {
+    sc_core::sc_report_handler::set_actions(sc_core::SC_WARNING, sc_core::SC_DO_NOTHING);
+
+    std::string exec_file_name{argv[0]};
+    if (argc != 4) {
+        std::cout << fmt::format("Usage: {} [config_file] [instruction_file] [report_file]", exec_file_name)
+                  << std::endl;
+        return INVALID_USAGE;
+    }
+
+    auto* config_file = argv[1];
+    auto* instruction_file = argv[2];
+    auto* report_file = argv[3];
+
+    auto config = readTypeFromJsonFile<Config>(config_file);
+    if (!config.checkValid()) {
+        std::cout << "Config not valid" << std::endl;
+        return INVALID_CONFIG;
+    }
+    auto test_info = readTypeFromJsonFile<KernelTestInfo>(instruction_file);
+
+    std::ofstream ofs;
+    ofs.open(report_file);
+    KernelTester tester{config.chip_config.core_config.cim_unit_config, test_info, ofs};
+    bool pass = true;
+    for (KernelIsa isa : std::vector<KernelIsa>{KernelIsa::generic, KernelIsa::avx2, KernelIsa::avx512}) {
+        if (!isKernelIsaSupported(isa)) {
+            ofs << fmt::format("isa {}: skipped, not supported by cpu\n", isa._to_string());
+            continue;
+        }
+        setKernelIsaLimit(isa);
+        bool isa_pass = tester.run(isa);
+        ofs << fmt::format("isa {}: {}\n", isa._to_string(), isa_pass ? "pass" : "failed");
+        pass = pass && isa_pass;
+    }
+    ofs.close();
+
+    std::cout << (pass ? "Test Pass" : "Test Failed") << std::endl;
+    return pass ? TEST_PASSED : TEST_FAILED;
+}
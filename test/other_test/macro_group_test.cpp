@@ -2,6 +2,7 @@
 // Created by wyk on 2024/7/25.
 //
 
+#include <memory>
 #include <vector>
 
 #include "../base/test_macro.h"
@@ -40,6 +41,7 @@ public:
         , macro_group_("MacroGroup_0", config.chip_config.core_config.cim_unit_config, BaseInfo{config.sim_config},
                        energy_counter_) {
         macro_group_ins_list_ = std::move(codes);
+        running_module_cnt_++;
 
         SC_THREAD(issue)
 
@@ -48,7 +50,9 @@ public:
             if (id_finish_ && running_ins_cnt_ == 0) {
                 wait(SC_ZERO_TIME);
                 this->running_time_ = sc_core::sc_time_stamp();
-                sc_stop();
+                if (--running_module_cnt_ == 0) {
+                    sc_stop();
+                }
             }
         });
     }
@@ -96,10 +100,24 @@ private:
     bool id_finish_{false};
 
     sc_core::sc_time running_time_;
+
+    // modules simulated together, simulation stops when all of them finish
+    static inline int running_module_cnt_{0};
 };
 
 DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(CimInsInfo, ins_pc, sub_ins_num, last_sub_ins)
 
+void to_json(nlohmann::ordered_json& j, const MacroGroupInputs& t) {
+    j = nlohmann::ordered_json::array();
+    for (int macro_id = 0; macro_id < t.macro_cnt; macro_id++) {
+        j.push_back(t.getMacroInputs(macro_id).toVector());
+    }
+}
+
+void from_json(const nlohmann::ordered_json& j, MacroGroupInputs& t) {
+    t = MacroGroupInputs::fromValues(j.get<std::vector<std::vector<unsigned long long>>>());
+}
+
 DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(MacroGroupPayload, cim_ins_info, last_group, row, input_bit_width,
                                                bit_sparse, macro_inputs)
 
@@ -133,6 +151,18 @@ int sc_main(int argc, char* argv[]) {
     AddressSapce::initialize(config.chip_config);
 
     auto test_info = readTypeFromJsonFile<MacroGroupTestInfo>(instruction_file);
+
+    // with macro equivalence simulation, the same code is simulated macro by macro in a reference module, whose
+    // latency and energy are the expected ones
+    bool equivalence_simulation = config.sim_config.macro_equivalence_simulation;
+    Config reference_config = config;
+    reference_config.sim_config.macro_equivalence_simulation = false;
+    std::unique_ptr<MacroGroupTestModule> reference_module;
+    if (equivalence_simulation) {
+        reference_module =
+            std::make_unique<MacroGroupTestModule>("ReferenceModule", reference_config, test_info.code);
+    }
+
     MacroGroupTestModule test_module{"MacroGroupTestModule", config, std::move(test_info.code)};
     sc_start();
 
@@ -142,6 +172,11 @@ int sc_main(int argc, char* argv[]) {
     reporter.report(ofs);
     ofs.close();
 
+    if (equivalence_simulation) {
+        auto reference_reporter = reference_module->getReporter();
+        test_info.expected = {.time_ns = reference_reporter.getLatencyNs(),
+                              .energy_pj = reference_reporter.getTotalEnergyPJ()};
+    }
     if (DoubleEqual(reporter.getLatencyNs(), test_info.expected.time_ns) &&
         DoubleEqual(reporter.getTotalEnergyPJ(), test_info.expected.energy_pj)) {
         std::cout << "Test Pass" << std::endl;
@@ -125,6 +125,14 @@ private:
 
 DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(CimInsInfo, ins_pc, sub_ins_num, last_sub_ins)
 
+void to_json(nlohmann::ordered_json& j, const MacroInputs& t) {
+    j = t.toVector();
+}
+
+void from_json(const nlohmann::ordered_json& j, MacroInputs& t) {
+    t = MacroGroupInputs::fromValues({j.get<std::vector<unsigned long long>>()}).getMacroInputs(0);
+}
+
 DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(MacroPayload, cim_ins_info, row, input_bit_width, bit_sparse, inputs)
 
 DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(MacroTestConfig, independent_ipu)
@@ -31,8 +31,7 @@ public:
         auto payload = std::make_shared<MemoryAccessPayload>(MemoryAccessPayload{.ins = ins,
                                                                                  .access_type = MemoryAccessType::read,
                                                                                  .address_byte = 1024,
-                                                                                 .size_byte = 33,
-                                                                                 .finish_access = event1});
+                                                                                 .size_byte = 33});
         local_memory_unit_.access(payload);
         std::cout << sc_core::sc_time_stamp() << ", process1 finish access memory" << std::endl;
     }
@@ -45,17 +44,13 @@ public:
         auto payload = std::make_shared<MemoryAccessPayload>(MemoryAccessPayload{.ins = ins,
                                                                                  .access_type = MemoryAccessType::read,
                                                                                  .address_byte = 2048,
-                                                                                 .size_byte = 33,
-                                                                                 .finish_access = event2});
+                                                                                 .size_byte = 33});
         local_memory_unit_.access(payload);
         std::cout << sc_core::sc_time_stamp() << ", process2 finish access memory" << std::endl;
     }
 
 private:
     MemoryUnit local_memory_unit_;
-
-    sc_core::sc_event event1;
-    sc_core::sc_event event2;
 };
 
 }  // namespace cimsim
@@ -0,0 +1,150 @@
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <vector>
+
+#include "../base/test_macro.h"
+#include "config/config.h"
+#include "fmt/format.h"
+#include "simulator/simulation.h"
+#include "systemc.h"
+#include "util/macro_scope.h"
+#include "util/result_cache.h"
+#include "util/util.h"
+
+namespace cimsim {
+
+struct ResultCacheTestInfo {
+    std::string comments{};
+    std::vector<std::vector<Instruction>> code{};
+};
+
+DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(ResultCacheTestInfo, comments, code)
+
+// looks up a report in the cache as NetworkSimulator does for every layer, and simulates only on miss
+class CachedSimulator {
+public:
+    CachedSimulator(const ResultCache& result_cache, std::string report_json_file)
+        : result_cache_(result_cache), report_json_file_(std::move(report_json_file)) {}
+
+    std::optional<Reporter> run(const Config& config, const std::string& inst_file) {
+        auto cache_key = result_cache_.getKey(config, profiler_config_, inst_file);
+        if (result_cache_.load(cache_key, report_json_file_)) {
+            return readTypeFromJsonFile<Reporter>(report_json_file_);
+        }
+
+        auto test_info = readTypeFromJsonFile<ResultCacheTestInfo>(inst_file);
+        auto reporter = simulate(config, profiler_config_, test_info.code);
+        if (!reporter.has_value()) {
+            return std::nullopt;
+        }
+        simulated_cnt_++;
+        nlohmann::json report_json = *reporter;
+        std::ofstream ofs;
+        ofs.open(report_json_file_);
+        ofs << report_json;
+        ofs.close();
+        result_cache_.store(cache_key, report_json_file_);
+        return reporter;
+    }
+
+    [[nodiscard]] int getSimulatedCount() const {
+        return simulated_cnt_;
+    }
+
+private:
+    const ResultCache& result_cache_;
+    std::string report_json_file_;
+    ProfilerConfig profiler_config_{};
+
+    int simulated_cnt_{0};
+};
+
+bool checkRun(std::ofstream& ofs, const std::string& case_name, const std::optional<Reporter>& reporter,
+              const Reporter& base_reporter, bool expect_simulated, int simulated_cnt, int& last_simulated_cnt) {
+    bool simulated = simulated_cnt > last_simulated_cnt;
+    last_simulated_cnt = simulated_cnt;
+    bool pass = reporter.has_value() && simulated == expect_simulated;
+    if (pass && !simulated) {
+        pass = DoubleEqual(reporter->getLatencyNs(), base_reporter.getLatencyNs()) &&
+               DoubleEqual(reporter->getTotalEnergyPJ(), base_reporter.getTotalEnergyPJ());
+    }
+    ofs << fmt::format("{}: {}, {}\n", case_name, simulated ? "simulated" : "cached", pass ? "pass" : "failed");
+    return pass;
+}
+
+}  // namespace cimsim
+
+using namespace cimsim;
+
+int sc_main(int argc, char* argv[]) {
+    sc_core::sc_report_handler::set_actions(sc_core::SC_WARNING, sc_core::SC_DO_NOTHING);
+
+    std::string exec_file_name{argv[0]};
+    if (argc != 4) {
+        std::cout << fmt::format("Usage: {} [config_file] [instruction_file] [report_file]", exec_file_name)
+                  << std::endl;
+        return INVALID_USAGE;
+    }
+
+    auto* config_file = argv[1];
+    auto* instruction_file = argv[2];
+    auto* report_file = argv[3];
+
+    auto config = readTypeFromJsonFile<Config>(config_file);
+    if (!config.checkValid()) {
+        std::cout << "Config not valid" << std::endl;
+        return INVALID_CONFIG;
+    }
+
+    // a fresh cache next to the report, this test executable stands for the simulator build
+    auto cache_dir = fmt::format("{}.cache", report_file);
+    std::filesystem::remove_all(cache_dir);
+    ResultCache result_cache{cache_dir, 16.0, exec_file_name};
+    CachedSimulator simulator{result_cache, fmt::format("{}.json", report_file)};
+
+    std::ofstream ofs;
+    ofs.open(report_file);
+    int simulated_cnt = 0;
+    auto base_reporter = simulator.run(config, instruction_file);
+    bool pass = checkRun(ofs, "first run", base_reporter, Reporter{}, true, simulator.getSimulatedCount(),
+                         simulated_cnt);
+    if (!pass) {
+        ofs.close();
+        std::cout << "Test Failed" << std::endl;
+        return TEST_FAILED;
+    }
+
+    // same config and instruction file hit the cache, the report of the first run is returned
+    pass = checkRun(ofs, "same config and instruction file", simulator.run(config, instruction_file), *base_reporter,
+                    false, simulator.getSimulatedCount(), simulated_cnt) &&
+           pass;
+
+    // key hashes contents of the instruction file, a copy at another path still hits, and misses once it changes
+    auto changed_inst_file = fmt::format("{}.code.json", report_file);
+    std::filesystem::copy_file(instruction_file, changed_inst_file, std::filesystem::copy_options::overwrite_existing);
+    pass = checkRun(ofs, "copied instruction file", simulator.run(config, changed_inst_file), *base_reporter, false,
+                    simulator.getSimulatedCount(), simulated_cnt) &&
+           pass;
+
+    auto inst_json = readTypeFromJsonFile<nlohmann::ordered_json>(instruction_file);
+    inst_json["code"].back().push_back({{"opcode", 44}, {"rd", 7}, {"imm", 1}});
+    std::ofstream inst_ofs;
+    inst_ofs.open(changed_inst_file);
+    inst_ofs << inst_json.dump(2);
+    inst_ofs.close();
+    pass = checkRun(ofs, "changed instruction file", simulator.run(config, changed_inst_file), *base_reporter, true,
+                    simulator.getSimulatedCount(), simulated_cnt) &&
+           pass;
+
+    // any changed config field misses
+    auto changed_config = config;
+    changed_config.sim_config.period_ns *= 2;
+    pass = checkRun(ofs, "changed config", simulator.run(changed_config, instruction_file), *base_reporter, true,
+                    simulator.getSimulatedCount(), simulated_cnt) &&
+           pass;
+    ofs.close();
+
+    std::cout << (pass ? "Test Pass" : "Test Failed") << std::endl;
+    return pass ? TEST_PASSED : TEST_FAILED;
+}
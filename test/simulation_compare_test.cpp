@@ -0,0 +1,143 @@
+#include <fstream>
+#include <vector>
+
+#include "base/test_macro.h"
+#include "better-enums/enum.h"
+#include "config/config.h"
+#include "fmt/format.h"
+#include "simulator/simulation.h"
+#include "systemc.h"
+#include "util/macro_scope.h"
+#include "util/util.h"
+
+namespace cimsim {
+
+BETTER_ENUM(CompareRelation, int,  // NOLINT(*-no-recursion, *-explicit-constructor)
+            none = 0, report_equal = 1, latency_greater = 2, latency_not_less = 3, memory_equal = 4, other = 5)
+DEFINE_ENUM_FROM_TO_JSON_FUNCTION_WITH_OTHER(CompareRelation, other, none, report_equal, latency_greater,
+                                             latency_not_less, memory_equal)
+
+struct SimulationCompareRunInfo {
+    std::string comments{};
+    nlohmann::ordered_json config_patch{};        // json merge patch on config file
+    std::vector<std::vector<Instruction>> code{};  // empty means code of test data
+    int compare_to{-1};                            // index of an earlier run
+    CompareRelation relation{CompareRelation::none};
+};
+
+void from_json(const nlohmann::ordered_json& j, SimulationCompareRunInfo& t) {
+    const SimulationCompareRunInfo default_obj{};
+    t.comments = j.contains("comments") ? j["comments"].get<std::string>() : default_obj.comments;
+    t.config_patch = j.contains("config_patch") ? j["config_patch"] : default_obj.config_patch;
+    t.code = j.contains("code") ? j["code"].get<std::vector<std::vector<Instruction>>>() : default_obj.code;
+    t.compare_to = j.contains("compare_to") ? j["compare_to"].get<int>() : default_obj.compare_to;
+    JSON_VALUE_ENUM(t, relation, "relation")
+}
+
+struct SimulationCompareTestInfo {
+    std::vector<std::vector<Instruction>> code;
+    std::vector<SimulationCompareRunInfo> run_list;
+};
+
+void from_json(const nlohmann::ordered_json& j, SimulationCompareTestInfo& t) {
+    t.code = j["code"].get<std::vector<std::vector<Instruction>>>();
+    t.run_list = j["run_list"].get<std::vector<SimulationCompareRunInfo>>();
+}
+
+struct SimulationCompareRunResult {
+    Reporter reporter;
+    ChipArchState arch_state;
+};
+
+bool checkMemoryEqual(const ChipArchState& state, const ChipArchState& base_state) {
+    if (state.global_memory_data_list != base_state.global_memory_data_list ||
+        state.core_state_list.size() != base_state.core_state_list.size()) {
+        return false;
+    }
+    for (int core_id = 0; core_id < state.core_state_list.size(); core_id++) {
+        if (state.core_state_list[core_id].memory_data_list != base_state.core_state_list[core_id].memory_data_list) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool checkRelation(CompareRelation relation, const SimulationCompareRunResult& result,
+                   const SimulationCompareRunResult& base_result) {
+    const auto& reporter = result.reporter;
+    const auto& base_reporter = base_result.reporter;
+    switch (relation) {
+        case CompareRelation::report_equal:
+            return DoubleEqual(reporter.getLatencyNs(), base_reporter.getLatencyNs()) &&
+                   DoubleEqual(reporter.getTotalEnergyPJ(), base_reporter.getTotalEnergyPJ());
+        case CompareRelation::latency_greater:
+            return reporter.getLatencyNs() > base_reporter.getLatencyNs() + delta;
+        case CompareRelation::latency_not_less:
+            return reporter.getLatencyNs() > base_reporter.getLatencyNs() - delta;
+        case CompareRelation::memory_equal: return checkMemoryEqual(result.arch_state, base_result.arch_state);
+        default: return true;
+    }
+}
+
+}  // namespace cimsim
+
+using namespace cimsim;
+
+int sc_main(int argc, char* argv[]) {
+    sc_core::sc_report_handler::set_actions(sc_core::SC_WARNING, sc_core::SC_DO_NOTHING);
+
+    std::string exec_file_name{argv[0]};
+    if (argc != 5) {
+        std::cout << fmt::format("Usage: {} [config_file] [profiler_config_file] [instruction_file] [report_file]",
+                                 exec_file_name)
+                  << std::endl;
+        return INVALID_USAGE;
+    }
+
+    auto* config_file = argv[1];
+    auto* profiler_config_file = argv[2];
+    auto* instruction_file = argv[3];
+    auto* report_file = argv[4];
+
+    auto config_json = readTypeFromJsonFile<nlohmann::ordered_json>(config_file);
+    auto profiler_config = readTypeFromJsonFile<ProfilerConfig>(profiler_config_file);
+    auto test_info = readTypeFromJsonFile<SimulationCompareTestInfo>(instruction_file);
+
+    // every run patches the config file, and its report or memory data is compared with the one of an earlier run
+    std::ofstream ofs;
+    ofs.open(report_file);
+    std::vector<SimulationCompareRunResult> result_list;
+    bool pass = true;
+    for (int i = 0; i < test_info.run_list.size(); i++) {
+        const auto& run_info = test_info.run_list[i];
+        auto run_config_json = config_json;
+        run_config_json.merge_patch(run_info.config_patch);
+        auto config = run_config_json.get<Config>();
+        if (!config.checkValid()) {
+            std::cout << fmt::format("Config of run {} not valid", i) << std::endl;
+            return INVALID_CONFIG;
+        }
+
+        Simulation simulation{config, profiler_config, run_info.code.empty() ? test_info.code : run_info.code};
+        if (!simulation.run()) {
+            std::cout << "Test Failed" << std::endl;
+            return TEST_FAILED;
+        }
+        ofs << fmt::format("run {}: {}\n", i, run_info.comments);
+        auto& result = result_list.emplace_back(SimulationCompareRunResult{.reporter = simulation.report(ofs)});
+        simulation.saveArchState(result.arch_state);
+
+        if (run_info.compare_to < 0 || run_info.compare_to >= i) {
+            continue;
+        }
+        if (!checkRelation(run_info.relation, result, result_list[run_info.compare_to])) {
+            ofs << fmt::format("run {} does not match relation {} with run {}\n", i, run_info.relation._to_string(),
+                               run_info.compare_to);
+            pass = false;
+        }
+    }
+    ofs.close();
+
+    std::cout << (pass ? "Test Pass" : "Test Failed") << std::endl;
+    return pass ? TEST_PASSED : TEST_FAILED;
+}
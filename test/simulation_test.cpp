@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include "base/test_macro.h"
+#include "base/test_payload.h"
+#include "config/config.h"
+#include "fmt/format.h"
+#include "simulator/simulation.h"
+#include "systemc.h"
+#include "util/util.h"
+
+namespace cimsim {
+
+struct SimulationTestInfo {
+    std::vector<std::vector<Instruction>> code;
+    TestExpectedInfo expected;
+};
+
+DEFINE_TYPE_FROM_TO_JSON_FUNCTION_WITH_DEFAULT(SimulationTestInfo, code, expected);
+
+}  // namespace cimsim
+
+using namespace cimsim;
+
+int sc_main(int argc, char* argv[]) {
+    sc_core::sc_report_handler::set_actions(sc_core::SC_WARNING, sc_core::SC_DO_NOTHING);
+
+    std::string exec_file_name{argv[0]};
+    if (argc != 5) {
+        std::cout << fmt::format("Usage: {} [config_file] [profiler_config_file] [instruction_file] [report_file]",
+                                 exec_file_name)
+                  << std::endl;
+        return INVALID_USAGE;
+    }
+
+    auto* config_file = argv[1];
+    auto* profiler_config_file = argv[2];
+    auto* instruction_file = argv[3];
+    auto* report_file = argv[4];
+
+    auto config = readTypeFromJsonFile<Config>(config_file);
+    auto profiler_config = readTypeFromJsonFile<ProfilerConfig>(profiler_config_file);
+    if (!config.checkValid()) {
+        std::cout << "Config not valid" << std::endl;
+        return INVALID_CONFIG;
+    }
+
+    // simulations run one after another in this process, each must give the same result as a fresh process
+    auto test_info = readTypeFromJsonFile<SimulationTestInfo>(instruction_file);
+    std::vector<Reporter> reporter_list;
+    for (int i = 0; i < 2; i++) {
+        auto reporter = simulate(config, profiler_config, test_info.code);
+        if (!reporter.has_value()) {
+            std::cout << "Test Failed" << std::endl;
+            return TEST_FAILED;
+        }
+        reporter_list.emplace_back(std::move(*reporter));
+    }
+
+    // every layer of a batch resets hardware timing, so a batch of the same layer twice gives two standalone results
+    Simulation batch_simulation{config, profiler_config, test_info.code};
+    batch_simulation.addBatchLayer(test_info.code);
+    if (!batch_simulation.run()) {
+        std::cout << "Test Failed" << std::endl;
+        return TEST_FAILED;
+    }
+    std::stringstream batch_ss;
+    batch_simulation.report(batch_ss);
+    auto layer_reporter_list = batch_simulation.getLayerReporterList();
+
+    std::ofstream ofs;
+    ofs.open(report_file);
+    for (auto& reporter : reporter_list) {
+        reporter.report(ofs);
+    }
+    for (auto& reporter : layer_reporter_list) {
+        reporter.report(ofs);
+    }
+    ofs.close();
+
+    // without expected result in test data, runs are only checked against the first one
+    bool has_expected = test_info.expected.time_ns > 0;
+    const auto& first_reporter = reporter_list.front();
+    double expected_time_ns = has_expected ? test_info.expected.time_ns : first_reporter.getLatencyNs();
+    double expected_energy_pj = has_expected ? test_info.expected.energy_pj : first_reporter.getTotalEnergyPJ();
+    reporter_list.insert(reporter_list.end(), layer_reporter_list.begin(), layer_reporter_list.end());
+    if (layer_reporter_list.size() == 2 &&
+        std::all_of(reporter_list.begin(), reporter_list.end(), [&](const Reporter& reporter) {
+            return DoubleEqual(reporter.getLatencyNs(), expected_time_ns) &&
+                   DoubleEqual(reporter.getTotalEnergyPJ(), expected_energy_pj);
+        })) {
+        std::cout << "Test Pass" << std::endl;
+        return TEST_PASSED;
+    } else {
+        std::cout << "Test Failed" << std::endl;
+        return TEST_FAILED;
+    }
+}
@@ -90,7 +90,8 @@ bool test_unit(const std::string& root_dir, const UnitTestConfig& unit_test_conf
         auto report_file = fmt::format("{}/{}", root_dir, test_case_config.report_file);
 
         std::string cmd;
-        if (unit_test_config.name == "CoreTest" || unit_test_config.name == "ChipTest") {
+        if (unit_test_config.name == "CoreTest" || unit_test_config.name == "ChipTest" ||
+            unit_test_config.name == "SimulationTest" || unit_test_config.name == "SimulationCompareTest") {
             cmd = fmt::format("./{} {} {} {} {} >> ./log.txt 2>&1", unit_test_config.name, config_file,
                               profiler_config_file, instruction_file, report_file);
         } else {